@@ -185,9 +185,56 @@ static void BM_CustomCall_16FloatBuffers(benchmark::State& state) {
   CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d", absl::StrCat(d)}}));
 }
 
+static absl::Status AddOne(ffi::Buffer<PrimitiveType::F32> arg,
+                           ffi::Result<ffi::Buffer<PrimitiveType::F32>> ret) {
+  const float* src = arg.typed_data();
+  float* dst = ret->typed_data();
+  for (size_t i = 0; i < arg.element_count(); ++i) {
+    dst[i] = src[i] + 1.0f;
+  }
+  return absl::OkStatus();
+}
+
+XLA_FFI_DEFINE_HANDLER(kAddOne, AddOne,
+                       ffi::Ffi::Bind()
+                           .Arg<ffi::Buffer<PrimitiveType::F32>>()
+                           .Ret<ffi::Buffer<PrimitiveType::F32>>());
+
+XLA_FFI_REGISTER_HANDLER(ffi::GetXlaFfiApi(), "__xla_bm$$add_one", "Host",
+                         kAddOne);
+
+// A chain of small custom calls that do almost no work, to measure the per
+// call overhead of the XLA:CPU runtime and FFI.
+static void BM_CustomCall_ManySmallCalls(benchmark::State& state) {
+  int64_t num_calls = state.range(0);
+
+  std::ostringstream hlo;
+  hlo << "HloModule module\n\n"
+      << "ENTRY custom_call {\n"
+      << "  call0 = f32[4] parameter(0)\n";
+  for (int64_t i = 1; i <= num_calls; ++i) {
+    hlo << "  call" << i << " = f32[4] custom-call(call" << i - 1 << "), "
+        << "custom_call_target=\"__xla_bm$$add_one\", "
+        << "api_version=API_VERSION_TYPED_FFI\n";
+  }
+  hlo << "  ROOT copy = f32[4] copy(call" << num_calls << ")\n"
+      << "}\n";
+
+  auto p0 = LiteralUtil::CreateR1<float>({1.0f, 2.0f, 3.0f, 4.0f});
+  std::vector<const Literal*> args = {&p0};
+
+  CHECK_OK(RunHloBenchmark(state, hlo.str(), args));
+  state.SetItemsProcessed(state.iterations() * num_calls);
+}
+
 BENCHMARK(BM_CustomCall_Minimal)->MeasureProcessCPUTime();
 BENCHMARK(BM_CustomCall_16IntAttributes)->MeasureProcessCPUTime();
 BENCHMARK(BM_CustomCall_16FloatBuffers)->MeasureProcessCPUTime();
+BENCHMARK(BM_CustomCall_ManySmallCalls)
+    ->MeasureProcessCPUTime()
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(1024);
 
 }  // namespace
 }  // namespace xla::cpu
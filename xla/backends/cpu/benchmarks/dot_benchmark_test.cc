@@ -102,4 +102,61 @@ static void BM_BatchedDot(benchmark::State& state) {
 BENCHMARK_BATCHED_DOT(F32);   // Shown as "11" in the benchmark name.
 BENCHMARK_BATCHED_DOT(BF16);  // Shown as "16" in the benchmark name.
 
+static void BM_MixedPrecisionDot(benchmark::State& state) {
+  PrimitiveType in_dtype = static_cast<PrimitiveType>(state.range(0));
+  PrimitiveType out_dtype = static_cast<PrimitiveType>(state.range(1));
+  int64_t d = state.range(2);
+
+  absl::string_view hlo = R"(
+    HloModule dot_$in_dtype_$out_dtype_$d
+
+    ENTRY e {
+      p0 = $in_dtype[$d,$d] parameter(0)
+      p1 = $in_dtype[$d,$d] parameter(1)
+      ROOT dot = $out_dtype[$d,$d] dot(p0, p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    }
+  )";
+
+  Literal p0, p1;
+  std::minstd_rand0 engine;
+  auto shape = ShapeUtil::MakeShape(in_dtype, {d, d});
+  if (in_dtype == F32) {
+    p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0, 0.1);
+    p1 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0, 0.1);
+  } else if (in_dtype == BF16) {
+    p0 = *LiteralUtil::CreateRandomLiteral<BF16>(shape, &engine, 1.0, 0.1);
+    p1 = *LiteralUtil::CreateRandomLiteral<BF16>(shape, &engine, 1.0, 0.1);
+  } else if (in_dtype == S32) {
+    p0 = *LiteralUtil::CreateRandomLiteral<S32>(shape, &engine, 0.0, 16.0);
+    p1 = *LiteralUtil::CreateRandomLiteral<S32>(shape, &engine, 0.0, 16.0);
+  } else if (in_dtype == S8) {
+    p0 = *LiteralUtil::CreateRandomLiteral<S8>(shape, &engine, 0.0, 16.0);
+    p1 = *LiteralUtil::CreateRandomLiteral<S8>(shape, &engine, 0.0, 16.0);
+  } else {
+    LOG(FATAL) << "Add dtype to the if-else block before use: " << in_dtype;
+  }
+
+  std::vector<const Literal*> args = {&p0, &p1};
+  CHECK_OK(RunHloBenchmark(
+      state, hlo, args,
+      {{"$in_dtype", primitive_util::LowercasePrimitiveTypeName(in_dtype)},
+       {"$out_dtype", primitive_util::LowercasePrimitiveTypeName(out_dtype)},
+       {"$d", absl::StrCat(d)}}));
+}
+
+// Mixed precision dots (s8 -> s32 and bf16 -> f32) run without upcasting
+// their operands, compare them with the same size dots in the wider type.
+#define BENCHMARK_MIXED_PRECISION_DOT(in_dtype, out_dtype) \
+  BENCHMARK(BM_MixedPrecisionDot)                          \
+      ->MeasureProcessCPUTime()                            \
+      ->Args({in_dtype, out_dtype, 64})                    \
+      ->Args({in_dtype, out_dtype, 256})                   \
+      ->Args({in_dtype, out_dtype, 1024})
+
+BENCHMARK_MIXED_PRECISION_DOT(F32, F32);
+BENCHMARK_MIXED_PRECISION_DOT(BF16, F32);
+BENCHMARK_MIXED_PRECISION_DOT(S32, S32);
+BENCHMARK_MIXED_PRECISION_DOT(S8, S32);
+
 }  // namespace xla::cpu
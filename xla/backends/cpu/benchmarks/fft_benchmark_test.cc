@@ -0,0 +1,101 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/backends/cpu/benchmarks/hlo_benchmark_runner.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/types.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+static void BM_FftC64(benchmark::State& state) {
+  int64_t batch = state.range(0);
+  int64_t length = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule fft_c64_$batch_$length
+
+    ENTRY e {
+      p0 = c64[$batch,$length] parameter(0)
+      ROOT fft = c64[$batch,$length] fft(p0), fft_type=FFT,
+                                              fft_length={$length}
+    }
+  )";
+
+  auto p0 = *LiteralUtil::CreateLiteralWithGenerator<C64, complex64>(
+      ShapeUtil::MakeShape(C64, {batch, length}),
+      [](absl::Span<const int64_t> idx) {
+        return complex64(std::sin(idx[0] + idx[1] * 0.1f),
+                         std::cos(idx[0] - idx[1] * 0.3f));
+      });
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args,
+                           {{"$batch", absl::StrCat(batch)},
+                            {"$length", absl::StrCat(length)}}));
+}
+
+static void BM_RfftF32(benchmark::State& state) {
+  int64_t batch = state.range(0);
+  int64_t length = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule rfft_f32_$batch_$length
+
+    ENTRY e {
+      p0 = f32[$batch,$length] parameter(0)
+      ROOT fft = c64[$batch,$rfft_length] fft(p0), fft_type=RFFT,
+                                                   fft_length={$length}
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(
+      ShapeUtil::MakeShape(F32, {batch, length}), &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args,
+                           {{"$batch", absl::StrCat(batch)},
+                            {"$length", absl::StrCat(length)},
+                            {"$rfft_length", absl::StrCat(length / 2 + 1)}}));
+}
+
+#define REGISTER_BENCHMARK(NAME) \
+  BENCHMARK(NAME)                \
+      ->MeasureProcessCPUTime()  \
+      ->Args({1, 1024})          \
+      ->Args({1024, 256})        \
+      ->Args({1024, 1024})       \
+      ->Args({4096, 256})        \
+      ->Args({4096, 1024})       \
+      ->Args({16, 65536});
+
+REGISTER_BENCHMARK(BM_FftC64);
+REGISTER_BENCHMARK(BM_RfftF32);
+
+}  // namespace xla::cpu
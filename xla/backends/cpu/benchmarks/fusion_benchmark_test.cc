@@ -245,6 +245,74 @@ static void BM_ChainOfAddF32(benchmark::State& state) {
                             {"$additions", additions}}));
 }
 
+// Sibling elementwise fusions reading the same parameter. With the fusion
+// cost model small siblings are merged into a multi-output fusion.
+static void BM_SiblingFusionF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  bool use_fusion_cost_model = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule sibling_fusion_f32_$d0
+
+    ENTRY e {
+      p0 = f32[$d0,256] parameter(0)
+      neg = f32[$d0,256] negate(p0)
+      exp = f32[$d0,256] exponential(p0)
+      abs = f32[$d0,256] abs(p0)
+      ROOT tuple = (f32[$d0,256], f32[$d0,256], f32[$d0,256])
+        tuple(neg, exp, abs)
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, 256});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+
+  HloBenchmarkOptions benchmark_options;
+  benchmark_options.use_fusion_cost_model = use_fusion_cost_model;
+
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}},
+                           benchmark_options));
+}
+
+// Broadcast of an expensive elementwise producer. The cost model keeps the
+// producer unfused, so that it is not recomputed for every broadcasted element.
+static void BM_BcastExpFusionF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  bool use_fusion_cost_model = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule bcast_exp_fusion_f32_$d0
+
+    ENTRY e {
+      p0 = f32[1024] parameter(0)
+      p1 = f32[$d0,1024] parameter(1)
+      exp = f32[1024] exponential(p0)
+      tanh = f32[1024] tanh(exp)
+      bcast = f32[$d0,1024] broadcast(tanh), dimensions={1}
+      ROOT add = f32[$d0,1024] add(bcast, p1)
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape0 = ShapeUtil::MakeShape(F32, {1024});
+  auto shape1 = ShapeUtil::MakeShape(F32, {d0, 1024});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape0, &engine, 1.0f, 0.1f);
+  auto p1 = *LiteralUtil::CreateRandomLiteral<F32>(shape1, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0, &p1};
+
+  HloBenchmarkOptions benchmark_options;
+  benchmark_options.use_fusion_cost_model = use_fusion_cost_model;
+
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}},
+                           benchmark_options));
+}
+
 BENCHMARK(BM_FusionF32)
     ->MeasureProcessCPUTime()
     ->Arg(128)
@@ -287,4 +355,14 @@ BENCHMARK(BM_ChainOfAddF32)
     ->Arg(512)
     ->Arg(1024);
 
+BENCHMARK(BM_SiblingFusionF32)
+    ->MeasureProcessCPUTime()
+    ->ArgNames({"d0", "cost_model"})
+    ->ArgsProduct({{4, 16, 64, 1024, 8192}, {0, 1}});
+
+BENCHMARK(BM_BcastExpFusionF32)
+    ->MeasureProcessCPUTime()
+    ->ArgNames({"d0", "cost_model"})
+    ->ArgsProduct({{16, 64, 256, 1024}, {0, 1}});
+
 }  // namespace xla::cpu
@@ -40,6 +40,7 @@ limitations under the License.
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test_benchmark.h"
 #include "xla/tsl/platform/threadpool.h"
+#include "xla/xla.pb.h"
 
 namespace xla::cpu {
 
@@ -68,6 +69,11 @@ absl::Status RunHloBenchmark(benchmark::State& state,
     compile_options.executable_build_options.mutable_debug_options()
         ->add_xla_disable_hlo_passes("cpu-parallel-task-assigner");
   }
+  if (benchmark_options.use_fusion_cost_model) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_fusion_mode(
+            DebugOptions::CPU_FUSION_MODE_COST_MODEL);
+  }
   TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
                       client->Compile(computation, compile_options));
 
@@ -180,6 +186,11 @@ absl::Status CompileHloBenchmark(benchmark::State& state,
     compile_options.executable_build_options.mutable_debug_options()
         ->add_xla_disable_hlo_passes("cpu-parallel-task-assigner");
   }
+  if (benchmark_options.use_fusion_cost_model) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_fusion_mode(
+            DebugOptions::CPU_FUSION_MODE_COST_MODEL);
+  }
 
   for (auto _ : state) {
     TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
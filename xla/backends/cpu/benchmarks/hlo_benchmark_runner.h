@@ -35,6 +35,7 @@ using StrToStrMapping =
 struct HloBenchmarkOptions {
   int32_t num_executions = 1;
   bool disable_parallel_task_assigner = false;
+  bool use_fusion_cost_model = false;
 };
 
 // Runs the given HLO module as a benchmark.
@@ -46,6 +47,9 @@ struct HloBenchmarkOptions {
 // If `disable_parallel_task_assigner` is true, the parallel task assigner will
 // not be run on the HLO module before running the benchmark. Therefore,
 // parallel backend will not be executed.
+//
+// If `use_fusion_cost_model` is true, fusion decisions will be made by the
+// cache-aware XLA:CPU fusion cost model instead of the default heuristics.
 absl::Status RunHloBenchmark(benchmark::State& state,
                              absl::string_view hlo_module,
                              absl::Span<const Literal* const> args,
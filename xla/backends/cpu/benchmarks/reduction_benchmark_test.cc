@@ -86,6 +86,90 @@ static void BM_ReduceAddBF16(benchmark::State& state) {
   CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
 }
 
+static void BM_RowReduceAddF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+
+  absl::string_view hlo = R"(
+    HloModule row_reduce_add_f32_$d0
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[$d0,1024] parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[$d0] reduce(p0, c0), dimensions={1}, to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, 1024});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
+}
+
+static void BM_ColumnReduceAddF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+
+  absl::string_view hlo = R"(
+    HloModule column_reduce_add_f32_$d0
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[$d0,1024] parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[1024] reduce(p0, c0), dimensions={0}, to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, 1024});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
+}
+
+static void BM_FullReduceMaxF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+
+  absl::string_view hlo = R"(
+    HloModule full_reduce_max_f32_$d0
+
+    max {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT max = f32[] maximum(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[$d0,1024] parameter(0)
+      c0 = f32[] constant(-inf)
+      ROOT reduce = f32[] reduce(p0, c0), dimensions={0,1}, to_apply=max
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, 1024});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
+}
+
 #define BENCHMARK_SIZES(NAME)   \
   BENCHMARK(NAME)               \
       ->MeasureProcessCPUTime() \
@@ -98,5 +182,8 @@ static void BM_ReduceAddBF16(benchmark::State& state) {
 
 BENCHMARK_SIZES(BM_ReduceAddF32);
 BENCHMARK_SIZES(BM_ReduceAddBF16);
+BENCHMARK_SIZES(BM_RowReduceAddF32);
+BENCHMARK_SIZES(BM_ColumnReduceAddF32);
+BENCHMARK_SIZES(BM_FullReduceMaxF32);
 
 }  // namespace xla::cpu
@@ -52,6 +52,27 @@ static void BM_TransposeAndCopy(benchmark::State& state) {
   CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
 }
 
+static void BM_Transpose(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+
+  absl::string_view hlo = R"(
+    HloModule transpose_$d0
+
+    ENTRY e {
+      p0 = f32[$d0,1000] parameter(0)
+      ROOT transpose = f32[1000,$d0] transpose(p0), dimensions={1,0}
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto input_shape = ShapeUtil::MakeShape(F32, {d0, 1000});
+  auto p0 =
+      *LiteralUtil::CreateRandomLiteral<F32>(input_shape, &engine, 1.0f, 0.1f);
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
+}
+
 #define REGISTER_BENCHMARK(NAME) \
   BENCHMARK(NAME)                \
       ->MeasureProcessCPUTime()  \
@@ -62,5 +83,6 @@ static void BM_TransposeAndCopy(benchmark::State& state) {
       ->Arg(4096);
 
 REGISTER_BENCHMARK(BM_TransposeAndCopy);
+REGISTER_BENCHMARK(BM_Transpose);
 
 }  // namespace xla::cpu
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/codegen/cpu_features.h"
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,7 +25,10 @@ limitations under the License.
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+#include "absl/types/span.h"
 #include "llvm/ADT/StringMap.h"  // IWYU pragma: keep
 #include "llvm/TargetParser/Host.h"
 #include "tsl/platform/cpu_info.h"
@@ -85,6 +89,93 @@ std::optional<CPUFeature> CpuFeatureFromString(absl::string_view cpu_feature) {
   return std::nullopt;
 }
 
+absl::string_view CpuFeatureToString(CPUFeature cpu_feature) {
+  switch (cpu_feature) {
+    case CPUFeature::SSE4_2:
+      return "SSE4_2";
+    case CPUFeature::AVX:
+      return "AVX";
+    case CPUFeature::AVX2:
+      return "AVX2";
+    case CPUFeature::AVX512F:
+      return "AVX512";
+    case CPUFeature::AVX512_VNNI:
+      return "AVX512_VNNI";
+    case CPUFeature::AVX512_BF16:
+      return "AVX512_BF16";
+    case CPUFeature::AMX_BF16:
+    case CPUFeature::AMX_INT8:
+      return "AMX";
+    case CPUFeature::AMX_FP16:
+      return "AMX_FP16";
+    default:
+      LOG(FATAL) << "Unsupported CPU feature: " << cpu_feature;
+  }
+}
+
+std::vector<CPUFeature> CpuFeaturesFromString(absl::string_view cpu_features) {
+  std::vector<CPUFeature> result;
+  for (absl::string_view cpu_feature :
+       absl::StrSplit(cpu_features, ',', absl::SkipWhitespace())) {
+    std::optional<CPUFeature> feature =
+        CpuFeatureFromString(absl::StripAsciiWhitespace(cpu_feature));
+    if (feature.has_value()) result.push_back(*feature);
+  }
+  return result;
+}
+
+// Returns the generation of the instruction set, newer instruction sets are
+// supersets of all older ones.
+static int32_t CpuFeatureGeneration(CPUFeature cpu_feature) {
+  switch (cpu_feature) {
+    case CPUFeature::SSE4_2:
+      return 0;
+    case CPUFeature::AVX:
+      return 1;
+    case CPUFeature::AVX2:
+      return 2;
+    case CPUFeature::AVX512F:
+      return 3;
+    case CPUFeature::AVX512_VNNI:
+      return 4;
+    case CPUFeature::AVX512_BF16:
+      return 5;
+    case CPUFeature::AMX_BF16:
+    case CPUFeature::AMX_INT8:
+      return 6;
+    case CPUFeature::AMX_FP16:
+      return 7;
+    default:
+      return -1;
+  }
+}
+
+std::optional<CPUFeature> SelectNewestSupportedCpuFeature(
+    absl::Span<const CPUFeature> cpu_features) {
+  std::optional<CPUFeature> newest;
+  for (CPUFeature cpu_feature : cpu_features) {
+    if (!tsl::port::TestCPUFeature(cpu_feature)) continue;
+    if (newest.has_value() &&
+        CpuFeatureGeneration(*newest) >= CpuFeatureGeneration(cpu_feature)) {
+      continue;
+    }
+    newest = cpu_feature;
+  }
+  return newest;
+}
+
+bool HostSupportsTargetFeatures(absl::string_view target_features) {
+  llvm::StringMap<bool> host_features = llvm::sys::getHostCPUFeatures();
+  for (absl::string_view feature :
+       absl::StrSplit(target_features, ',', absl::SkipEmpty())) {
+    if (!absl::ConsumePrefix(&feature, "+")) continue;
+    llvm::StringRef name(feature.data(), feature.size());
+    auto it = host_features.find(name);
+    if (it == host_features.end() || !it->second) return false;
+  }
+  return true;
+}
+
 // We deliberately opt-out of the cognitive complexity check because a giant
 // switch statement is the most readable way to express the logic.
 //
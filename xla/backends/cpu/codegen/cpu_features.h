@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tsl/platform/cpu_info.h"
 
 namespace xla::cpu {
@@ -35,6 +36,24 @@ absl::string_view CpuTargetFromMaxFeature(tsl::port::CPUFeature max_feature);
 std::optional<tsl::port::CPUFeature> CpuFeatureFromString(
     absl::string_view cpu_feature);
 
+// Returns the string representation of a CPU feature accepted by
+// `CpuFeatureFromString`.
+absl::string_view CpuFeatureToString(tsl::port::CPUFeature cpu_feature);
+
+// Converts a comma-separated list of CPU features (e.g. "AVX2,AVX512") to a
+// list of CPUFeature enums. Unknown CPU features are skipped.
+std::vector<tsl::port::CPUFeature> CpuFeaturesFromString(
+    absl::string_view cpu_features);
+
+// Returns the newest CPU feature from `cpu_features` that is supported by the
+// host CPU, or std::nullopt if the host CPU doesn't support any of them.
+std::optional<tsl::port::CPUFeature> SelectNewestSupportedCpuFeature(
+    absl::Span<const tsl::port::CPUFeature> cpu_features);
+
+// Returns true if the host CPU supports all features enabled in the LLVM
+// target features string (e.g. "+avx2,+fma,-avx512f").
+bool HostSupportsTargetFeatures(absl::string_view target_features);
+
 // Returns true if `feature` can be enabled given the maximum allowed CPU
 // feature `max_feature`.
 bool ShouldEnableCpuFeature(absl::string_view feature,
@@ -0,0 +1,625 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/elemental/reduction_kernel_emitter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Type.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/Alignment.h"
+#include "llvm/Support/MathExtras.h"
+#include "xla/backends/cpu/codegen/elemental/elemental_kernel_emitter.h"
+#include "xla/backends/cpu/codegen/kernel_api_ir_builder.h"
+#include "xla/backends/cpu/codegen/target_machine_features.h"
+#include "xla/codegen/kernel_definition.h"
+#include "xla/codegen/kernel_spec.h"
+#include "xla/codegen/llvm_ir_kernel_source.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/service/cpu/backend_config.pb.h"
+#include "xla/service/cpu/shape_partition.h"
+#include "xla/service/llvm_ir/ir_array.h"
+#include "xla/service/llvm_ir/kernel_support_library.h"
+#include "xla/service/llvm_ir/llvm_util.h"
+#include "xla/shape.h"
+#include "xla/stream_executor/launch_dim.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+namespace {
+
+// Combines two scalars or two vectors of the same type into one value.
+using ReductionGenerator = std::function<llvm::Value*(
+    llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs)>;
+
+// Reduce operand normalized to a row-major [outer, reduced, inner] shape. The
+// result has a row-major [outer, inner] shape.
+struct ReductionDims {
+  int64_t outer = 1;
+  int64_t reduced = 1;
+  int64_t inner = 1;
+};
+
+// IR emission parameters shared by row and column reductions.
+struct ReductionEmitterContext {
+  llvm::IRBuilderBase* b;
+  ReductionGenerator generator;
+
+  llvm::Type* element_type;
+  llvm::VectorType* vector_type;
+  llvm::Align alignment;
+
+  // Number of elements in a vector register.
+  int64_t vector_width;
+  // Maximum number of independent vector accumulators.
+  int64_t num_accumulators;
+
+  const llvm_ir::IrArray* input;
+  llvm::Value* init_value;
+  const llvm_ir::IrArray* output;
+};
+
+absl::StatusOr<ReductionGenerator> MatchReductionGenerator(
+    const HloComputation* function, bool enable_fast_min_max) {
+  const HloInstruction* root = function->root_instruction();
+  if (function->num_parameters() != 2 || root->operand_count() != 2) {
+    return InvalidArgument("Reduction computation is not a binary operation");
+  }
+
+  const HloInstruction* param0 = function->parameter_instruction(0);
+  const HloInstruction* param1 = function->parameter_instruction(1);
+  if (!(root->operand(0) == param0 && root->operand(1) == param1) &&
+      !(root->operand(0) == param1 && root->operand(1) == param0)) {
+    return InvalidArgument(
+        "Reduction computation is not a binary operation on its parameters");
+  }
+
+  PrimitiveType type = root->shape().element_type();
+  bool is_float = primitive_util::IsFloatingPointType(type);
+  bool is_signed = primitive_util::IsSignedIntegralType(type);
+
+  switch (root->opcode()) {
+    case HloOpcode::kAdd:
+      return [is_float](llvm::IRBuilderBase* b, llvm::Value* lhs,
+                        llvm::Value* rhs) {
+        return is_float ? b->CreateFAdd(lhs, rhs) : b->CreateAdd(lhs, rhs);
+      };
+    case HloOpcode::kMultiply:
+      return [is_float](llvm::IRBuilderBase* b, llvm::Value* lhs,
+                        llvm::Value* rhs) {
+        return is_float ? b->CreateFMul(lhs, rhs) : b->CreateMul(lhs, rhs);
+      };
+    case HloOpcode::kAnd:
+      return [](llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
+        return b->CreateAnd(lhs, rhs);
+      };
+    case HloOpcode::kOr:
+      return [](llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
+        return b->CreateOr(lhs, rhs);
+      };
+    case HloOpcode::kXor:
+      return [](llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
+        return b->CreateXor(lhs, rhs);
+      };
+    case HloOpcode::kMaximum:
+      return [=](llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
+        if (is_float) {
+          return llvm_ir::EmitFloatMax(lhs, rhs, b, enable_fast_min_max);
+        }
+        return b->CreateSelect(
+            b->CreateICmp(is_signed ? llvm::ICmpInst::ICMP_SGE
+                                    : llvm::ICmpInst::ICMP_UGE,
+                          lhs, rhs),
+            lhs, rhs);
+      };
+    case HloOpcode::kMinimum:
+      return [=](llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
+        if (is_float) {
+          return llvm_ir::EmitFloatMin(lhs, rhs, b, enable_fast_min_max);
+        }
+        return b->CreateSelect(
+            b->CreateICmp(is_signed ? llvm::ICmpInst::ICMP_SLE
+                                    : llvm::ICmpInst::ICMP_ULE,
+                          lhs, rhs),
+            lhs, rhs);
+      };
+    default:
+      return InvalidArgument("Unsupported reduction computation root: %s",
+                             HloOpcodeString(root->opcode()));
+  }
+}
+
+// Returns reduction dimensions normalized to a [outer, reduced, inner] shape,
+// or an error if reduced dimensions are not physically contiguous in the
+// operand or if the result layout does not preserve the order of the kept
+// dimensions.
+absl::StatusOr<ReductionDims> GetReductionDims(const HloInstruction* reduce) {
+  const Shape& input_shape = reduce->operand(0)->shape();
+  const Shape& output_shape = reduce->shape();
+
+  if (!input_shape.has_layout() || !output_shape.has_layout()) {
+    return InvalidArgument("Reduction operand and result must have layouts");
+  }
+
+  absl::Span<const int64_t> reduced_dims = reduce->dimensions();
+  auto is_reduced = [&](int64_t dim) {
+    return absl::c_linear_search(reduced_dims, dim);
+  };
+
+  // Kept operand dimensions in logical order, corresponding to result dims.
+  std::vector<int64_t> kept_dims;
+  for (int64_t dim = 0; dim < input_shape.dimensions_size(); ++dim) {
+    if (!is_reduced(dim)) kept_dims.push_back(dim);
+  }
+
+  // Walk operand dimensions from major to minor, and check that they form a
+  // [kept..., reduced..., kept...] sequence. Degenerate dimensions do not
+  // change physical layout and can be ignored.
+  ReductionDims dims;
+  std::vector<int64_t> kept_physical_dims;
+  enum class Phase { kOuter, kReduced, kInner } phase = Phase::kOuter;
+
+  for (int64_t i = input_shape.dimensions_size() - 1; i >= 0; --i) {
+    int64_t dim = LayoutUtil::Minor(input_shape.layout(), i);
+    int64_t size = input_shape.dimensions(dim);
+
+    if (size == 1) continue;
+
+    if (is_reduced(dim)) {
+      if (phase == Phase::kInner) {
+        return InvalidArgument("Reduced dimensions are not contiguous");
+      }
+      phase = Phase::kReduced;
+      dims.reduced *= size;
+      continue;
+    }
+
+    kept_physical_dims.push_back(dim);
+    if (phase == Phase::kOuter) {
+      dims.outer *= size;
+    } else {
+      phase = Phase::kInner;
+      dims.inner *= size;
+    }
+  }
+
+  // Result dimensions must have the same physical order as the kept operand
+  // dimensions, ignoring degenerate dimensions.
+  std::vector<int64_t> output_physical_dims;
+  for (int64_t i = output_shape.dimensions_size() - 1; i >= 0; --i) {
+    int64_t dim = LayoutUtil::Minor(output_shape.layout(), i);
+    if (output_shape.dimensions(dim) == 1) continue;
+    output_physical_dims.push_back(kept_dims[dim]);
+  }
+
+  if (kept_physical_dims != output_physical_dims) {
+    return InvalidArgument("Reduction does not preserve operand layout");
+  }
+
+  return dims;
+}
+
+llvm::Value* LoadVector(const ReductionEmitterContext& ctx,
+                        const llvm_ir::IrArray& array, llvm::Value* offset) {
+  llvm::IRBuilderBase* b = ctx.b;
+  llvm::Value* ptr =
+      b->CreateInBoundsGEP(ctx.element_type, array.GetBasePointer(), offset);
+  llvm::LoadInst* load =
+      b->CreateAlignedLoad(ctx.vector_type, ptr, ctx.alignment);
+  array.AnnotateLoadStoreInstructionWithMetadata(load);
+  return load;
+}
+
+llvm::Value* LoadScalar(const ReductionEmitterContext& ctx,
+                        const llvm_ir::IrArray& array, llvm::Value* offset) {
+  llvm::IRBuilderBase* b = ctx.b;
+  llvm::Value* ptr =
+      b->CreateInBoundsGEP(ctx.element_type, array.GetBasePointer(), offset);
+  llvm::LoadInst* load =
+      b->CreateAlignedLoad(ctx.element_type, ptr, ctx.alignment);
+  array.AnnotateLoadStoreInstructionWithMetadata(load);
+  return load;
+}
+
+void Store(const ReductionEmitterContext& ctx, const llvm_ir::IrArray& array,
+           llvm::Value* offset, llvm::Value* value) {
+  llvm::IRBuilderBase* b = ctx.b;
+  llvm::Value* ptr =
+      b->CreateInBoundsGEP(ctx.element_type, array.GetBasePointer(), offset);
+  llvm::StoreInst* store = b->CreateAlignedStore(value, ptr, ctx.alignment);
+  array.AnnotateLoadStoreInstructionWithMetadata(store);
+}
+
+// Combines values pairwise until a single value is left. Compared to a linear
+// chain this has a shorter dependency chain and a smaller rounding error.
+llvm::Value* EmitTreeReduction(const ReductionEmitterContext& ctx,
+                               std::vector<llvm::Value*> values) {
+  CHECK(!values.empty());
+  while (values.size() > 1) {
+    std::vector<llvm::Value*> next;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+      next.push_back(ctx.generator(ctx.b, values[i], values[i + 1]));
+    }
+    if (values.size() % 2) next.push_back(values.back());
+    values = std::move(next);
+  }
+  return values.front();
+}
+
+// Reduces all lanes of a vector to a scalar by repeatedly combining the low
+// and the high halves of the vector.
+llvm::Value* EmitHorizontalReduction(const ReductionEmitterContext& ctx,
+                                     llvm::Value* vector) {
+  llvm::IRBuilderBase* b = ctx.b;
+  for (int64_t width = ctx.vector_width; width > 1; width /= 2) {
+    llvm::SmallVector<int, 16> lo_mask, hi_mask;
+    for (int64_t i = 0; i < width / 2; ++i) {
+      lo_mask.push_back(i);
+      hi_mask.push_back(width / 2 + i);
+    }
+    llvm::Value* lo = b->CreateShuffleVector(vector, lo_mask);
+    llvm::Value* hi = b->CreateShuffleVector(vector, hi_mask);
+    vector = ctx.generator(b, lo, hi);
+  }
+  return b->CreateExtractElement(vector, uint64_t{0});
+}
+
+// Emits a reduction of a single row of `dims.reduced` contiguous elements.
+//
+// Vector accumulators are initialized from the first elements of the row, so
+// the init value is applied exactly once at the end even if it is not the
+// identity of the reduction computation.
+void EmitRowReduction(const ReductionEmitterContext& ctx,
+                      const ReductionDims& dims, llvm::Value* row) {
+  llvm::IRBuilderBase* b = ctx.b;
+  KernelSupportLibrary ksl(b);
+
+  const int64_t width = ctx.vector_width;
+  const int64_t num_vectors = dims.reduced / width;
+
+  llvm::Value* row_offset = b->CreateMul(row, b->getInt64(dims.reduced));
+  auto offset = [&](llvm::Value* idx) { return b->CreateAdd(row_offset, idx); };
+
+  llvm::Value* result = ctx.init_value;
+
+  if (num_vectors > 0) {
+    const int64_t num_accumulators =
+        std::min(ctx.num_accumulators, num_vectors);
+    const int64_t step = num_accumulators * width;
+    const int64_t main_end = (num_vectors / num_accumulators) * step;
+
+    std::vector<llvm::AllocaInst*> accumulators;
+    for (int64_t j = 0; j < num_accumulators; ++j) {
+      llvm::AllocaInst* acc = llvm_ir::EmitAllocaAtFunctionEntry(
+          ctx.vector_type, absl::StrCat("row_acc_", j), b);
+      b->CreateStore(
+          LoadVector(ctx, *ctx.input, offset(b->getInt64(j * width))), acc);
+      accumulators.push_back(acc);
+    }
+
+    ksl.For("row_reduce", b->getInt64(step), b->getInt64(main_end),
+            b->getInt64(step), [&](llvm::Value* k) {
+              for (int64_t j = 0; j < num_accumulators; ++j) {
+                llvm::Value* idx = b->CreateAdd(k, b->getInt64(j * width));
+                llvm::Value* acc =
+                    b->CreateLoad(ctx.vector_type, accumulators[j]);
+                llvm::Value* x = LoadVector(ctx, *ctx.input, offset(idx));
+                b->CreateStore(ctx.generator(b, acc, x), accumulators[j]);
+              }
+            });
+
+    std::vector<llvm::Value*> partials;
+    for (llvm::AllocaInst* acc : accumulators) {
+      partials.push_back(b->CreateLoad(ctx.vector_type, acc));
+    }
+
+    // Remaining full vectors that did not fill all accumulators.
+    for (int64_t k = main_end, j = 0; k < num_vectors * width;
+         k += width, ++j) {
+      llvm::Value* x = LoadVector(ctx, *ctx.input, offset(b->getInt64(k)));
+      partials[j] = ctx.generator(b, partials[j], x);
+    }
+
+    llvm::Value* partial =
+        EmitHorizontalReduction(ctx, EmitTreeReduction(ctx, partials));
+    result = ctx.generator(b, result, partial);
+  }
+
+  // Scalar tail that does not fill a vector register.
+  for (int64_t k = num_vectors * width; k < dims.reduced; ++k) {
+    llvm::Value* x = LoadScalar(ctx, *ctx.input, offset(b->getInt64(k)));
+    result = ctx.generator(b, result, x);
+  }
+
+  Store(ctx, *ctx.output, row, result);
+}
+
+// Emits a reduction of a tile of `tile_width` adjacent columns of the
+// [dims.reduced, dims.inner] matrix at `outer` index, starting at `column`.
+// Every lane of the vector accumulators corresponds to a separate result, so
+// accumulators start from the (splat) init value.
+void EmitColumnTileReduction(const ReductionEmitterContext& ctx,
+                             const ReductionDims& dims, llvm::Value* outer,
+                             llvm::Value* column, int64_t tile_width) {
+  llvm::IRBuilderBase* b = ctx.b;
+  KernelSupportLibrary ksl(b);
+
+  const int64_t width = ctx.vector_width;
+  const int64_t num_vectors = tile_width / width;
+  const int64_t num_scalars = tile_width % width;
+
+  std::vector<llvm::AllocaInst*> accumulators;
+  for (int64_t j = 0; j < num_vectors; ++j) {
+    llvm::AllocaInst* acc = llvm_ir::EmitAllocaAtFunctionEntry(
+        ctx.vector_type, absl::StrCat("column_acc_", j), b);
+    b->CreateStore(b->CreateVectorSplat(width, ctx.init_value), acc);
+    accumulators.push_back(acc);
+  }
+  for (int64_t j = 0; j < num_scalars; ++j) {
+    llvm::AllocaInst* acc = llvm_ir::EmitAllocaAtFunctionEntry(
+        ctx.element_type, absl::StrCat("column_acc_", num_vectors + j), b);
+    b->CreateStore(ctx.init_value, acc);
+    accumulators.push_back(acc);
+  }
+
+  // Offset of the first element of the tile in the [outer, reduced, inner]
+  // operand and the [outer, inner] result.
+  llvm::Value* input_offset = b->CreateAdd(
+      b->CreateMul(outer, b->getInt64(dims.reduced * dims.inner)), column);
+  llvm::Value* output_offset =
+      b->CreateAdd(b->CreateMul(outer, b->getInt64(dims.inner)), column);
+
+  // Vector accumulators are followed by scalar accumulators for the columns
+  // that do not fill a vector register.
+  const int64_t num_accumulators = num_vectors + num_scalars;
+  auto column_offset = [&](int64_t j) {
+    if (j < num_vectors) return j * width;
+    return num_vectors * width + (j - num_vectors);
+  };
+
+  ksl.For("column_reduce", b->getInt64(0), b->getInt64(dims.reduced),
+          b->getInt64(1), [&](llvm::Value* k) {
+            llvm::Value* row_offset = b->CreateAdd(
+                input_offset, b->CreateMul(k, b->getInt64(dims.inner)));
+            for (int64_t j = 0; j < num_accumulators; ++j) {
+              llvm::Value* idx =
+                  b->CreateAdd(row_offset, b->getInt64(column_offset(j)));
+              llvm::Value* x = j < num_vectors
+                                   ? LoadVector(ctx, *ctx.input, idx)
+                                   : LoadScalar(ctx, *ctx.input, idx);
+              llvm::Value* acc = b->CreateLoad(
+                  accumulators[j]->getAllocatedType(), accumulators[j]);
+              b->CreateStore(ctx.generator(b, acc, x), accumulators[j]);
+            }
+          });
+
+  for (int64_t j = 0; j < num_accumulators; ++j) {
+    llvm::Value* acc =
+        b->CreateLoad(accumulators[j]->getAllocatedType(), accumulators[j]);
+    llvm::Value* idx =
+        b->CreateAdd(output_offset, b->getInt64(column_offset(j)));
+    Store(ctx, *ctx.output, idx, acc);
+  }
+}
+
+// Returns the number of parallel tasks requested for the instruction by the
+// parallel task assigner.
+int64_t GetParallelTaskCount(const HloInstruction* instr) {
+  auto backend_config = instr->backend_config<BackendConfig>();
+  if (!backend_config.ok() ||
+      backend_config->outer_dimension_partitions().empty()) {
+    return 1;
+  }
+  std::vector<int64_t> partitions(
+      backend_config->outer_dimension_partitions().begin(),
+      backend_config->outer_dimension_partitions().end());
+  return ShapePartitionAssigner::GetTotalPartitionCount(partitions);
+}
+
+}  // namespace
+
+ReductionKernelEmitter::ReductionKernelEmitter(
+    const HloInstruction* instr, const BufferAssignment* buffer_assignment,
+    const TargetMachineFeatures* target_machine)
+    : instr_(instr),
+      buffer_assignment_(buffer_assignment),
+      target_machine_(target_machine) {}
+
+absl::StatusOr<KernelDefinition>
+ReductionKernelEmitter::EmitKernelDefinition() {
+  const HloModule* hlo_module = instr_->GetModule();
+  if (hlo_module == nullptr) {
+    return Internal("HloModule is null");
+  }
+
+  bool enable_fast_min_max =
+      hlo_module->config().debug_options().xla_cpu_enable_fast_min_max();
+
+  auto fallback = [&](const absl::Status& status) {
+    VLOG(1) << "Could not emit vectorized reduction for " << instr_->ToString()
+            << ": " << status.message();
+    return ElementalKernelEmitter(instr_, buffer_assignment_, target_machine_)
+        .EmitKernelDefinition();
+  };
+
+  if (instr_->opcode() != HloOpcode::kReduce || !instr_->shape().IsArray() ||
+      !instr_->shape().is_static()) {
+    return fallback(InvalidArgument("Not a single-result static reduce"));
+  }
+
+  PrimitiveType element_type = instr_->shape().element_type();
+  if (!(element_type == F32 || element_type == F64 ||
+        (primitive_util::IsIntegralType(element_type) &&
+         primitive_util::BitWidth(element_type) >= 8))) {
+    return fallback(InvalidArgument("Unsupported element type: %s",
+                                    PrimitiveType_Name(element_type)));
+  }
+
+  absl::StatusOr<ReductionDims> dims = GetReductionDims(instr_);
+  if (!dims.ok()) return fallback(dims.status());
+
+  absl::StatusOr<ReductionGenerator> generator =
+      MatchReductionGenerator(instr_->to_apply(), enable_fast_min_max);
+  if (!generator.ok()) return fallback(generator.status());
+
+  auto ctx = std::make_unique<llvm::LLVMContext>();
+
+  KernelApiIrBuilder kernel_api_ir_builder(
+      *ctx,
+      KernelApiIrBuilder::Options::FromHloModuleConfig(hlo_module->config()));
+
+  std::unique_ptr<llvm::Module> llvm_module = KernelApiIrBuilder::CreateModule(
+      absl::StrCat(instr_->name(), "_reduction_kernel_module"), *ctx);
+
+  TF_ASSIGN_OR_RETURN(KernelApiIrBuilder::KernelPrototype kernel_prototype,
+                      kernel_api_ir_builder.EmitKernelPrototype(
+                          *llvm_module, instr_, buffer_assignment_, "_kernel"));
+
+  int64_t byte_width = primitive_util::ByteWidth(element_type);
+  int64_t register_bytes =
+      target_machine_->vector_register_byte_size(*kernel_prototype.function);
+  int64_t vector_width = register_bytes / byte_width;
+
+  if (vector_width < 2 || !llvm::isPowerOf2_64(vector_width)) {
+    return fallback(InvalidArgument("Unsupported vector width: %d",
+                                    vector_width));
+  }
+
+  // We process `vectorization_factor_in_bytes` bytes at once using multiple
+  // independent accumulators to hide the latency of the reduction operation.
+  int64_t num_accumulators = std::max<int64_t>(
+      1, target_machine_->vectorization_factor_in_bytes() / register_bytes);
+
+  llvm::IRBuilder<> b(*ctx);
+  b.SetInsertPoint(kernel_prototype.function->getEntryBlock().getTerminator());
+
+  llvm::Type* ir_element_type =
+      llvm_ir::PrimitiveTypeToIrType(element_type, *ctx);
+
+  llvm::Value* init_value = b.CreateAlignedLoad(
+      ir_element_type, kernel_prototype.arguments[1].GetBasePointer(),
+      llvm::Align(byte_width), "init_value");
+
+  ReductionEmitterContext emitter_ctx{
+      &b,
+      *generator,
+      ir_element_type,
+      llvm::FixedVectorType::get(ir_element_type, vector_width),
+      llvm::Align(byte_width),
+      vector_width,
+      num_accumulators,
+      &kernel_prototype.arguments[0],
+      init_value,
+      &kernel_prototype.results[0]};
+
+  // Every task reduces one row, or one tile of columns at one outer index.
+  bool is_row_reduction = dims->inner == 1;
+  int64_t tile_width = num_accumulators * vector_width;
+  int64_t tiles_per_row = CeilOfRatio(dims->inner, tile_width);
+  int64_t num_tasks =
+      is_row_reduction ? dims->outer : dims->outer * tiles_per_row;
+
+  // Split tasks evenly between the requested number of threads.
+  int64_t num_threads = std::max<int64_t>(
+      1, std::min(GetParallelTaskCount(instr_), num_tasks));
+
+  llvm::Value* task_begin = b.getInt64(0);
+  llvm::Value* task_end = b.getInt64(num_tasks);
+  if (num_threads > 1) {
+    llvm::Value* tid = kernel_prototype.thread_id.x;
+    llvm::Value* num_tasks_value = b.getInt64(num_tasks);
+    llvm::Value* num_threads_value = b.getInt64(num_threads);
+    task_begin = b.CreateUDiv(b.CreateMul(tid, num_tasks_value),
+                              num_threads_value, "task_begin");
+    task_end = b.CreateUDiv(
+        b.CreateMul(b.CreateAdd(tid, b.getInt64(1)), num_tasks_value),
+        num_threads_value, "task_end");
+  }
+
+  KernelSupportLibrary ksl(&b);
+  ksl.For("task", task_begin, task_end, b.getInt64(1), [&](llvm::Value* task) {
+    if (is_row_reduction) {
+      EmitRowReduction(emitter_ctx, *dims, task);
+      return;
+    }
+
+    llvm::Value* outer = b.CreateUDiv(task, b.getInt64(tiles_per_row));
+    llvm::Value* tile = b.CreateURem(task, b.getInt64(tiles_per_row));
+    llvm::Value* column = b.CreateMul(tile, b.getInt64(tile_width));
+
+    int64_t num_full_tiles = dims->inner / tile_width;
+    int64_t last_tile_width = dims->inner % tile_width;
+
+    if (last_tile_width == 0) {
+      EmitColumnTileReduction(emitter_ctx, *dims, outer, column, tile_width);
+      return;
+    }
+
+    if (num_full_tiles == 0) {
+      EmitColumnTileReduction(emitter_ctx, *dims, outer, column,
+                              last_tile_width);
+      return;
+    }
+
+    ksl.If(
+        "is_full_tile", b.CreateICmpULT(tile, b.getInt64(num_full_tiles)),
+        [&] {
+          EmitColumnTileReduction(emitter_ctx, *dims, outer, column,
+                                  tile_width);
+        },
+        [&] {
+          EmitColumnTileReduction(emitter_ctx, *dims, outer, column,
+                                  last_tile_width);
+        });
+  });
+
+  auto source = std::make_unique<LlvmIrKernelSource>(std::move(ctx),
+                                                     std::move(llvm_module));
+  KernelSpec spec(kernel_prototype.function->getName(),
+                  se::ThreadDim(num_threads),
+                  std::move(kernel_prototype.argument_buffers),
+                  std::move(kernel_prototype.result_buffers),
+                  std::move(kernel_prototype.invariant_arguments));
+
+  return KernelDefinition(std::move(spec), std::move(source));
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,58 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_CODEGEN_ELEMENTAL_REDUCTION_KERNEL_EMITTER_H_
+#define XLA_BACKENDS_CPU_CODEGEN_ELEMENTAL_REDUCTION_KERNEL_EMITTER_H_
+
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/codegen/target_machine_features.h"
+#include "xla/codegen/kernel_definition.h"
+#include "xla/codegen/kernel_emitter.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/buffer_assignment.h"
+
+namespace xla::cpu {
+
+// Emits a kernel for a reduce instruction with explicitly vectorized loops.
+//
+// Supported reductions are normalized to a row-major [outer, reduced, inner]
+// shape, where reduced dimensions are physically contiguous in the operand:
+//
+//   - row reduction (inner == 1): every row is reduced with multiple vector
+//     accumulators that are combined with a tree reduction at the end;
+//   - column reduction (inner > 1): tiles of columns are accumulated in
+//     vector registers while walking over the reduced dimension.
+//
+// Full reductions are row reductions with a single row. Rows (or tiles of
+// columns) are split across the intra-op thread pool if the instruction has
+// a parallel config. All other reductions fall back to the elemental emitter.
+class ReductionKernelEmitter final : public KernelEmitter {
+ public:
+  ReductionKernelEmitter(const HloInstruction* instr,
+                         const BufferAssignment* buffer_assignment,
+                         const TargetMachineFeatures* target_machine);
+
+  absl::StatusOr<KernelDefinition> EmitKernelDefinition() final;
+
+ private:
+  const HloInstruction* instr_;
+
+  const BufferAssignment* buffer_assignment_;
+  const TargetMachineFeatures* target_machine_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_CODEGEN_ELEMENTAL_REDUCTION_KERNEL_EMITTER_H_
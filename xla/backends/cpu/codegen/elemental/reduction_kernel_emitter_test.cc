@@ -0,0 +1,213 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/elemental/reduction_kernel_emitter.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+#include "llvm/IR/Function.h"
+#include "xla/backends/cpu/codegen/target_machine_features.h"
+#include "xla/codegen/kernel_definition.h"
+#include "xla/hlo/analysis/hlo_ordering.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/hlo/testlib/filecheck.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/service/logical_buffer.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::cpu {
+
+// Target machine features of an AVX2 machine: 32-byte vector registers.
+class TargetMachineFeaturesForTest : public TargetMachineFeatures {
+ public:
+  TargetMachineFeaturesForTest() : TargetMachineFeatures(nullptr) {}
+
+  int32_t vectorization_factor_in_bytes() const final { return 128; }
+
+  int32_t vector_register_byte_size(const llvm::Function& fn) const final {
+    return 32;
+  }
+
+  int64_t minimum_alignment_for_allocation(int64_t size_bytes) const final {
+    return 1;
+  }
+};
+
+class ReductionKernelEmitterTest : public HloTestBase {
+ public:
+  absl::StatusOr<KernelDefinition> EmitKernelDefinition(
+      const HloInstruction* instr, const BufferAssignment* buffer_assignment) {
+    ReductionKernelEmitter emitter(instr, buffer_assignment,
+                                   &target_machine_features_);
+    return emitter.EmitKernelDefinition();
+  }
+
+  absl::StatusOr<std::unique_ptr<BufferAssignment>> RunBufferAssignment(
+      const HloModule& hlo) {
+    return BufferAssigner::Run(
+        &hlo, std::make_unique<DependencyHloOrdering>(&hlo),
+        backend().compiler()->BufferSizeBytesFunction(),
+        [](LogicalBuffer::Color) { return /*alignment=*/1; });
+  }
+
+  absl::StatusOr<std::string> EmitKernelSource(const char* hlo_text) {
+    TF_ASSIGN_OR_RETURN(auto hlo, ParseAndReturnUnverifiedModule(hlo_text));
+    TF_ASSIGN_OR_RETURN(auto buffer_assignment, RunBufferAssignment(*hlo));
+    TF_ASSIGN_OR_RETURN(
+        KernelDefinition kernel_definition,
+        EmitKernelDefinition(hlo->entry_computation()->root_instruction(),
+                             buffer_assignment.get()));
+    return kernel_definition.source().ToString();
+  }
+
+ private:
+  TargetMachineFeaturesForTest target_machine_features_;
+};
+
+namespace {
+
+TEST_F(ReductionKernelEmitterTest, RowReduction) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY main {
+      p0 = f32[4,100]{1,0} parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[4]{0} reduce(p0, c0), dimensions={1}, to_apply=add
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::string source, EmitKernelSource(hlo_text));
+
+  // 100 elements are reduced with four vector accumulators of 8 floats, the
+  // remaining vector and four scalars. Accumulators are combined with a tree
+  // reduction and then reduced horizontally.
+  ASSERT_TRUE(*RunFileCheck(source, R"(
+    CHECK: define ptr @reduce_kernel(ptr %0) #0 {
+    CHECK-COUNT-4: load <8 x float>
+    CHECK-COUNT-4: fadd <8 x float>
+    CHECK: fadd <8 x float>
+    CHECK: shufflevector <8 x float> {{.*}} <i32 0, i32 1, i32 2, i32 3>
+    CHECK: shufflevector <4 x float> {{.*}} <2 x i32> <i32 0, i32 1>
+    CHECK: shufflevector <2 x float> {{.*}} <1 x i32> zeroinitializer
+    CHECK-COUNT-4: fadd float
+    CHECK: }
+  )"));
+}
+
+TEST_F(ReductionKernelEmitterTest, ColumnReduction) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    max {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT max = f32[] maximum(p0, p1)
+    }
+
+    ENTRY main {
+      p0 = f32[100,40]{1,0} parameter(0)
+      c0 = f32[] constant(-inf)
+      ROOT reduce = f32[40]{0} reduce(p0, c0), dimensions={0}, to_apply=max
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::string source, EmitKernelSource(hlo_text));
+
+  // 40 columns are split into a full tile of 32 columns with four vector
+  // accumulators and a partial tile of 8 columns with a single accumulator.
+  ASSERT_TRUE(*RunFileCheck(source, R"(
+    CHECK: define ptr @reduce_kernel(ptr %0) #0 {
+    CHECK: is_full_tile
+    CHECK-COUNT-4: call <8 x float> @llvm.maximum.v8f32
+    CHECK: call <8 x float> @llvm.maximum.v8f32
+    CHECK-NOT: call float @llvm.maximum.f32
+    CHECK: }
+  )"));
+}
+
+TEST_F(ReductionKernelEmitterTest, ParallelRowReduction) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    add {
+      p0 = s32[] parameter(0)
+      p1 = s32[] parameter(1)
+      ROOT add = s32[] add(p0, p1)
+    }
+
+    ENTRY main {
+      p0 = s32[64,256]{1,0} parameter(0)
+      c0 = s32[] constant(0)
+      ROOT reduce = s32[64]{0} reduce(p0, c0), dimensions={1}, to_apply=add,
+        backend_config={"outer_dimension_partitions":["4"]}
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo, ParseAndReturnUnverifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(auto buffer_assignment, RunBufferAssignment(*hlo));
+  TF_ASSERT_OK_AND_ASSIGN(
+      KernelDefinition kernel_definition,
+      EmitKernelDefinition(hlo->entry_computation()->root_instruction(),
+                           buffer_assignment.get()));
+
+  EXPECT_EQ(kernel_definition.spec().thread_dim().x, 4);
+
+  ASSERT_TRUE(*RunFileCheck(kernel_definition.source().ToString(), R"(
+    CHECK: define ptr @reduce_kernel(ptr %0) #0 {
+    CHECK: %task_begin = udiv i64 {{.*}}, 4
+    CHECK: %task_end = udiv i64 {{.*}}, 4
+    CHECK: add <8 x i32>
+    CHECK: }
+  )"));
+}
+
+TEST_F(ReductionKernelEmitterTest, FallbackToElementalKernel) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY main {
+      p0 = f32[4,8,16]{2,1,0} parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[8]{0} reduce(p0, c0), dimensions={0,2}, to_apply=add
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::string source, EmitKernelSource(hlo_text));
+
+  // Reduced dimensions are not contiguous, and we use the elemental emitter.
+  ASSERT_TRUE(*RunFileCheck(source, R"(
+    CHECK: define ptr @reduce_kernel(ptr %0) #0 {
+    CHECK-NOT: <8 x float>
+    CHECK: }
+  )"));
+}
+
+}  // namespace
+}  // namespace xla::cpu
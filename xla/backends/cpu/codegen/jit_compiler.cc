@@ -20,16 +20,23 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/call_once.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/log/log.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/ExecutorProcessControl.h"
@@ -37,10 +44,15 @@ limitations under the License.
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Mangler.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/TargetParser/Host.h"
@@ -104,6 +116,59 @@ JitCompiler::InferTargetMachine(
   return std::move(target_machine);
 }
 
+absl::StatusOr<std::unique_ptr<llvm::TargetMachine>>
+JitCompiler::InferMultiVersionedTargetMachine(
+    const llvm::TargetOptions& target_options, llvm::CodeGenOptLevel opt_level,
+    tsl::port::CPUFeature cpu_feature) {
+  absl::string_view cpu = CpuTargetFromMaxFeature(cpu_feature);
+
+  absl::call_once(initialize_llvm_flag, InitializeLLVMTarget);
+  auto select_target = [&](const llvm::SmallVector<std::string>& attrs) {
+    return std::unique_ptr<llvm::TargetMachine>(
+        llvm::EngineBuilder()
+            .setTargetOptions(target_options)
+            .setOptLevel(opt_level)
+            .selectTarget(
+                /*TargetTriple=*/llvm::Triple(), /*MArch=*/"",
+                /*MCPU=*/cpu,
+                /*MAttrs=*/attrs));
+  };
+
+  // Features of the generic CPU, without any features of the host CPU.
+  std::unique_ptr<llvm::TargetMachine> cpu_target_machine = select_target({});
+  if (cpu_target_machine == nullptr) {
+    return Internal("Failed to create target machine for CPU %s", cpu);
+  }
+
+  const llvm::MCSubtargetInfo* subtarget_info =
+      cpu_target_machine->getMCSubtargetInfo();
+  absl::flat_hash_set<absl::string_view> cpu_features;
+  for (const llvm::SubtargetFeatureKV& feature :
+       subtarget_info->getAllProcessorFeatures()) {
+    if (subtarget_info->getFeatureBits().test(feature.Value)) {
+      cpu_features.insert(feature.Key);
+    }
+  }
+
+  // Spell out all features known to the host CPU feature detection, so that
+  // the target features string can be checked against a host CPU before
+  // loading the compiled object files (see `HostSupportsTargetFeatures`).
+  llvm::SmallVector<std::string> attrs;
+  for (const auto& [feature, enabled] : llvm::sys::getHostCPUFeatures()) {
+    absl::string_view name(feature.data(), feature.size());
+    attrs.push_back(
+        absl::StrCat(cpu_features.contains(name) ? "+" : "-", name));
+  }
+  absl::c_sort(attrs);
+
+  std::unique_ptr<llvm::TargetMachine> target_machine = select_target(attrs);
+  if (target_machine == nullptr) {
+    return Internal("Failed to create target machine for CPU %s", cpu);
+  }
+
+  return std::move(target_machine);
+}
+
 IrCompiler::TargetMachineBuilder JitCompiler::InferTargetMachineBuilder(
     const llvm::TargetOptions& target_options, llvm::CodeGenOptLevel opt_level,
     std::optional<tsl::port::CPUFeature> max_cpu_feature) {
@@ -117,6 +182,21 @@ absl::StatusOr<JitCompiler> JitCompiler::Create(
     TaskRunner task_runner) {
   absl::call_once(initialize_llvm_flag, InitializeLLVMTarget);
 
+  // Create IR compilers for all multi-versioned targets. They share compiler
+  // options with the host compiler, and differ only in the target machine.
+  std::vector<std::unique_ptr<IrCompiler>> multi_versioned_compilers;
+  for (MultiVersionedTarget& target : options.multi_versioned_targets) {
+    IrCompiler::TargetMachineBuilder builder =
+        [target_options, opt_level = options.ir_compiler_options.opt_level,
+         cpu_feature = target.max_cpu_feature] {
+          return InferMultiVersionedTargetMachine(target_options, opt_level,
+                                                  cpu_feature);
+        };
+    multi_versioned_compilers.push_back(std::make_unique<IrCompiler>(
+        std::move(builder), options.ir_compiler_options,
+        std::move(target.ir_compiler_hooks)));
+  }
+
   // Infer target machine from the current host CPU.
   IrCompiler::TargetMachineBuilder target_machine_builder =
       InferTargetMachineBuilder(std::move(target_options),
@@ -146,7 +226,8 @@ absl::StatusOr<JitCompiler> JitCompiler::Create(
   return JitCompiler(
       std::move(target_machine_builder), std::move(target_machine),
       task_dispatcher_ptr, std::move(execution_session), std::move(ir_compiler),
-      options.num_dylibs, std::move(options.definition_generator));
+      options.num_dylibs, std::move(options.definition_generator),
+      std::move(multi_versioned_compilers));
 }
 
 static std::unique_ptr<llvm::orc::IRCompileLayer> CreateCompileLayer(
@@ -163,7 +244,8 @@ JitCompiler::JitCompiler(
     TaskDispatcher* task_dispatcher,
     std::unique_ptr<llvm::orc::ExecutionSession> execution_session,
     std::unique_ptr<IrCompiler> ir_compiler, size_t num_dylibs,
-    ExecutionEngine::DefinitionGenerator definition_generator)
+    ExecutionEngine::DefinitionGenerator definition_generator,
+    std::vector<std::unique_ptr<IrCompiler>> multi_versioned_compilers)
     : target_machine_builder_(std::move(target_machine_builder)),
       target_machine_(std::move(target_machine)),
       task_dispatcher_(task_dispatcher),
@@ -172,7 +254,9 @@ JitCompiler::JitCompiler(
           definition_generator)),
       compile_layer_(CreateCompileLayer(*execution_engine_->execution_session(),
                                         *execution_engine_->object_layer(),
-                                        std::move(ir_compiler))) {
+                                        std::move(ir_compiler))),
+      multi_versioned_compilers_(std::move(multi_versioned_compilers)),
+      multi_versioned_status_(std::make_unique<MultiVersionedStatus>()) {
   execution_engine_->AllocateDylibs(num_dylibs);
   execution_engine_->RegisterJITEventListeners();
 
@@ -181,7 +265,13 @@ JitCompiler::JitCompiler(
   }
 }
 
-JitCompiler::~JitCompiler() = default;
+JitCompiler::~JitCompiler() {
+  // Multi-versioned compilation tasks reference compilers and status owned by
+  // `this`, and we must wait for them before destroying any of the members.
+  // After `Compile` the task dispatcher is already shut down and destroyed
+  // together with the execution engine.
+  if (execution_engine_) task_dispatcher_->shutdown();
+}
 
 absl::Status JitCompiler::AddModule(llvm::orc::ThreadSafeModule module,
                                     size_t dylib_index) {
@@ -191,6 +281,12 @@ absl::Status JitCompiler::AddModule(llvm::orc::ThreadSafeModule module,
     m.setTargetTriple(target_machine_->getTargetTriple().getTriple());
   });
 
+  // Copy the module for multi-versioned targets before it is optimized and
+  // compiled for the host.
+  if (!multi_versioned_compilers_.empty()) {
+    module.withModuleDo([&](llvm::Module& m) { AddMultiVersionedModule(m); });
+  }
+
   // Add module to the selected dynamic library.
   TF_ASSIGN_OR_RETURN(llvm::orc::JITDylib * dylib,
                       execution_engine_->dylib(dylib_index));
@@ -202,6 +298,42 @@ absl::Status JitCompiler::AddModule(llvm::orc::ThreadSafeModule module,
   return absl::OkStatus();
 }
 
+void JitCompiler::AddMultiVersionedModule(const llvm::Module& module) {
+  // There is no way to clone a module from one context to another, so we
+  // serialize the module to bitcode, and every compilation task parses it back
+  // into its own LLVM context.
+  auto bitcode = std::make_shared<llvm::SmallString<0>>();
+  llvm::raw_svector_ostream bcos(*bitcode);
+  llvm::WriteBitcodeToFile(module, bcos);
+
+  std::string name = module.getModuleIdentifier();
+  MultiVersionedStatus* status = multi_versioned_status_.get();
+
+  for (std::unique_ptr<IrCompiler>& compiler : multi_versioned_compilers_) {
+    IrCompiler* ir_compiler = compiler.get();
+
+    auto compile = [ir_compiler, status, bitcode, name] {
+      llvm::LLVMContext context;
+      auto parsed = llvm::parseBitcodeFile(
+          llvm::MemoryBufferRef(
+              llvm::StringRef(bitcode->data(), bitcode->size()), name),
+          context);
+
+      llvm::Error err =
+          parsed ? (*ir_compiler)(**parsed).takeError() : parsed.takeError();
+      if (err) {
+        absl::MutexLock lock(&status->mu);
+        status->status.Update(
+            Internal("Failed to compile multi-versioned module %s: %s", name,
+                     llvm::toString(std::move(err))));
+      }
+    };
+
+    task_dispatcher_->dispatch(llvm::orc::makeGenericNamedTask(
+        std::move(compile), "JitCompiler::AddMultiVersionedModule"));
+  }
+}
+
 absl::StatusOr<std::unique_ptr<FunctionLibrary>> JitCompiler::Compile(
     absl::Span<const Symbol> symbols) && {
   TraceMe trace([&] {
@@ -213,6 +345,10 @@ absl::StatusOr<std::unique_ptr<FunctionLibrary>> JitCompiler::Compile(
   TF_ASSIGN_OR_RETURN(auto symbol_map, object_loader.LookupSymbols(symbols));
   // Wait for all compilation tasks to finish.
   task_dispatcher_->shutdown();
+  {
+    absl::MutexLock lock(&multi_versioned_status_->mu);
+    TF_RETURN_IF_ERROR(multi_versioned_status_->status);
+  }
   return std::move(object_loader)
       .CreateFunctionLibrary(std::move(symbols), symbol_map);
 }
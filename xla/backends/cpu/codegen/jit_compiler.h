@@ -36,6 +36,7 @@ limitations under the License.
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
@@ -77,6 +78,17 @@ class JitCompiler {
                      llvm::CodeGenOptLevel opt_level,
                      std::optional<tsl::port::CPUFeature> max_cpu_feature);
 
+  // Infers the `llvm::TargetMachine` for multi-versioned compilation. Unlike
+  // `InferTargetMachine`, it doesn't depend on the host CPU: it targets the
+  // oldest CPU of the `cpu_feature` generation (see `CpuTargetFromMaxFeature`)
+  // and only its features, so that compiled object files run on any CPU
+  // supporting `cpu_feature`. All features are explicitly listed in the target
+  // features string (e.g. "+avx2,-gfni").
+  static absl::StatusOr<std::unique_ptr<llvm::TargetMachine>>
+  InferMultiVersionedTargetMachine(const llvm::TargetOptions& target_options,
+                                   llvm::CodeGenOptLevel opt_level,
+                                   tsl::port::CPUFeature cpu_feature);
+
   // Returns a target machine builder that uses `InferTargetMachine` defined
   // above to infer the target machine for the given options.
   static IrCompiler::TargetMachineBuilder InferTargetMachineBuilder(
@@ -84,6 +96,16 @@ class JitCompiler {
       llvm::CodeGenOptLevel opt_level,
       std::optional<tsl::port::CPUFeature> max_cpu_feature);
 
+  // An additional target for multi-versioned compilation.
+  struct MultiVersionedTarget {
+    // CPU instruction set for which the compiler generates code (see
+    // `InferMultiVersionedTargetMachine`).
+    tsl::port::CPUFeature max_cpu_feature;
+
+    // Compilation hooks for intercepting compiled object files.
+    IrCompiler::CompilationHooks ir_compiler_hooks;
+  };
+
   struct Options {
     // Options for the underlying IR compiler instance.
     IrCompiler::Options ir_compiler_options;
@@ -102,6 +124,14 @@ class JitCompiler {
     // If instruction set is empty, compiler will generate code for all ISA
     // extensions detected on the current machine.
     std::optional<tsl::port::CPUFeature> max_cpu_feature;
+
+    // Additional targets for multi-versioned compilation. All added LLVM
+    // modules are also compiled for every target, and the resulting object
+    // files are passed to the target's compilation hooks. They are not linked
+    // into the compiled function library, and are meant to be exported
+    // together with it, so that the best variant can be loaded on a different
+    // host (see `SelectNewestSupportedCpuFeature`).
+    std::vector<MultiVersionedTarget> multi_versioned_targets;
   };
 
   // Creates a new instance of the JitCompiler.
@@ -154,12 +184,25 @@ class JitCompiler {
     size_t num_dispatched_tasks_ ABSL_GUARDED_BY(mu_) = 0;
   };
 
+  // Compilation status of multi-versioned targets, updated concurrently by
+  // compilation tasks.
+  struct MultiVersionedStatus {
+    absl::Mutex mu;
+    absl::Status status ABSL_GUARDED_BY(mu);
+  };
+
   JitCompiler(IrCompiler::TargetMachineBuilder target_machine_builder,
               std::shared_ptr<llvm::TargetMachine> target_machine,
               TaskDispatcher* task_dispatcher,
               std::unique_ptr<llvm::orc::ExecutionSession> execution_session,
               std::unique_ptr<IrCompiler> ir_compiler, size_t num_dylibs,
-              ExecutionEngine::DefinitionGenerator definition_generator);
+              ExecutionEngine::DefinitionGenerator definition_generator,
+              std::vector<std::unique_ptr<IrCompiler>>
+                  multi_versioned_compilers);
+
+  // Compiles a copy of the `module` for all multi-versioned targets using the
+  // task dispatcher.
+  void AddMultiVersionedModule(const llvm::Module& module);
 
   // Target machine builder that is used to construct target machines for this
   // instance of `JitCompiler` (when compiling LLVM modules in parallel).
@@ -170,6 +213,10 @@ class JitCompiler {
 
   std::unique_ptr<ExecutionEngine> execution_engine_;
   std::unique_ptr<llvm::orc::IRCompileLayer> compile_layer_;
+
+  // IR compilers for multi-versioned targets.
+  std::vector<std::unique_ptr<IrCompiler>> multi_versioned_compilers_;
+  std::unique_ptr<MultiVersionedStatus> multi_versioned_status_;
 };
 
 }  // namespace xla::cpu
@@ -25,6 +25,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "llvm/AsmParser/Parser.h"
@@ -37,13 +38,18 @@ limitations under the License.
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
+#include "xla/backends/cpu/codegen/ir_compiler.h"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/util.h"
+#include "tsl/platform/cpu_info.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
@@ -153,6 +159,151 @@ TEST(JitCompilerTest, Compile) {
   EXPECT_EQ(value, 4.0f);
 }
 
+TEST(JitCompilerTest, MultiVersionedCompile) {
+  if (!tsl::port::IsX86CPU()) {
+    GTEST_SKIP() << "Multi-versioned compilation is tested only on x86";
+  }
+
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::orc::ThreadSafeContext tsc(std::move(context));
+
+  // Collect object files compiled for each multi-versioned target.
+  std::vector<std::string> sse4_obj_files;
+  std::vector<std::string> avx2_obj_files;
+
+  auto collect_obj_files = [](std::vector<std::string>* obj_files) {
+    IrCompiler::CompilationHooks hooks;
+    hooks.post_codegen = [obj_files](const llvm::Module&,
+                                     const llvm::object::ObjectFile& obj_file) {
+      obj_files->push_back(obj_file.getData().str());
+    };
+    return hooks;
+  };
+
+  JitCompiler::Options options;
+  options.multi_versioned_targets = {
+      {tsl::port::CPUFeature::SSE4_2, collect_obj_files(&sse4_obj_files)},
+      {tsl::port::CPUFeature::AVX2, collect_obj_files(&avx2_obj_files)}};
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto compiler,
+      JitCompiler::Create(llvm::TargetOptions(), std::move(options)));
+
+  constexpr absl::string_view add_in_place_ir = R"(
+    define void @AddInplace(ptr %arg) {
+      %v0 = load float, ptr %arg
+      %v1 = fadd float %v0, %v0
+      store float %v1, ptr %arg
+      ret void
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(llvm::orc::ThreadSafeModule tsm,
+                          ParseModule(tsc, add_in_place_ir, "AddInplace"));
+  TF_ASSERT_OK(compiler.AddModule(std::move(tsm)));
+
+  using ScalarFn = void(float*);
+  std::vector<FunctionLibrary::Symbol> symbols = {
+      FunctionLibrary::Sym<ScalarFn>("AddInplace")};
+
+  TF_ASSERT_OK_AND_ASSIGN(auto function_library,
+                          Compile(std::move(compiler), symbols));
+
+  // Module was compiled once for each multi-versioned target.
+  ASSERT_EQ(sse4_obj_files.size(), 1);
+  ASSERT_EQ(avx2_obj_files.size(), 1);
+  EXPECT_FALSE(sse4_obj_files[0].empty());
+  EXPECT_FALSE(avx2_obj_files[0].empty());
+
+  // Host function is compiled and linked as usual.
+  TF_ASSERT_OK_AND_ASSIGN(
+      ScalarFn * add_in_place,
+      function_library->ResolveFunction<ScalarFn>("AddInplace"));
+
+  float value = 1.0f;
+  add_in_place(&value);
+  EXPECT_EQ(value, 2.0f);
+}
+
+TEST(JitCompilerTest, MultiVersionedDestroyWithoutCompile) {
+  if (!tsl::port::IsX86CPU()) {
+    GTEST_SKIP() << "Multi-versioned compilation is tested only on x86";
+  }
+
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::orc::ThreadSafeContext tsc(std::move(context));
+
+  // Object files must be collected before the compiler is destroyed, as the
+  // compilation hook must not run after that.
+  std::vector<std::string> avx2_obj_files;
+
+  // Delay compilation tasks, so that they are still running when the compiler
+  // is destroyed.
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 2);
+  JitCompiler::TaskRunner task_runner = [&](JitCompiler::Task task) {
+    thread_pool.Schedule([task = std::move(task)] {
+      tsl::Env::Default()->SleepForMicroseconds(100 * 1000);
+      task();
+    });
+  };
+
+  {
+    IrCompiler::CompilationHooks hooks;
+    hooks.post_codegen = [&](const llvm::Module&,
+                             const llvm::object::ObjectFile& obj_file) {
+      avx2_obj_files.push_back(obj_file.getData().str());
+    };
+
+    JitCompiler::Options options;
+    options.multi_versioned_targets = {
+        {tsl::port::CPUFeature::AVX2, std::move(hooks)}};
+
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto compiler,
+        JitCompiler::Create(llvm::TargetOptions(), std::move(options),
+                            std::move(task_runner)));
+
+    constexpr absl::string_view add_in_place_ir = R"(
+      define void @AddInplace(ptr %arg) {
+        %v0 = load float, ptr %arg
+        %v1 = fadd float %v0, %v0
+        store float %v1, ptr %arg
+        ret void
+      })";
+
+    TF_ASSERT_OK_AND_ASSIGN(llvm::orc::ThreadSafeModule tsm,
+                            ParseModule(tsc, add_in_place_ir, "AddInplace"));
+    TF_ASSERT_OK(compiler.AddModule(std::move(tsm)));
+
+    // Destroy the compiler without calling `Compile`.
+  }
+
+  // Destructor waited for the multi-versioned compilation task.
+  ASSERT_EQ(avx2_obj_files.size(), 1);
+  EXPECT_FALSE(avx2_obj_files[0].empty());
+}
+
+TEST(JitCompilerTest, MultiVersionedTargetMachineIgnoresHostFeatures) {
+  if (!tsl::port::IsX86CPU()) {
+    GTEST_SKIP() << "Multi-versioned compilation is tested only on x86";
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<llvm::TargetMachine> target_machine,
+      JitCompiler::InferMultiVersionedTargetMachine(
+          llvm::TargetOptions(), llvm::CodeGenOptLevel::Default,
+          tsl::port::CPUFeature::AVX2));
+
+  EXPECT_EQ(target_machine->getTargetCPU(), "haswell");
+
+  // AVX2 object files must not use features that Haswell doesn't have, even
+  // if the compiling host has them.
+  std::vector<std::string> features = absl::StrSplit(
+      target_machine->getTargetFeatureString().str(), ',');
+  EXPECT_THAT(features,
+              ::testing::IsSupersetOf({"+avx2", "+fma", "-avx512f", "-gfni",
+                                       "-vaes", "-vpclmulqdq", "-sha"}));
+}
+
 class ExternalDefinitionGenerator : public llvm::orc::DefinitionGenerator {
  public:
   static void AddInplace(float* value) { *value += *value; }
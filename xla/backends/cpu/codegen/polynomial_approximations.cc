@@ -400,6 +400,136 @@ llvm::Value* GenerateVF32Log(llvm::IRBuilderBase* b, llvm::Value* input,
                                    result_finite_or_nan));
 }
 
+// Generates sin(x) or cos(x) approximation for F32 vectors.
+//
+// This implements the Cephes sinf/cosf polynomials with Cody-Waite range
+// reduction to [-pi/4, pi/4], that is exact for |x| below `kFastPathLimit`.
+// Lanes with larger inputs (and NaNs and infinities) are rare in practice, and
+// we compute them by calling the scalar libm function from a slow path.
+llvm::Value* GenerateVF32SinCos(llvm::IRBuilderBase* b, llvm::Value* input,
+                                int32_t vector_width, bool is_sine) {
+  VectorIrBuilder vb(F32, vector_width, b, is_sine ? "sin_f32" : "cos_f32");
+
+  // For |x| < 8192 the quadrant index is below 2^13, and products of the
+  // quadrant index with the (short) parts of pi/2 below are exact.
+  const llvm::APFloat kFastPathLimit = GetIeeeF32(8192.0);
+
+  const llvm::APFloat half = GetIeeeF32(0.5);
+  const llvm::APFloat one = GetIeeeF32(1.0);
+  const llvm::APFloat minus_half = GetIeeeF32(-0.5);
+  const llvm::APFloat two_over_pi = GetIeeeF32(0.636619772367581343075535);
+  const llvm::APFloat abs_mask = GetIeeeF32FromBitwiseRep(0x7fffffff);
+
+  // -pi/2 split into four floats, such that the sum is exact in F32.
+  const llvm::APFloat minus_pio2_1 = GetIeeeF32(-1.5703125);
+  const llvm::APFloat minus_pio2_2 = GetIeeeF32(-4.83989715576171875e-4);
+  const llvm::APFloat minus_pio2_3 = GetIeeeF32(1.62865035235881805419921875e-7);
+  const llvm::APFloat minus_pio2_4 =
+      GetIeeeF32(5.5644315544167710640977020375430583953857421875e-11);
+
+  const llvm::APFloat cephes_sin_p0 = GetIeeeF32(-1.9515295891E-4);
+  const llvm::APFloat cephes_sin_p1 = GetIeeeF32(8.3321608736E-3);
+  const llvm::APFloat cephes_sin_p2 = GetIeeeF32(-1.6666654611E-1);
+
+  const llvm::APFloat cephes_cos_p0 = GetIeeeF32(2.443315711809948E-5);
+  const llvm::APFloat cephes_cos_p1 = GetIeeeF32(-1.388731625493765E-3);
+  const llvm::APFloat cephes_cos_p2 = GetIeeeF32(4.166664568298827E-2);
+
+  llvm::Type* i32_vector_type =
+      llvm::VectorType::get(b->getInt32Ty(), vector_width, false);
+  auto splat_i32 = [&](int32_t v) {
+    return b->CreateVectorSplat(vector_width, b->getInt32(v));
+  };
+
+  // Unordered compare sends NaNs to the slow path together with large inputs.
+  llvm::Value* x = vb.FloatAnd(input, abs_mask);
+  llvm::Value* is_large = b->CreateFCmpUGE(x, vb.SplatFloat(kFastPathLimit));
+  x = b->CreateSelect(is_large, vb.GetZeroVector(), x);
+
+  // Quadrant index: y = round(x * 2/pi).
+  llvm::Value* y = vb.Floor(vb.MulAdd(x, two_over_pi, half));
+
+  // Reduced argument: r = x - y * pi/2, in [-pi/4, pi/4].
+  llvm::Value* r = vb.Add(x, vb.Mul(minus_pio2_1, y));
+  r = vb.Add(r, vb.Mul(minus_pio2_2, y));
+  r = vb.Add(r, vb.Mul(minus_pio2_3, y));
+  r = vb.Add(r, vb.Mul(minus_pio2_4, y));
+
+  llvm::Value* z = vb.Mul(r, r);
+
+  // sin(r) = r + r * z * P(z)
+  llvm::Value* sin_r = vb.MulAdd(z, cephes_sin_p0, cephes_sin_p1);
+  sin_r = vb.MulAdd(sin_r, z, cephes_sin_p2);
+  sin_r = vb.MulAdd(vb.Mul(sin_r, z), r, r);
+
+  // cos(r) = 1 - z / 2 + z * z * Q(z)
+  llvm::Value* cos_r = vb.MulAdd(z, cephes_cos_p0, cephes_cos_p1);
+  cos_r = vb.MulAdd(cos_r, z, cephes_cos_p2);
+  cos_r = vb.MulAdd(vb.Mul(cos_r, z), z, vb.MulAdd(z, minus_half, one));
+
+  // cos(x) = sin(x + pi/2), so cos shifts the quadrant index by one. Odd
+  // quadrants use the cos(r) polynomial, and quadrants 2 and 3 flip the sign.
+  llvm::Value* quadrant = b->CreateFPToSI(y, i32_vector_type);
+  if (!is_sine) quadrant = b->CreateAdd(quadrant, splat_i32(1));
+
+  llvm::Value* use_cos =
+      b->CreateICmpNE(b->CreateAnd(quadrant, splat_i32(1)), splat_i32(0));
+  llvm::Value* result = b->CreateSelect(use_cos, cos_r, sin_r);
+
+  // Shift the second bit of the quadrant index into the F32 sign bit. Sine is
+  // an odd function, so it also takes the sign of the input.
+  llvm::Value* sign = b->CreateShl(quadrant, splat_i32(30));
+  if (is_sine) {
+    sign = b->CreateXor(sign, b->CreateBitCast(input, i32_vector_type));
+  }
+  sign = b->CreateAnd(sign, splat_i32(0x80000000));
+  llvm::Value* fast_result = b->CreateBitCast(
+      b->CreateXor(b->CreateBitCast(result, i32_vector_type), sign),
+      vb.vector_type());
+
+  // Check if any of the lanes needs the slow path.
+  llvm::Value* any_large = b->CreateOrReduce(is_large);
+
+  llvm::BasicBlock* fast_block = b->GetInsertBlock();
+  llvm::Function* fn = fast_block->getParent();
+  llvm::LLVMContext& context = b->getContext();
+
+  llvm::BasicBlock* slow_block =
+      llvm::BasicBlock::Create(context, "sin_cos.slow", fn);
+  llvm::BasicBlock* done_block =
+      llvm::BasicBlock::Create(context, "sin_cos.done", fn);
+  b->CreateCondBr(any_large, slow_block, done_block);
+
+  // Slow path: call libm for every lane, and keep results for large lanes.
+  b->SetInsertPoint(slow_block);
+  llvm::FunctionCallee libm_fn = fn->getParent()->getOrInsertFunction(
+      is_sine ? "sinf" : "cosf", b->getFloatTy(), b->getFloatTy());
+  llvm::Value* slow_result = fast_result;
+  for (int32_t i = 0; i < vector_width; ++i) {
+    llvm::Value* lane = b->CreateExtractElement(input, i);
+    slow_result =
+        b->CreateInsertElement(slow_result, b->CreateCall(libm_fn, {lane}), i);
+  }
+  slow_result = b->CreateSelect(is_large, slow_result, fast_result);
+  b->CreateBr(done_block);
+
+  b->SetInsertPoint(done_block);
+  llvm::PHINode* phi = b->CreatePHI(vb.vector_type(), 2);
+  phi->addIncoming(fast_result, fast_block);
+  phi->addIncoming(slow_result, slow_block);
+  return phi;
+}
+
+llvm::Value* GenerateVF32Sin(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*is_sine=*/true);
+}
+
+llvm::Value* GenerateVF32Cos(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*is_sine=*/false);
+}
+
 // Generates an IR for computing output value via upcasting to F32:
 //   output = cast<F16>(generator(cast<F32>(input)))
 template <Generator generator>
@@ -532,17 +662,87 @@ std::vector<llvm::VecDesc> LogVectorization() {
   };
 }
 
+//===----------------------------------------------------------------------===//
+// Sin and Cos
+//===----------------------------------------------------------------------===//
+
+static constexpr absl::string_view kSinV4F32Sym = "__xla_cpu_SinV4F32";
+static constexpr absl::string_view kSinV8F32Sym = "__xla_cpu_SinV8F32";
+static constexpr absl::string_view kSinV16F32Sym = "__xla_cpu_SinV16F32";
+
+static constexpr absl::string_view kSinV8F16Sym = "__xla_cpu_SinV8F16";
+static constexpr absl::string_view kSinV16F16Sym = "__xla_cpu_SinV16F16";
+
+static constexpr absl::string_view kCosV4F32Sym = "__xla_cpu_CosV4F32";
+static constexpr absl::string_view kCosV8F32Sym = "__xla_cpu_CosV8F32";
+static constexpr absl::string_view kCosV16F32Sym = "__xla_cpu_CosV16F32";
+
+static constexpr absl::string_view kCosV8F16Sym = "__xla_cpu_CosV8F16";
+static constexpr absl::string_view kCosV16F16Sym = "__xla_cpu_CosV16F16";
+
+std::vector<llvm::VecDesc> SinVectorization() {
+  return {
+      {"sinf", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+      {"llvm.sin.f32", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+
+      {"sinf", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.sin.f32", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"sinf", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.sin.f32", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+
+      {"llvm.sin.f16", kSinV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.sin.f16", kSinV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+  };
+}
+
+std::vector<llvm::VecDesc> CosVectorization() {
+  return {
+      {"cosf", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+      {"llvm.cos.f32", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+
+      {"cosf", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.cos.f32", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"cosf", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.cos.f32", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+
+      {"llvm.cos.f16", kCosV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.cos.f16", kCosV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+  };
+}
+
 }  // namespace
 
 std::vector<llvm::VecDesc> PolynomialApproximationsVectorization() {
   auto exp = ExpVectorization();
   auto log = LogVectorization();
   auto tanh = TanhVectorization();
+  auto sin = SinVectorization();
+  auto cos = CosVectorization();
 
   std::vector<llvm::VecDesc> vec_descs;
   vec_descs.insert(vec_descs.end(), exp.begin(), exp.end());
   vec_descs.insert(vec_descs.end(), log.begin(), log.end());
   vec_descs.insert(vec_descs.end(), tanh.begin(), tanh.end());
+  vec_descs.insert(vec_descs.end(), sin.begin(), sin.end());
+  vec_descs.insert(vec_descs.end(), cos.begin(), cos.end());
   return vec_descs;
 }
 
@@ -606,6 +806,37 @@ void RewriteToPolynomialApproximations(llvm::Module* module,
                 /*vector_width=*/8);
   rewrite_calls(kLogV16F16Sym, UpcastF16ToF32<GenerateVF32Log>,
                 /*vector_width=*/16);
+
+  //===----------------------------------------------------------------===//
+  // Sin and Cos
+  //===----------------------------------------------------------------===//
+
+  // We do not rewrite scalar `sinf` and `cosf` calls, as the slow path of the
+  // approximation calls them for inputs outside of the fast path range.
+
+  rewrite_calls("llvm.sin.f32", GenerateVF32Sin, /*vector_width=*/1);
+  rewrite_calls(kSinV4F32Sym, GenerateVF32Sin, /*vector_width=*/4);
+  rewrite_calls(kSinV8F32Sym, GenerateVF32Sin, /*vector_width=*/8);
+  rewrite_calls(kSinV16F32Sym, GenerateVF32Sin, /*vector_width=*/16);
+
+  rewrite_calls("llvm.sin.f16", UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/1);
+  rewrite_calls(kSinV8F16Sym, UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/8);
+  rewrite_calls(kSinV16F16Sym, UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/16);
+
+  rewrite_calls("llvm.cos.f32", GenerateVF32Cos, /*vector_width=*/1);
+  rewrite_calls(kCosV4F32Sym, GenerateVF32Cos, /*vector_width=*/4);
+  rewrite_calls(kCosV8F32Sym, GenerateVF32Cos, /*vector_width=*/8);
+  rewrite_calls(kCosV16F32Sym, GenerateVF32Cos, /*vector_width=*/16);
+
+  rewrite_calls("llvm.cos.f16", UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/1);
+  rewrite_calls(kCosV8F16Sym, UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/8);
+  rewrite_calls(kCosV16F16Sym, UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/16);
 }
 
 }  // namespace xla::cpu
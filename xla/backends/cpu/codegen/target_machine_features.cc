@@ -17,10 +17,12 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <string>
 
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/Function.h"
+#include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Target/TargetMachine.h"
 #include "xla/backends/cpu/alignment.h"
@@ -91,4 +93,28 @@ std::string TargetMachineFeatures::get_target_feature_string() const {
   return target_machine_->getTargetFeatureString().str();
 }
 
+// Returns the size of the cache at the given level (0 is L1) as reported by the
+// target machine, or `default_size` if it's unknown.
+static int64_t GetCacheSize(const llvm::TargetMachine* target_machine,
+                            unsigned level, int64_t default_size) {
+  if (target_machine == nullptr ||
+      target_machine->getMCSubtargetInfo() == nullptr) {
+    return default_size;
+  }
+  std::optional<unsigned> cache_size =
+      target_machine->getMCSubtargetInfo()->getCacheSize(level);
+  return cache_size.has_value() && *cache_size > 0 ? *cache_size
+                                                   : default_size;
+}
+
+int64_t TargetMachineFeatures::l1_cache_size_in_bytes() const {
+  return GetCacheSize(target_machine_, /*level=*/0,
+                      kDefaultL1CacheSizeInBytes);
+}
+
+int64_t TargetMachineFeatures::l2_cache_size_in_bytes() const {
+  return GetCacheSize(target_machine_, /*level=*/1,
+                      kDefaultL2CacheSizeInBytes);
+}
+
 }  // namespace xla::cpu
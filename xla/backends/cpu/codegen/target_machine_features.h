@@ -35,6 +35,10 @@ class TargetMachineFeatures {
   // want to call an Eigen backed GEMM or Convolution.
   static constexpr int32_t kEigenExpectedTensorAlignment = 16;
 
+  // Cache sizes that we assume if the target machine doesn't report them.
+  static constexpr int64_t kDefaultL1CacheSizeInBytes = 32 * 1024;
+  static constexpr int64_t kDefaultL2CacheSizeInBytes = 1024 * 1024;
+
   explicit TargetMachineFeatures(llvm::TargetMachine* target_machine);
   virtual ~TargetMachineFeatures() = default;
 
@@ -69,6 +73,11 @@ class TargetMachineFeatures {
 
   virtual std::string get_target_feature_string() const;
 
+  // Return the size of the L1 data cache and the L2 cache in bytes. Falls back
+  // to default cache sizes if the target machine doesn't report them.
+  virtual int64_t l1_cache_size_in_bytes() const;
+  virtual int64_t l2_cache_size_in_bytes() const;
+
  private:
   llvm::TargetTransformInfo* GetTargetTransformInfoFor(
       const llvm::Function& fn) const;
@@ -71,22 +71,42 @@ CopyThunk::CopyThunk(Info info, BufferAllocation::Slice src_buffer,
       dst_buffer_(dst_buffer),
       dst_shape_(dst_shape),
       parallel_block_params_(ComputeParallelBlockParams(src_shape_)) {
-  if (src_shape_ != dst_shape_) {
-    TransposePlan::Options options;
-    options.elem_size_in_bytes =
-        ShapeUtil::ByteSizeOfPrimitiveType(src_shape_.element_type());
-    options.dims = src_shape_.dimensions();
+  if (src_shape_.layout().minor_to_major() !=
+      dst_shape_.layout().minor_to_major()) {
+    transpose_block_params_ =
+        ComputeTransposeBlockParams(src_shape_, dst_shape_);
+    transpose_plan_ = CreateTransposePlan(transpose_block_params_.block_size);
+
+    int64_t dim_size = src_shape_.dimensions(transpose_block_params_.dim);
+    int64_t tail_size =
+        dim_size - (transpose_block_params_.block_count - 1) *
+                       transpose_block_params_.block_size;
+    if (tail_size != transpose_block_params_.block_size) {
+      transpose_tail_plan_ = CreateTransposePlan(tail_size);
+    }
+  }
+}
 
-    auto byte_strides = ShapeUtil::ByteStrides(src_shape_);
-    options.input_layout = TransposePlan::Striding{*byte_strides};
+std::unique_ptr<TransposePlan> CopyThunk::CreateTransposePlan(
+    int64_t block_size) const {
+  TransposePlan::Options options;
+  options.elem_size_in_bytes =
+      ShapeUtil::ByteSizeOfPrimitiveType(src_shape_.element_type());
 
-    absl::InlinedVector<int64_t, 4> permutation(options.dims.size());
-    absl::c_reverse_copy(dst_shape_.layout().minor_to_major(),
-                         permutation.begin());
-    options.permutation = permutation;
+  absl::InlinedVector<int64_t, 4> dims(src_shape_.dimensions().begin(),
+                                       src_shape_.dimensions().end());
+  dims[transpose_block_params_.dim] = block_size;
+  options.dims = dims;
 
-    transpose_plan_ = TransposePlan::Create(options).value();
-  }
+  auto byte_strides = ShapeUtil::ByteStrides(src_shape_);
+  options.input_layout = TransposePlan::Striding{*byte_strides};
+
+  absl::InlinedVector<int64_t, 4> permutation(options.dims.size());
+  absl::c_reverse_copy(dst_shape_.layout().minor_to_major(),
+                       permutation.begin());
+  options.permutation = permutation;
+
+  return TransposePlan::Create(options).value();
 }
 
 static std::tuple<void*, void*, int64_t> GetBlockCopyParameters(
@@ -106,14 +126,15 @@ static std::tuple<void*, void*, int64_t> GetBlockCopyParameters(
   return {dst + offset, src + offset, size};
 }
 
+// Do not run more than 8 parallel copy blocks at a time.
+static constexpr int64_t kMaxParallelCopyBlocks = 8;
+
 CopyThunk::ParallelBlockParams CopyThunk::ComputeParallelBlockParams(
     const Shape& shape) {
   // Prefer single-threaded memcpy for small copies.
   static constexpr int64_t kMinParallelCopySize = 1024 * 1024;
   // Make block size a multiple of 1024 to match AVX2/AVX512 vector sizes.
   static constexpr int64_t kBlockSizeAlign = 1024;
-  // Do not run more than 8 parallel copy blocks at a time.
-  static constexpr int64_t kMaxParallelCopyBlocks = 8;
 
   int64_t size_in_bytes = ShapeUtil::ByteSizeOf(shape);
   if (size_in_bytes == 0) {
@@ -132,6 +153,82 @@ CopyThunk::ParallelBlockParams CopyThunk::ComputeParallelBlockParams(
                              CeilOfRatio(size_in_bytes, block_size)};
 }
 
+CopyThunk::TransposeBlockParams CopyThunk::ComputeTransposeBlockParams(
+    const Shape& src_shape, const Shape& dst_shape) {
+  // Transposes are bound by strided memory accesses and not by the memory
+  // bandwidth, and it pays off to run them in parallel for smaller sizes.
+  static constexpr int64_t kMinParallelTransposeSize = 256 * 1024;
+
+  // Split the most major destination dimension, as it corresponds to the
+  // contiguous blocks of the destination buffer.
+  int64_t dim = dst_shape.layout().minor_to_major().back();
+  int64_t dim_size = src_shape.dimensions(dim);
+
+  int64_t src_stride = (*ShapeUtil::ByteStrides(src_shape))[dim];
+  int64_t dst_stride = (*ShapeUtil::ByteStrides(dst_shape))[dim];
+
+  int64_t size_in_bytes = ShapeUtil::ByteSizeOf(src_shape);
+  int64_t num_blocks =
+      std::min({kMaxParallelCopyBlocks, dim_size,
+                CeilOfRatio(size_in_bytes, kMinParallelTransposeSize)});
+
+  if (num_blocks <= 1) {
+    return TransposeBlockParams{dim, dim_size, 1, src_stride, dst_stride};
+  }
+
+  int64_t block_size = CeilOfRatio(dim_size, num_blocks);
+  return TransposeBlockParams{dim, block_size,
+                              CeilOfRatio(dim_size, block_size), src_stride,
+                              dst_stride};
+}
+
+void CopyThunk::TransposeBlock(int64_t block_index,
+                               se::DeviceMemoryBase destination,
+                               se::DeviceMemoryBase source) const {
+  const TransposeBlockParams& params = transpose_block_params_;
+  CHECK_LT(block_index, params.block_count);
+
+  int64_t offset = block_index * params.block_size;
+  const std::byte* src = reinterpret_cast<const std::byte*>(source.opaque()) +
+                         offset * params.src_stride_in_bytes;
+  std::byte* dst = reinterpret_cast<std::byte*>(destination.opaque()) +
+                   offset * params.dst_stride_in_bytes;
+
+  bool is_tail = transpose_tail_plan_ && block_index == params.block_count - 1;
+  const TransposePlan& plan =
+      is_tail ? *transpose_tail_plan_ : *transpose_plan_;
+  plan.Execute(src, dst, [](std::function<void()> fn) { fn(); });
+}
+
+// Runs `fn` for all blocks in [0, block_count) in the intra-op thread pool, and
+// returns an event that becomes available when all blocks are completed.
+template <typename Fn>
+static tsl::AsyncValueRef<Thunk::ExecuteEvent> ExecuteBlocksInParallel(
+    const Thunk::ExecuteParams& params, int64_t block_count, Fn fn) {
+  auto event = tsl::MakeConstructedAsyncValueRef<Thunk::ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(block_count);
+
+  // Executes copy operation for a single block.
+  auto execute = [event, counter, fn](int64_t block_index) {
+    fn(block_index);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel copy operations in the intra-op thread pool.
+  for (int64_t i = 1; i < block_count; ++i) {
+    params.intra_op_threadpool->getPool()->Schedule(
+        [i, execute] { execute(i); });
+  }
+
+  // Execute the first copy task in the caller thread.
+  execute(0);
+
+  return event;
+}
+
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CopyThunk::Execute(
     const ExecuteParams& params) {
 
@@ -165,11 +262,21 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CopyThunk::Execute(
     return OkExecuteEvent();
   }
 
-  // Use prepared transpose plan to copy data if copy requires changing layout.
+  // Use prepared transpose plans to copy data if copy requires changing layout.
   if (ABSL_PREDICT_FALSE(transpose_plan_)) {
-    transpose_plan_->Execute(src_data.opaque(), dst_data.opaque(),
-                             [](std::function<void()> fn) { fn(); });
-    return OkExecuteEvent();
+    if (params.intra_op_threadpool == nullptr ||
+        transpose_block_params_.block_count == 1) {
+      for (int64_t i = 0; i < transpose_block_params_.block_count; ++i) {
+        TransposeBlock(i, dst_data, src_data);
+      }
+      return OkExecuteEvent();
+    }
+
+    return ExecuteBlocksInParallel(
+        params, transpose_block_params_.block_count,
+        [this, dst_data, src_data](int64_t block_index) {
+          TransposeBlock(block_index, dst_data, src_data);
+        });
   }
 
   // For a single block, use std::memcpy to copy data from source to
@@ -182,33 +289,13 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CopyThunk::Execute(
   }
 
   // Use intra-op thread pool to run copy operation in parallel.
-  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
-  auto counter = std::make_shared<std::atomic<int64_t>>(
-      parallel_block_params_.block_count);
-
-  // Executes copy operation for a single block.
-  auto execute = [this, event, counter, dst_data,
-                  src_data](int64_t block_index) {
-    auto [dst, src, size] = GetBlockCopyParameters(
-        parallel_block_params_, block_index, dst_data, src_data);
-
-    std::memcpy(dst, src, size);
-
-    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
-      event.SetStateConcrete();
-    }
-  };
-
-  // Launch parallel copy operations in the intra-op thread pool.
-  for (int64_t i = 1; i < parallel_block_params_.block_count; ++i) {
-    params.intra_op_threadpool->getPool()->Schedule(
-        [i, execute] { execute(i); });
-  }
-
-  // Execute the first memory copy task in the caller thread.
-  execute(0);
-
-  return event;
+  return ExecuteBlocksInParallel(
+      params, parallel_block_params_.block_count,
+      [this, dst_data, src_data](int64_t block_index) {
+        auto [dst, src, size] = GetBlockCopyParameters(
+            parallel_block_params_, block_index, dst_data, src_data);
+        std::memcpy(dst, src, size);
+      });
 }
 
 }  // namespace xla::cpu
@@ -24,6 +24,7 @@ limitations under the License.
 #include "xla/pjrt/transpose.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/shape.h"
+#include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 
 namespace xla::cpu {
@@ -39,6 +40,17 @@ class CopyThunk final : public Thunk {
     int64_t block_count;
   };
 
+  // Parameters for running a transpose operation in parallel. We split the
+  // most major dimension of the destination into blocks, so that every block
+  // writes into a contiguous part of the destination buffer.
+  struct TransposeBlockParams {
+    int64_t dim;  // split dimension
+    int64_t block_size;
+    int64_t block_count;
+    int64_t src_stride_in_bytes;
+    int64_t dst_stride_in_bytes;
+  };
+
   static absl::StatusOr<std::unique_ptr<CopyThunk>> Create(
       Info info, BufferAllocation::Slice src_buffer, const Shape& src_shape,
       BufferAllocation::Slice dst_buffer, const Shape& dst_shape);
@@ -62,6 +74,17 @@ class CopyThunk final : public Thunk {
 
   static ParallelBlockParams ComputeParallelBlockParams(const Shape& shape);
 
+  static TransposeBlockParams ComputeTransposeBlockParams(
+      const Shape& src_shape, const Shape& dst_shape);
+
+  // Creates a transpose plan for a block of `block_size` elements of the split
+  // dimension.
+  std::unique_ptr<TransposePlan> CreateTransposePlan(int64_t block_size) const;
+
+  // Transposes `block_index` block of the source buffer into the destination.
+  void TransposeBlock(int64_t block_index, se::DeviceMemoryBase destination,
+                      se::DeviceMemoryBase source) const;
+
   BufferAllocation::Slice src_buffer_;
   Shape src_shape_;
 
@@ -69,7 +92,12 @@ class CopyThunk final : public Thunk {
   Shape dst_shape_;
 
   ParallelBlockParams parallel_block_params_;
-  std::unique_ptr<TransposePlan> transpose_plan_;  // optional
+
+  // Transpose plans for copies that change the layout: one for full blocks and
+  // one for the last block if it is smaller than the others.
+  TransposeBlockParams transpose_block_params_ = {};
+  std::unique_ptr<TransposePlan> transpose_plan_;       // optional
+  std::unique_ptr<TransposePlan> transpose_tail_plan_;  // optional
 };
 
 }  // namespace xla::cpu
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/copy_thunk.h"
 
+#include <cstdint>
+
+#include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk_testlib.h"
@@ -24,10 +27,15 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
 namespace xla::cpu {
 namespace {
 
@@ -105,6 +113,44 @@ TEST(CopyThunkTest, CopyTransposed) {
   EXPECT_EQ(dst, LiteralUtil::CreateR2<float>({{1.0, 3.0}, {2.0, 4.0}}));
 }
 
+TEST(CopyThunkTest, CopyTransposedInParallel) {
+  // Source buffer has [1000, 301] row-major layout, that we read as a
+  // column-major [301, 1000] array.
+  auto src = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      ShapeUtil::MakeShape(F32, {1000, 301}),
+      [](absl::Span<const int64_t> idx) { return idx[0] * 301 + idx[1]; });
+  auto dst = LiteralUtil::CreateFull<float>({301, 1000}, 0.0f);
+
+  BufferAllocations allocations = CreateBufferAllocations(src, dst);
+
+  auto [src_alloc, dst_alloc] = CreateBufferAllocation(src, dst);
+  auto [src_slice, dst_slice] =
+      CreateBufferAllocationSlice(src_alloc, dst_alloc);
+
+  Shape transposed_shape = dst.shape();
+  *transposed_shape.mutable_layout() = LayoutUtil::MakeLayout({0, 1});
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, CopyThunk::Create({"copy"}, src_slice, transposed_shape,
+                                    dst_slice, dst.shape()));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  auto expected = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      dst.shape(),
+      [](absl::Span<const int64_t> idx) { return idx[1] * 301 + idx[0]; });
+  EXPECT_EQ(dst, expected);
+}
+
 TEST(CopyThunkTest, CopyTransposedEmptyShape) {
   auto src = LiteralUtil::CreateR2<float>({{1.0, 2.0}, {3.0, 4.0}});
   auto dst = LiteralUtil::CreateR2<float>({{0.0, 0.0}, {0.0, 0.0}});
@@ -38,6 +38,7 @@ limitations under the License.
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/MLIRContext.h"
 #include "mlir/Support/LLVM.h"
+#include "xla/backends/cpu/runtime/object_pool.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/ffi/api/c_api.h"
 #include "xla/ffi/attribute_map.h"
@@ -85,19 +86,11 @@ absl::StatusOr<AttributesMap> ParseAttributes(
 
 // Call `instantiate` callback if passed. This function needs its own copy of
 // attributes, that's what AttributesBuilder expects, there's no way around it.
-absl::Status InstantiateHandlerState(absl::string_view target_name,
+absl::Status InstantiateHandlerState(const ffi::HandlerRegistration& handler,
                                      ffi::ExecutionState* execution_state,
                                      AttributesMap attributes) {
-  // Find the registered FFI handler for this target.
-  auto handler = ffi::FindHandler(target_name, "Host");
-  if (!handler.ok()) {
-    return NotFound(
-        "No registered implementation for FFI custom call to %s for Host",
-        target_name);
-  }
-
   // Initialize FFI handler state if it has an instantiate callback.
-  if (handler->bundle.instantiate) {
+  if (handler.bundle.instantiate) {
     // At FFI handler instantiation time, we don't have any arguments or results
     ffi::CallFrameBuilder builder(/*num_args=*/0, /*num_rets=*/0);
 
@@ -109,7 +102,7 @@ absl::Status InstantiateHandlerState(absl::string_view target_name,
 
     ffi::CallOptions options;
     options.execution_state = execution_state;
-    TF_RETURN_IF_ERROR(Call(handler->bundle.instantiate, instantiate_call_frame,
+    TF_RETURN_IF_ERROR(Call(handler.bundle.instantiate, instantiate_call_frame,
                             options, XLA_FFI_ExecutionStage_INSTANTIATE));
   }
 
@@ -178,15 +171,25 @@ absl::StatusOr<ffi::CallFrame> BuildCallFrameForTypedFFI(
 absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
     Info info, absl::string_view target_name, OpBuffers op_buffers,
     absl::string_view backend_config, CustomCallApiVersion api_version) {
+  std::optional<ffi::HandlerRegistration> handler;
   std::optional<ffi::CallFrame> call_frame;
   auto execution_state = std::make_unique<ffi::ExecutionState>();
 
   if (api_version == CustomCallApiVersion::API_VERSION_TYPED_FFI) {
+    // Find the registered FFI handler for this target.
+    auto registration = ffi::FindHandler(target_name, "Host");
+    if (!registration.ok()) {
+      return NotFound(
+          "No registered implementation for FFI custom call to %s for Host",
+          target_name);
+    }
+    handler = *registration;
+
     TF_ASSIGN_OR_RETURN(AttributesMap attributes,
                         ParseAttributes(backend_config));
 
-    TF_RETURN_IF_ERROR(InstantiateHandlerState(
-        target_name, execution_state.get(), attributes));
+    TF_RETURN_IF_ERROR(
+        InstantiateHandlerState(*handler, execution_state.get(), attributes));
 
     TF_ASSIGN_OR_RETURN(call_frame, BuildCallFrameForTypedFFI(
                                         api_version, op_buffers, backend_config,
@@ -196,12 +199,14 @@ absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
   return absl::WrapUnique(
       new CustomCallThunk(std::move(info), target_name, std::move(op_buffers),
                           api_version, std::move(backend_config),
-                          std::move(call_frame), std::move(execution_state)));
+                          std::move(handler), std::move(call_frame),
+                          std::move(execution_state)));
 }
 
 CustomCallThunk::CustomCallThunk(
     Info info, absl::string_view target_name, OpBuffers op_buffers,
     CustomCallApiVersion api_version, absl::string_view backend_config,
+    std::optional<ffi::HandlerRegistration> handler,
     std::optional<ffi::CallFrame> call_frame,
     std::unique_ptr<ffi::ExecutionState> execution_state)
     : Thunk(Kind::kCustomCall, std::move(info)),
@@ -209,7 +214,11 @@ CustomCallThunk::CustomCallThunk(
       op_buffers_(std::move(op_buffers)),
       api_version_(api_version),
       backend_config_(std::move(backend_config)),
+      handler_(std::move(handler)),
       call_frame_(std::move(call_frame)),
+      call_frames_([this]() -> absl::StatusOr<ffi::CallFrame> {
+        return call_frame_->Copy();
+      }),
       execution_state_(std::move(execution_state)) {}
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::Execute(
@@ -225,14 +234,6 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::Execute(
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallTypedFFI(
     const ExecuteParams& params) {
-
-  // Find the registered FFI handler for this target.
-  auto handler = ffi::FindHandler(target_name_, "Host");
-  if (!handler.ok()) {
-    return NotFound(
-        "No registered implementation for FFI custom call to %s for Host",
-        target_name_);
-  }
   if (params.custom_call_params == nullptr) {
     return Internal("CustomCallExecuteParams cannot be nullptr.");
   }
@@ -265,9 +266,11 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallTypedFFI(
                                   slice.ToString(), results[i].opaque());
   }
 
-  // Update the FFI call frame with the actual device memory addresses.
-  TF_ASSIGN_OR_RETURN(ffi::CallFrame call_frame,
-                      call_frame_->CopyWithBuffers(arguments, results));
+  // Borrow a call frame from the pool and update it in place with the actual
+  // device memory addresses. Call frame is returned to the pool when the
+  // handler returns, as asynchronous handlers do not access it afterwards.
+  TF_ASSIGN_OR_RETURN(auto call_frame, call_frames_.GetOrCreate());
+  TF_RETURN_IF_ERROR(call_frame->UpdateWithBuffers(arguments, results));
 
   // Forward ExecutableRunOptions to the FFI handlers via the call options.
   CustomCallExecuteParams* custom_call_params = params.custom_call_params;
@@ -279,7 +282,7 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallTypedFFI(
       custom_call_params->ffi_execution_context,
       execution_state_.get()};
 
-  return ffi::CallAsync(handler->bundle.execute, call_frame, call_options);
+  return ffi::CallAsync(handler_->bundle.execute, *call_frame, call_options);
 }
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallUntypedAPI(
@@ -25,9 +25,11 @@ limitations under the License.
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/backends/cpu/runtime/object_pool.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/ffi/call_frame.h"
 #include "xla/ffi/execution_state.h"
+#include "xla/ffi/ffi_api.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/custom_call_status.h"
 #include "xla/shape.h"
@@ -65,6 +67,7 @@ class CustomCallThunk final : public Thunk {
   CustomCallThunk(Info info, absl::string_view target_name,
                   OpBuffers op_buffers, CustomCallApiVersion api_version,
                   absl::string_view backend_config,
+                  std::optional<ffi::HandlerRegistration> handler,
                   std::optional<ffi::CallFrame> call_frame,
                   std::unique_ptr<ffi::ExecutionState> execution_state);
 
@@ -82,8 +85,19 @@ class CustomCallThunk final : public Thunk {
   OpBuffers op_buffers_;
   CustomCallApiVersion api_version_;
   std::string backend_config_;
+
+  // FFI handler for typed-FFI custom calls, resolved once at construction.
+  std::optional<ffi::HandlerRegistration> handler_;
+
+  // Prototype call frame with all attributes and buffer types and dimensions
+  // known at compile time. Pointers to device memory are filled at run time.
   std::optional<ffi::CallFrame> call_frame_;
 
+  // A pool of call frame copies that are updated in place with device memory
+  // pointers. Concurrent executions of the same thunk borrow different call
+  // frames, and in steady state a custom call does not allocate.
+  ObjectPool<ffi::CallFrame> call_frames_;
+
   // Execution state bound to the FFI handler. Optional.
   std::unique_ptr<ffi::ExecutionState> execution_state_;
 };
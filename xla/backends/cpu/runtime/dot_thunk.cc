@@ -15,9 +15,12 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 
+#include <algorithm>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -26,6 +29,7 @@ limitations under the License.
 #include "absl/strings/str_join.h"
 #include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_queue.h"
 #include "xla/primitive_util.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
@@ -39,6 +43,35 @@ limitations under the License.
 
 namespace xla::cpu {
 
+// Batched dot operations with per-matrix size (m * n * k) not larger than this
+// threshold run as single-threaded matmuls over (batch, N) tiles distributed
+// across the intra-op thread pool. Larger matmuls are parallelized by Eigen.
+static constexpr int64_t kMaxTiledMatMulSize = 128 * 128 * 128;
+
+// Minimum number of output columns in a tile, to keep Eigen GEBP kernels busy.
+static constexpr int64_t kMinTileN = 16;
+
+std::optional<DotThunk::BatchTiling> DotThunk::GetBatchTiling(
+    const Eigen::ThreadPoolDevice* device, int64_t batch_size, int64_t m,
+    int64_t n, int64_t k, bool transpose_rhs) {
+  if (device == nullptr || device->numThreads() <= 1 || batch_size <= 1 ||
+      n == 0 || m * n * k > kMaxTiledMatMulSize) {
+    return std::nullopt;
+  }
+
+  // Split the N dimension only if there are not enough batch elements to keep
+  // all threads busy. Tiles of a transposed RHS are not contiguous in memory.
+  int64_t num_n_tiles = 1;
+  int64_t num_threads = device->numThreads();
+  if (batch_size < num_threads && !transpose_rhs) {
+    num_n_tiles = std::min(CeilOfRatio(num_threads, batch_size),
+                           CeilOfRatio(n, kMinTileN));
+  }
+
+  int64_t n_tile_size = CeilOfRatio(n, num_n_tiles);
+  return BatchTiling{batch_size, n_tile_size, CeilOfRatio(n, n_tile_size)};
+}
+
 absl::StatusOr<std::unique_ptr<DotThunk>> DotThunk::Create(
     Info info, DotDimensionNumbers dot_dimensions,
     BufferAllocation::Slice lhs_buffer, Shape lhs_shape,
@@ -149,54 +182,117 @@ tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::Execute(
   }
 
   PrimitiveType element_type = dot_shape_.lhs_matmul_shape.element_type();
+  PrimitiveType out_element_type = dot_shape_.out_matmul_shape.element_type();
+
+  if (dot_shape_.rhs_matmul_shape.element_type() != element_type) {
+    return Unimplemented(
+        "Mismatched operand element types for DotThunk::Execute: %s and %s",
+        primitive_util::LowercasePrimitiveTypeName(element_type),
+        primitive_util::LowercasePrimitiveTypeName(
+            dot_shape_.rhs_matmul_shape.element_type()));
+  }
+
   int64_t byte_width = primitive_util::ByteWidth(element_type);
+  int64_t out_byte_width = primitive_util::ByteWidth(out_element_type);
 
   int64_t lhs_stride = m * k * byte_width;
   int64_t rhs_stride = k * n * byte_width;
-  int64_t out_stride = m * n * byte_width;
+  int64_t out_stride = m * n * out_byte_width;
 
   auto batch_ptr = [&](void* ptr, int64_t stride, int64_t index) -> void* {
     return static_cast<uint8_t*>(ptr) + stride * index;
   };
 
-  tsl::CountDownAsyncValueRef<ExecuteEvent> state(dot_shape_.batch_size);
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+  std::optional<BatchTiling> tiling = GetBatchTiling(
+      device, dot_shape_.batch_size, m, n, k, transpose_rhs);
+
+  auto dispatch = [&](auto type_tag,
+                      auto out_type_tag) -> tsl::AsyncValueRef<ExecuteEvent> {
+    using T = decltype(type_tag);
+    using OutT = decltype(out_type_tag);
+
+    // Run single-threaded matmuls for (batch, N) tiles in parallel.
+    if (tiling.has_value()) {
+      int64_t num_workers = std::min<int64_t>(tiling->num_tasks(),
+                                              device->numThreads());
+      return Worker::Parallelize(
+          device, num_workers, tiling->num_tasks(),
+          [=, tiling = *tiling](size_t task_index) {
+            int64_t batch_index = task_index / tiling.num_n_tiles;
+            int64_t n_start =
+                (task_index % tiling.num_n_tiles) * tiling.n_tile_size;
+            int64_t n_size = std::min(tiling.n_tile_size, n - n_start);
+
+            // Output and non-transposed RHS are column-major, so a tile of N
+            // columns is a contiguous slice of both buffers.
+            void* out_tile = static_cast<uint8_t*>(batch_ptr(
+                                 out, out_stride, batch_index)) +
+                             n_start * m * out_byte_width;
+            void* rhs_tile = static_cast<uint8_t*>(batch_ptr(
+                                 rhs, rhs_stride, batch_index)) +
+                             n_start * k * byte_width;
+
+            TypedMatMul<T, OutT>(
+                /*device=*/nullptr, out_tile,
+                batch_ptr(lhs, lhs_stride, batch_index), rhs_tile, m, n_size,
+                k, transpose_lhs, transpose_rhs, [] {});
+          });
+    }
 
-  auto dispatch = [&](auto type_tag) {
+    tsl::CountDownAsyncValueRef<ExecuteEvent> state(dot_shape_.batch_size);
     for (int64_t i = 0; i < dot_shape_.batch_size; ++i) {
-      TypedMatMul<decltype(type_tag)>(
-          params.intra_op_threadpool, batch_ptr(out, out_stride, i),
-          batch_ptr(lhs, lhs_stride, i), batch_ptr(rhs, rhs_stride, i), m, n, k,
-          transpose_lhs, transpose_rhs,
-          [state]() mutable { state.CountDown(); });
+      TypedMatMul<T, OutT>(device, batch_ptr(out, out_stride, i),
+                           batch_ptr(lhs, lhs_stride, i),
+                           batch_ptr(rhs, rhs_stride, i), m, n, k,
+                           transpose_lhs, transpose_rhs,
+                           [state]() mutable { state.CountDown(); });
     }
+    return state.AsRef();
+  };
+
+  auto unsupported = [&] {
+    return Unimplemented(
+        "Unsupported element types for DotThunk::Execute: %s x %s -> %s",
+        primitive_util::LowercasePrimitiveTypeName(element_type),
+        primitive_util::LowercasePrimitiveTypeName(element_type),
+        primitive_util::LowercasePrimitiveTypeName(out_element_type));
   };
 
+  // Mixed precision dots (quantized int8 and bf16 matmuls) accumulate directly
+  // into the wider output type, without materializing upcasted operands.
+  if (element_type != out_element_type) {
+    switch (element_type) {
+      case S8:
+        if (out_element_type != S32) return unsupported();
+        return dispatch(int8_t{}, int32_t{});
+      case U8:
+        if (out_element_type != S32) return unsupported();
+        return dispatch(uint8_t{}, int32_t{});
+      case BF16:
+        if (out_element_type != F32) return unsupported();
+        return dispatch(bfloat16{}, float{});
+      default:
+        return unsupported();
+    }
+  }
+
   switch (element_type) {
     case F16:
-      dispatch(half{});
-      break;
+      return dispatch(half{}, half{});
     case F32:
-      dispatch(float{});
-      break;
+      return dispatch(float{}, float{});
     case F64:
-      dispatch(double{});
-      break;
+      return dispatch(double{}, double{});
     case S32:
-      dispatch(int32_t{});
-      break;
+      return dispatch(int32_t{}, int32_t{});
     case C64:
-      dispatch(std::complex<float>{});
-      break;
+      return dispatch(std::complex<float>{}, std::complex<float>{});
     case C128:
-      dispatch(std::complex<double>{});
-      break;
+      return dispatch(std::complex<double>{}, std::complex<double>{});
     default:
-      return Unimplemented(
-          "Unsupported element type for DotThunk::Execute: %s",
-          primitive_util::LowercasePrimitiveTypeName(element_type));
+      return unsupported();
   }
-
-  return state.AsRef();
 }
 
 }  // namespace xla::cpu
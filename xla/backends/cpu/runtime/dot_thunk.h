@@ -22,6 +22,8 @@ limitations under the License.
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
 
 #include "absl/base/optimization.h"
@@ -59,14 +61,33 @@ class DotThunk final : public Thunk {
 
   using DoneCallback = absl::AnyInvocable<void()>;
 
-  // Col-major x Col-major MatMul implementation as Eigen contraction.
-  template <typename T, Eigen::AlignmentType alignment>
-  static void MatMul(const Eigen::ThreadPoolDevice* device, T* out, T* lhs,
+  // Tiling of the (batch, N) iteration space of a batched dot operation.
+  struct BatchTiling {
+    int64_t num_tasks() const { return batch_size * num_n_tiles; }
+
+    int64_t batch_size;
+    int64_t n_tile_size;
+    int64_t num_n_tiles;
+  };
+
+  // Returns the tiling for running a batched dot operation as single-threaded
+  // matmuls in parallel, or std::nullopt if it is better to run matmuls one by
+  // one and let Eigen parallelize each of them.
+  static std::optional<BatchTiling> GetBatchTiling(
+      const Eigen::ThreadPoolDevice* device, int64_t batch_size, int64_t m,
+      int64_t n, int64_t k, bool transpose_rhs);
+
+  // Col-major x Col-major MatMul implementation as Eigen contraction. If the
+  // output type `OutT` is wider than the operand type `T` (s8 x s8 -> s32,
+  // bf16 x bf16 -> f32), operands are widened while packed into the
+  // contraction kernel, and products are accumulated in the output type.
+  template <typename T, typename OutT, Eigen::AlignmentType alignment>
+  static void MatMul(const Eigen::ThreadPoolDevice* device, OutT* out, T* lhs,
                      T* rhs, int64_t m, int64_t n, int64_t k,
                      int32_t transpose_lhs, int32_t transpose_rhs,
                      DoneCallback done);
 
-  template <typename T>
+  template <typename T, typename OutT = T>
   static void TypedMatMul(const Eigen::ThreadPoolDevice* device, void* out,
                           void* lhs, void* rhs, int64_t m, int64_t n, int64_t k,
                           bool transpose_lhs, bool transpose_rhs,
@@ -86,8 +107,8 @@ class DotThunk final : public Thunk {
 // DotThunk implementation details.
 //===----------------------------------------------------------------------===//
 
-template <typename T, Eigen::AlignmentType alignment>
-void DotThunk::MatMul(const Eigen::ThreadPoolDevice* device, T* out, T* lhs,
+template <typename T, typename OutT, Eigen::AlignmentType alignment>
+void DotThunk::MatMul(const Eigen::ThreadPoolDevice* device, OutT* out, T* lhs,
                       T* rhs, int64_t m, int64_t n, int64_t k,
                       int32_t transpose_lhs, int32_t transpose_rhs,
                       DoneCallback done) {
@@ -103,22 +124,30 @@ void DotThunk::MatMul(const Eigen::ThreadPoolDevice* device, T* out, T* lhs,
                                                                  lhs_cols);
   const Eigen::TensorMap<Eigen::Tensor<const T, 2>, alignment> b(rhs, rhs_rows,
                                                                  rhs_cols);
-  Eigen::TensorMap<Eigen::Tensor<T, 2>, alignment> c(out, m, n);
+  Eigen::TensorMap<Eigen::Tensor<OutT, 2>, alignment> c(out, m, n);
 
   typedef typename Eigen::Tensor<T, 2>::DimensionPair DimPair;
   int lhs_contract_dim = transpose_lhs ? 0 : 1;
   int rhs_contract_dim = transpose_rhs ? 1 : 0;
   std::array<DimPair, 1> dims({DimPair(lhs_contract_dim, rhs_contract_dim)});
 
-  if (device != nullptr) {
-    c.device(*device, std::move(done)) = a.contract(b, dims);
+  auto contract = [&](const auto& lhs_expr, const auto& rhs_expr) {
+    if (device != nullptr) {
+      c.device(*device, std::move(done)) = lhs_expr.contract(rhs_expr, dims);
+    } else {
+      c = lhs_expr.contract(rhs_expr, dims);
+      done();
+    }
+  };
+
+  if constexpr (std::is_same_v<T, OutT>) {
+    contract(a, b);
   } else {
-    c = a.contract(b, dims);
-    done();
+    contract(a.template cast<OutT>(), b.template cast<OutT>());
   }
 }
 
-template <typename T>
+template <typename T, typename OutT>
 void DotThunk::TypedMatMul(const Eigen::ThreadPoolDevice* device, void* out,
                            void* lhs, void* rhs, int64_t m, int64_t n,
                            int64_t k, bool transpose_lhs, bool transpose_rhs,
@@ -131,15 +160,17 @@ void DotThunk::TypedMatMul(const Eigen::ThreadPoolDevice* device, void* out,
                     is_16_byte_aligned(out);
 
   if (ABSL_PREDICT_TRUE(is_aligned)) {
-    MatMul<T, Eigen::Aligned16>(device, static_cast<T*>(out),
-                                static_cast<T*>(lhs), static_cast<T*>(rhs), m,
-                                n, k, transpose_lhs, transpose_rhs,
-                                std::move(done));
+    MatMul<T, OutT, Eigen::Aligned16>(device, static_cast<OutT*>(out),
+                                      static_cast<T*>(lhs),
+                                      static_cast<T*>(rhs), m, n, k,
+                                      transpose_lhs, transpose_rhs,
+                                      std::move(done));
   } else {
-    MatMul<T, Eigen::Unaligned>(device, static_cast<T*>(out),
-                                static_cast<T*>(lhs), static_cast<T*>(rhs), m,
-                                n, k, transpose_lhs, transpose_rhs,
-                                std::move(done));
+    MatMul<T, OutT, Eigen::Unaligned>(device, static_cast<OutT*>(out),
+                                      static_cast<T*>(lhs),
+                                      static_cast<T*>(rhs), m, n, k,
+                                      transpose_lhs, transpose_rhs,
+                                      std::move(done));
   }
 }
 
@@ -160,6 +191,20 @@ DOT_THUNK_EXTERN_MATMUL_TEMPLATE(std::complex<double>);
 
 #undef DOT_THUNK_EXTERN_MATMUL_TEMPLATE
 
+// Extern mixed precision DotThunk::TypedMatMul templates, where narrow operands
+// are accumulated into a wider output type.
+#define DOT_THUNK_EXTERN_MIXED_MATMUL_TEMPLATE(T, OutT)                        \
+  extern template void DotThunk::TypedMatMul<T, OutT>(                         \
+      const Eigen::ThreadPoolDevice* device, void* out, void* lhs, void* rhs,  \
+      int64_t m, int64_t n, int64_t k, bool transpose_lhs, bool transpose_rhs, \
+      DoneCallback done)
+
+DOT_THUNK_EXTERN_MIXED_MATMUL_TEMPLATE(int8_t, int32_t);
+DOT_THUNK_EXTERN_MIXED_MATMUL_TEMPLATE(uint8_t, int32_t);
+DOT_THUNK_EXTERN_MIXED_MATMUL_TEMPLATE(Eigen::bfloat16, float);
+
+#undef DOT_THUNK_EXTERN_MIXED_MATMUL_TEMPLATE
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_RUNTIME_DOT_THUNK_H_
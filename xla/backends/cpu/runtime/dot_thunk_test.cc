@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 
+#include <cstdint>
 #include <tuple>
 
 #include "absl/strings/str_cat.h"
@@ -31,6 +32,7 @@ limitations under the License.
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/platform/threadpool.h"
+#include "xla/types.h"
 #include "xla/xla_data.pb.h"
 
 #define EIGEN_USE_THREADS
@@ -143,6 +145,123 @@ TEST(DotThunkTest, ThreadedDot) {
   EXPECT_EQ(out, expected);
 }
 
+TEST(DotThunkTest, ThreadedBatchedDot) {
+  // Small batched matmuls are tiled across batch and N dimensions.
+  auto lhs_shape = ShapeUtil::MakeShape(F32, {3, 16, 32});
+  auto rhs_shape = ShapeUtil::MakeShape(F32, {3, 32, 40});
+  auto out_shape = ShapeUtil::MakeShape(F32, {3, 16, 40});
+
+  auto lhs = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      lhs_shape, [](auto index) { return index[0] + 1; });
+  auto rhs = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      rhs_shape, [](auto index) { return index[2]; });
+  auto out = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      out_shape, [](auto) { return 0; });
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_batch_dimensions(0);
+  dot_dimensions.add_rhs_batch_dimensions(0);
+  dot_dimensions.add_lhs_contracting_dimensions(2);
+  dot_dimensions.add_rhs_contracting_dimensions(1);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs_shape,
+                       rhs_slice, rhs_shape, out_slice, out_shape));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  auto expected = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      out_shape, [](auto index) { return (index[0] + 1) * index[2] * 32; });
+  EXPECT_EQ(out, expected);
+}
+
+TEST(DotThunkTest, Int8DotAccumulatesInInt32) {
+  auto lhs = LiteralUtil::CreateR2<int8_t>({{127, -128, 3}, {-4, 5, 6}});
+  auto rhs = LiteralUtil::CreateR2<int8_t>({{127, 8}, {-128, 10}, {11, 12}});
+  auto out = LiteralUtil::CreateR2<int32_t>({{0, 0}, {0, 0}});
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs.shape(),
+                       rhs_slice, rhs.shape(), out_slice, out.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  // Products overflow int8, so the result is only correct if operands are
+  // accumulated in int32.
+  EXPECT_EQ(out,
+            LiteralUtil::CreateR2<int32_t>({{32546, -228}, {-1082, 90}}));
+}
+
+TEST(DotThunkTest, Bf16DotAccumulatesInF32) {
+  auto lhs = LiteralUtil::CreateR2<bfloat16>(
+      {{bfloat16(1.0f), bfloat16(2.0f), bfloat16(3.0f)},
+       {bfloat16(4.0f), bfloat16(5.0f), bfloat16(6.0f)}});
+  auto rhs = LiteralUtil::CreateR2<bfloat16>(
+      {{bfloat16(7.0f), bfloat16(8.0f)},
+       {bfloat16(9.0f), bfloat16(10.0f)},
+       {bfloat16(11.0f), bfloat16(12.0f)}});
+  auto out = LiteralUtil::CreateR2<float>({{0.0, 0.0}, {0.0, 0.0}});
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs.shape(),
+                       rhs_slice, rhs.shape(), out_slice, out.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  EXPECT_EQ(out, LiteralUtil::CreateR2<float>({{58.0, 64.0}, {139.0, 154.0}}));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DotThunkLayoutTest, DotThunkLayoutTest,
     testing::Combine(testing::Bool(), testing::Bool(), testing::Bool(),
@@ -14,27 +14,42 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/backends/cpu/runtime/fft_thunk.h"
 
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
-#include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "ducc/google/fft.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_queue.h"
 #include "xla/layout_util.h"
+#include "xla/primitive_util.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
-#include "xla/service/cpu/runtime_fft.h"
-#include "xla/service/cpu/runtime_single_threaded_fft.h"
 #include "xla/shape.h"
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
 
 namespace xla::cpu {
 
+// Transforms up to this size (in elements) are parallelized across the batch
+// dimension, and larger transforms use DUCC internal threading.
+static constexpr int64_t kMaxBatchParallelFftSize = 16 * 1024;
+
+// Minimum number of transformed elements processed by a single task.
+static constexpr int64_t kMinParallelFftTaskSize = 16 * 1024;
+
 FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
                    int32_t fft_type, absl::Span<const int64_t> fft_length,
                    BufferAllocation::Slice input_buffer,
@@ -50,7 +65,12 @@ FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
       input_buffer_(input_buffer),
       output_buffer_(output_buffer),
       input_shape_(input_shape),
-      output_shape_(output_shape) {}
+      output_shape_(output_shape),
+      plan_(CreatePlan(fft_type, fft_length, input_shape, output_shape)),
+      input_element_size_(
+          primitive_util::ByteWidth(input_shape.element_type())),
+      output_element_size_(
+          primitive_util::ByteWidth(output_shape.element_type())) {}
 
 absl::StatusOr<std::unique_ptr<FftThunk>> FftThunk::Create(
     Info thunk_info, bool is_multi_thread_eigen, int32_t fft_type,
@@ -62,6 +82,126 @@ absl::StatusOr<std::unique_ptr<FftThunk>> FftThunk::Create(
                    input_buffer, input_shape, output_buffer, output_shape));
 }
 
+// Computes DUCC FFT arguments the same way as `__xla_cpu_runtime_DuccFft`
+// does, but only once for the lifetime of the thunk.
+FftThunk::FftPlan FftThunk::CreatePlan(int32_t fft_type,
+                                       absl::Span<const int64_t> fft_length,
+                                       const Shape& input_shape,
+                                       const Shape& output_shape) {
+  FftPlan plan;
+  plan.forward = (fft_type == /*FFT*/ 0 || fft_type == /*RFFT*/ 2);
+  plan.real = (fft_type == /*RFFT*/ 2 || fft_type == /*IRFFT*/ 3);
+
+  const int64_t fft_rank = fft_length.size();
+  const int64_t batch_rank = output_shape.dimensions_size() - fft_rank;
+
+  // Flatten operand batches.
+  plan.batch_size = 1;
+  for (int64_t i = 0; i < batch_rank; ++i) {
+    plan.batch_size *= input_shape.dimensions(i);
+  }
+
+  plan.in_shape.resize(fft_rank + 1);
+  plan.in_stride.resize(fft_rank + 1);
+  plan.out_shape.resize(fft_rank + 1);
+  plan.out_stride.resize(fft_rank + 1);
+  plan.axes.resize(fft_rank);
+
+  plan.in_shape[fft_rank] = input_shape.dimensions(batch_rank + fft_rank - 1);
+  plan.in_stride[fft_rank] = 1;
+  plan.out_shape[fft_rank] = (plan.real && plan.forward)
+                                 ? fft_length[fft_rank - 1] / 2 + 1
+                                 : fft_length[fft_rank - 1];
+  plan.out_stride[fft_rank] = 1;
+  for (int64_t i = fft_rank; i-- > 1;) {
+    plan.in_shape[i] = input_shape.dimensions(batch_rank + i - 1);
+    plan.in_stride[i] = plan.in_stride[i + 1] * plan.in_shape[i + 1];
+    plan.out_shape[i] = fft_length[i - 1];
+    plan.out_stride[i] = plan.out_stride[i + 1] * plan.out_shape[i + 1];
+    plan.axes[i] = i + 1;
+  }
+  plan.in_shape[0] = plan.batch_size;
+  plan.in_stride[0] = plan.in_stride[1] * plan.in_shape[1];
+  plan.out_shape[0] = plan.batch_size;
+  plan.out_stride[0] = plan.out_stride[1] * plan.out_shape[1];
+  plan.axes[0] = 1;
+
+  // DUCC doesn't handle the case where fft_size[i] < input_size[i], so
+  // manually adjust inputs if required. If doing irfft, the limit of the last
+  // axis is actually fft_size[i]/2 + 1.
+  const bool is_irfft = plan.real && !plan.forward;
+  for (int64_t i = 0; i < fft_rank; ++i) {
+    size_t limit = (is_irfft && (i == (fft_rank - 1)))
+                       ? fft_length[i] / 2 + 1
+                       : fft_length[i];
+    if (plan.in_shape[plan.axes[i]] > limit) {
+      plan.in_shape[plan.axes[i]] = limit;
+    }
+  }
+
+  double inv_scale = 1.0;
+  for (int64_t i = 0; i < fft_rank; ++i) {
+    inv_scale *= plan.out_shape[plan.axes[i]];
+  }
+  plan.scale = plan.forward ? 1.0 : 1.0 / inv_scale;
+
+  plan.fft_size = 1;
+  for (int64_t length : fft_length) plan.fft_size *= length;
+
+  return plan;
+}
+
+template <typename RealScalar>
+static void DuccFft(bool forward, bool real, RealScalar scale, const void* in,
+                    const ducc0::google::Shape& in_shape,
+                    const ducc0::google::Stride& in_stride, void* out,
+                    const ducc0::google::Shape& out_shape,
+                    const ducc0::google::Stride& out_stride,
+                    const ducc0::google::Shape& axes,
+                    Eigen::ThreadPoolInterface* thread_pool) {
+  using Complex = std::complex<RealScalar>;
+
+  if (!real) {
+    ducc0::google::c2c(static_cast<const Complex*>(in), in_shape, in_stride,
+                       static_cast<Complex*>(out), out_shape, out_stride, axes,
+                       forward, scale, thread_pool);
+  } else if (forward) {
+    ducc0::google::r2c(static_cast<const RealScalar*>(in), in_shape,
+                       in_stride, static_cast<Complex*>(out), out_shape,
+                       out_stride, axes, forward, scale, thread_pool);
+  } else {
+    ducc0::google::c2r(static_cast<const Complex*>(in), in_shape, in_stride,
+                       static_cast<RealScalar*>(out), out_shape, out_stride,
+                       axes, forward, scale, thread_pool);
+  }
+}
+
+void FftThunk::RunFft(void* input, void* output, int64_t batch_offset,
+                      int64_t batch_size,
+                      const Eigen::ThreadPoolDevice* device) const {
+  const std::byte* in = static_cast<const std::byte*>(input) +
+                        batch_offset * plan_.in_stride[0] * input_element_size_;
+  std::byte* out = static_cast<std::byte*>(output) +
+                   batch_offset * plan_.out_stride[0] * output_element_size_;
+
+  ducc0::google::Shape in_shape = plan_.in_shape;
+  ducc0::google::Shape out_shape = plan_.out_shape;
+  in_shape[0] = out_shape[0] = batch_size;
+
+  Eigen::ThreadPoolInterface* thread_pool =
+      device == nullptr ? nullptr : device->getPool();
+
+  if (is_double_precision_) {
+    DuccFft<double>(plan_.forward, plan_.real, plan_.scale, in, in_shape,
+                    plan_.in_stride, out, out_shape, plan_.out_stride,
+                    plan_.axes, thread_pool);
+  } else {
+    DuccFft<float>(plan_.forward, plan_.real, static_cast<float>(plan_.scale),
+                   in, in_shape, plan_.in_stride, out, out_shape,
+                   plan_.out_stride, plan_.axes, thread_pool);
+  }
+}
+
 tsl::AsyncValueRef<Thunk::ExecuteEvent> FftThunk::Execute(
     const ExecuteParams& params) {
   TF_RET_CHECK(LayoutUtil::IsMonotonicWithDim0Major(input_shape_.layout()));
@@ -74,35 +214,40 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> FftThunk::Execute(
       se::DeviceMemoryBase output_data,
       params.buffer_allocations->GetDeviceAddress(output_buffer_));
 
-  const int fft_rank = fft_length_.size();
+  void* input = input_data.opaque();
+  void* output = output_data.opaque();
+  int64_t batch_size = plan_.batch_size;
 
-  // Flatten operand batches.
-  absl::InlinedVector<int64_t, 4> operand_shape_flat(fft_rank + 1);
-  int64_t input_batch = 1;
-  int64_t input_batch_length = output_shape_.dimensions_size() - fft_rank;
-  for (int i = 0; i < input_batch_length; i++) {
-    input_batch *= input_shape_.dimensions(i);
-  }
-  operand_shape_flat[0] = input_batch;
-  for (int i = 0; i < fft_rank; ++i) {
-    operand_shape_flat[i + 1] = input_shape_.dimensions(i + input_batch_length);
+  const Eigen::ThreadPoolDevice* device =
+      is_multi_thread_eigen_ ? params.intra_op_threadpool : nullptr;
+
+  // Large transforms are parallelized by DUCC itself.
+  if (device == nullptr || plan_.fft_size > kMaxBatchParallelFftSize) {
+    RunFft(input, output, 0, batch_size, device);
+    return OkExecuteEvent();
   }
 
-  // Args have been computed, make the call.
-  if (is_multi_thread_eigen_) {
-    __xla_cpu_runtime_DuccFft(params.intra_op_threadpool,
-                              reinterpret_cast<float*>(output_data.opaque()),
-                              reinterpret_cast<float*>(input_data.opaque()),
-                              fft_type_, is_double_precision_, fft_rank,
-                              operand_shape_flat.data(), fft_length_.data());
-  } else {
-    __xla_cpu_runtime_DuccSingleThreadedFft(
-        nullptr, reinterpret_cast<float*>(output_data.opaque()),
-        reinterpret_cast<float*>(input_data.opaque()), fft_type_,
-        is_double_precision_, fft_rank, operand_shape_flat.data(),
-        fft_length_.data());
+  // Split a batch of small transforms between tasks that run single-threaded
+  // DUCC FFTs, as DUCC doesn't parallelize them efficiently.
+  int64_t num_tasks = std::min<int64_t>(
+      {batch_size, device->numThreads(),
+       CeilOfRatio(batch_size * plan_.fft_size, kMinParallelFftTaskSize)});
+
+  if (num_tasks <= 1) {
+    RunFft(input, output, 0, batch_size, nullptr);
+    return OkExecuteEvent();
   }
-  return OkExecuteEvent();
+
+  int64_t task_size = CeilOfRatio(batch_size, num_tasks);
+  num_tasks = CeilOfRatio(batch_size, task_size);
+
+  return Worker::Parallelize(
+      device, num_tasks, num_tasks,
+      [this, input, output, task_size, batch_size](size_t task_index) {
+        int64_t batch_offset = task_index * task_size;
+        RunFft(input, output, batch_offset,
+               std::min(task_size, batch_size - batch_offset), nullptr);
+      });
 }
 
 Thunk::BufferUses FftThunk::buffer_uses() const {
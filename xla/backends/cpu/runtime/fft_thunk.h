@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_RUNTIME_FFT_THUNK_H_
 #define XLA_BACKENDS_CPU_RUNTIME_FFT_THUNK_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -33,6 +34,11 @@ namespace xla::cpu {
 // This class stores everything that is needed to launch an FFT.
 // It is generated by IrEmitter.
 //
+// FFT plan (DUCC shapes, strides and scaling factor) is computed once at
+// thunk construction time. Batches of small transforms are split across the
+// intra-op thread pool, and each task runs a single-threaded DUCC FFT on its
+// part of the batch. Large transforms rely on DUCC internal threading.
+//
 // This is thread-compatible.
 class FftThunk final : public Thunk {
  public:
@@ -58,12 +64,41 @@ class FftThunk final : public Thunk {
   const Shape& output_shape() const { return output_shape_; }
 
  private:
+  // DUCC FFT arguments for the flattened [batch, fft_length...] input and
+  // output arrays. Strides are in elements.
+  struct FftPlan {
+    bool forward;
+    bool real;
+    double scale;
+
+    std::vector<size_t> in_shape;
+    std::vector<ptrdiff_t> in_stride;
+    std::vector<size_t> out_shape;
+    std::vector<ptrdiff_t> out_stride;
+    std::vector<size_t> axes;
+
+    int64_t batch_size;
+    int64_t fft_size;
+  };
+
   // Constructs a thunk for launching an FFT on a host.
   FftThunk(Info thunk_info, bool is_multi_thread_eigen, int32_t fft_type,
            absl::Span<const int64_t> fft_length,
            BufferAllocation::Slice input_buffer, const Shape& input_shape,
            BufferAllocation::Slice output_buffer, const Shape& output_shape);
 
+  static FftPlan CreatePlan(int32_t fft_type,
+                            absl::Span<const int64_t> fft_length,
+                            const Shape& input_shape,
+                            const Shape& output_shape);
+
+  // Runs FFT for the [batch_offset, batch_offset + batch_size) batch range
+  // using the given thread pool device (or in the caller thread if it's
+  // nullptr).
+  void RunFft(void* input, void* output, int64_t batch_offset,
+              int64_t batch_size,
+              const Eigen::ThreadPoolDevice* device) const;
+
   const bool is_multi_thread_eigen_;
   const bool is_double_precision_;
   const int32_t fft_type_;
@@ -74,6 +109,10 @@ class FftThunk final : public Thunk {
 
   const Shape input_shape_;
   const Shape output_shape_;
+
+  const FftPlan plan_;
+  const size_t input_element_size_;
+  const size_t output_element_size_;
 };
 
 }  // namespace xla::cpu
@@ -0,0 +1,131 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/fft_thunk.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/types.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+// Runs FFT thunk on the given input literal and writes results to the output
+// literal. If `device` is not null, runs FFT in the multi-threaded mode.
+void RunFft(FftType fft_type, absl::Span<const int64_t> fft_length,
+            Literal& input, Literal& output,
+            const Eigen::ThreadPoolDevice* device = nullptr) {
+  BufferAllocations allocations = CreateBufferAllocations(input, output);
+
+  auto [input_alloc, output_alloc] = CreateBufferAllocation(input, output);
+  auto [input_slice, output_slice] =
+      CreateBufferAllocationSlice(input_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      FftThunk::Create({"fft"}, /*is_multi_thread_eigen=*/device != nullptr,
+                       fft_type, fft_length, input_slice, input.shape(),
+                       output_slice, output.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+}
+
+TEST(FftThunkTest, FftOfDelta) {
+  auto input = LiteralUtil::CreateR2<complex64>(
+      {{{1, 0}, {0, 0}, {0, 0}, {0, 0}}, {{2, 0}, {0, 0}, {0, 0}, {0, 0}}});
+  auto output = LiteralUtil::CreateFull<complex64>({2, 4}, {0, 0});
+
+  RunFft(FftType::FFT, {4}, input, output);
+
+  auto expected = LiteralUtil::CreateR2<complex64>(
+      {{{1, 0}, {1, 0}, {1, 0}, {1, 0}}, {{2, 0}, {2, 0}, {2, 0}, {2, 0}}});
+  EXPECT_EQ(output, expected);
+}
+
+TEST(FftThunkTest, BatchParallelFft) {
+  auto input = *LiteralUtil::CreateLiteralWithGenerator<C64, complex64>(
+      ShapeUtil::MakeShape(C64, {1024, 256}),
+      [](absl::Span<const int64_t> idx) {
+        return complex64(std::sin(idx[0] * 0.1f + idx[1]),
+                         std::cos(idx[1] * 0.3f - idx[0]));
+      });
+  auto output = LiteralUtil::CreateFull<complex64>({1024, 256}, {0, 0});
+  auto expected = output.Clone();
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  RunFft(FftType::FFT, {256}, input, output, &device);
+  RunFft(FftType::FFT, {256}, input, expected);
+
+  absl::Span<const complex64> results = output.data<complex64>();
+  absl::Span<const complex64> expected_results = expected.data<complex64>();
+  for (int64_t i = 0; i < results.size(); ++i) {
+    EXPECT_NEAR(std::abs(results[i] - expected_results[i]), 0.0f, 1e-4f);
+  }
+}
+
+TEST(FftThunkTest, BatchParallelRfft) {
+  auto input = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      ShapeUtil::MakeShape(F32, {512, 512}),
+      [](absl::Span<const int64_t> idx) {
+        return std::sin(idx[0] * 0.1f + idx[1]);
+      });
+  auto output = LiteralUtil::CreateFull<complex64>({512, 257}, {0, 0});
+  auto expected = output.Clone();
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  RunFft(FftType::RFFT, {512}, input, output, &device);
+  RunFft(FftType::RFFT, {512}, input, expected);
+
+  absl::Span<const complex64> results = output.data<complex64>();
+  absl::Span<const complex64> expected_results = expected.data<complex64>();
+  for (int64_t i = 0; i < results.size(); ++i) {
+    EXPECT_NEAR(std::abs(results[i] - expected_results[i]), 0.0f, 1e-3f);
+  }
+}
+
+}  // namespace
+}  // namespace xla::cpu
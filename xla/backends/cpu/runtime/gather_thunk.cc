@@ -0,0 +1,193 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/base/optimization.h"
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_queue.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Prefer single-threaded execution for small gathers, and split large gathers
+// into tasks that copy at least this many bytes.
+static constexpr int64_t kMinParallelGatherTaskSize = 64 * 1024;
+
+absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunk::Create(
+    Info info, BufferAllocation::Slice operand_buffer,
+    const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+    const Shape& indices_shape, BufferAllocation::Slice output_buffer,
+    const Shape& output_shape) {
+  if (operand_shape.dimensions_size() == 0) {
+    return InvalidArgument("Gather operand must have at least one dimension");
+  }
+
+  if (indices_shape.element_type() != S32 &&
+      indices_shape.element_type() != S64) {
+    return InvalidArgument("Unsupported gather indices type: %s",
+                           primitive_util::LowercasePrimitiveTypeName(
+                               indices_shape.element_type()));
+  }
+
+  if (operand_shape.element_type() != output_shape.element_type() ||
+      primitive_util::IsSubByteNonPredType(operand_shape.element_type())) {
+    return InvalidArgument(
+        "Unsupported gather operand and output types: %s and %s",
+        operand_shape.ToString(true), output_shape.ToString(true));
+  }
+
+  for (const Shape* shape : {&operand_shape, &indices_shape, &output_shape}) {
+    if (!LayoutUtil::IsMonotonicWithDim0Major(shape->layout())) {
+      return InvalidArgument("Gather shape %s must have a row-major layout",
+                             shape->ToString(true));
+    }
+  }
+
+  int64_t row_size = ShapeUtil::ElementsIn(operand_shape) /
+                     std::max<int64_t>(1, operand_shape.dimensions(0));
+  if (ShapeUtil::ElementsIn(output_shape) !=
+      ShapeUtil::ElementsIn(indices_shape) * row_size) {
+    return InvalidArgument(
+        "Gather output shape %s must contain a row of operand %s for every "
+        "index in %s",
+        output_shape.ToString(true), operand_shape.ToString(true),
+        indices_shape.ToString(true));
+  }
+
+  return absl::WrapUnique(new GatherThunk(
+      std::move(info), operand_buffer, operand_shape, indices_buffer,
+      indices_shape, output_buffer, output_shape));
+}
+
+GatherThunk::GatherThunk(Info info, BufferAllocation::Slice operand_buffer,
+                         const Shape& operand_shape,
+                         BufferAllocation::Slice indices_buffer,
+                         const Shape& indices_shape,
+                         BufferAllocation::Slice output_buffer,
+                         const Shape& output_shape)
+    : Thunk(Kind::kGather, std::move(info)),
+      operand_buffer_(operand_buffer),
+      operand_shape_(operand_shape),
+      indices_buffer_(indices_buffer),
+      indices_shape_(indices_shape),
+      output_buffer_(output_buffer),
+      output_shape_(output_shape),
+      num_rows_(operand_shape_.dimensions(0)),
+      num_indices_(ShapeUtil::ElementsIn(indices_shape_)),
+      row_size_in_bytes_(num_indices_ == 0
+                             ? 0
+                             : ShapeUtil::ByteSizeOf(output_shape_) /
+                                   num_indices_) {}
+
+template <typename IndexType>
+tsl::AsyncValueRef<Thunk::ExecuteEvent> GatherThunk::ExecuteTyped(
+    const ExecuteParams& params, std::byte* output, const std::byte* operand,
+    const IndexType* indices) {
+  int64_t num_rows = num_rows_;
+  int64_t row_size = row_size_in_bytes_;
+
+  // Copies rows for indices in the [begin, end) range.
+  auto gather_rows = [=](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      int64_t row = std::clamp<int64_t>(indices[i], 0, num_rows - 1);
+      std::memcpy(output + i * row_size, operand + row * row_size, row_size);
+    }
+  };
+
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+  int64_t num_tasks = std::min(
+      num_indices_,
+      CeilOfRatio(num_indices_ * row_size, kMinParallelGatherTaskSize));
+
+  if (device == nullptr || num_tasks <= 1) {
+    gather_rows(0, num_indices_);
+    return OkExecuteEvent();
+  }
+
+  int64_t task_size = CeilOfRatio(num_indices_, num_tasks);
+  int64_t num_workers = std::min<int64_t>(num_tasks, device->numThreads());
+
+  return Worker::Parallelize(
+      device, num_workers, num_tasks,
+      [=, num_indices = num_indices_](size_t task_index) {
+        int64_t begin = task_index * task_size;
+        gather_rows(begin, std::min(begin + task_size, num_indices));
+      });
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent> GatherThunk::Execute(
+    const ExecuteParams& params) {
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase operand_data,
+      params.buffer_allocations->GetDeviceAddress(operand_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase indices_data,
+      params.buffer_allocations->GetDeviceAddress(indices_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output_data,
+      params.buffer_allocations->GetDeviceAddress(output_buffer_));
+
+  // Nothing to gather if there are no indices or rows are empty.
+  if (num_indices_ == 0 || row_size_in_bytes_ == 0) {
+    return OkExecuteEvent();
+  }
+
+  if (ABSL_PREDICT_FALSE(num_rows_ == 0)) {
+    return InvalidArgument("Can't gather rows from an empty operand %s",
+                           operand_shape_.ToString(true));
+  }
+
+  auto* output = reinterpret_cast<std::byte*>(output_data.opaque());
+  auto* operand = reinterpret_cast<const std::byte*>(operand_data.opaque());
+
+  switch (indices_shape_.element_type()) {
+    case S32:
+      return ExecuteTyped(
+          params, output, operand,
+          reinterpret_cast<const int32_t*>(indices_data.opaque()));
+    case S64:
+      return ExecuteTyped(
+          params, output, operand,
+          reinterpret_cast<const int64_t*>(indices_data.opaque()));
+    default:
+      return Internal("Unsupported gather indices type: %s",
+                      primitive_util::LowercasePrimitiveTypeName(
+                          indices_shape_.element_type()));
+  }
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,141 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+TEST(GatherThunkTest, GatherRows) {
+  auto operand = LiteralUtil::CreateR2<float>(
+      {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}, {7.0, 8.0}});
+  // Out of bounds indices are clamped to the operand bounds.
+  auto indices = LiteralUtil::CreateR1<int32_t>({2, 0, -1, 7, 2});
+  auto output = LiteralUtil::CreateFull<float>({5, 2}, 0.0f);
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(output, LiteralUtil::CreateR2<float>({{5.0, 6.0},
+                                                  {1.0, 2.0},
+                                                  {1.0, 2.0},
+                                                  {7.0, 8.0},
+                                                  {5.0, 6.0}}));
+}
+
+TEST(GatherThunkTest, GatherRowsInParallel) {
+  static constexpr int64_t kNumRows = 1024;
+  static constexpr int64_t kRowSize = 128;
+  static constexpr int64_t kNumIndices = 2048;
+
+  auto operand = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      ShapeUtil::MakeShape(F32, {kNumRows, kRowSize}),
+      [](absl::Span<const int64_t> idx) { return idx[0] * kRowSize + idx[1]; });
+
+  std::vector<int64_t> indices_vector(kNumIndices);
+  for (int64_t i = 0; i < kNumIndices; ++i) {
+    indices_vector[i] = (i * 7) % kNumRows;
+  }
+  auto indices = LiteralUtil::CreateR1<int64_t>(indices_vector);
+  auto output = LiteralUtil::CreateFull<float>({kNumIndices, kRowSize}, 0.0f);
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  auto expected = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      output.shape(), [](absl::Span<const int64_t> idx) {
+        return ((idx[0] * 7) % kNumRows) * kRowSize + idx[1];
+      });
+  EXPECT_EQ(output, expected);
+}
+
+TEST(GatherThunkTest, RejectUnsupportedIndicesType) {
+  auto operand = LiteralUtil::CreateR2<float>({{1.0, 2.0}, {3.0, 4.0}});
+  auto indices = LiteralUtil::CreateR1<uint8_t>({0, 1});
+  auto output = LiteralUtil::CreateFull<float>({2, 2}, 0.0f);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  EXPECT_FALSE(GatherThunk::Create({"gather"}, operand_slice, operand.shape(),
+                                   indices_slice, indices.shape(),
+                                   output_slice, output.shape())
+                   .ok());
+}
+
+}  // namespace
+}  // namespace xla::cpu
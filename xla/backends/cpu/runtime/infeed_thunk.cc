@@ -16,13 +16,13 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 
 #include <cstdint>
-#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
@@ -31,8 +31,10 @@ limitations under the License.
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/xfeed_manager.h"
+#include "xla/shape.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 
@@ -85,12 +87,16 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> InfeedThunk::Execute(
     // TODO(ezhulenev): Benchmark multi threaded memcpy and consider add a
     // parallel memcpy that can be reused in Copy thunk.
 
-    // Copy data from infeed buffer to the destination.
-    std::memcpy(infeed_data.opaque(), buffer->data(), buffer->length());
+    // Write data from infeed buffer to the destination. Buffers with a fill
+    // callback write directly into the destination without a copy.
+    absl::Status written = buffer->WriteTo(infeed_data.opaque());
 
     // Release infeed buffer back to the runtime.
+    absl::StatusOr<Shape> shape = infeed_buffer.shape;
+    if (!written.ok()) shape = written;
     xfeed->infeed()->ReleaseCurrentBuffer(buffer->length(), buffer->data(),
-                                          infeed_buffer.shape);
+                                          std::move(shape));
+    TF_RETURN_IF_ERROR(written);
   }
 
   return OkExecuteEvent();
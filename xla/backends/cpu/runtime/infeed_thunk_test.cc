@@ -15,14 +15,24 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal_util.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
+#include "xla/service/cpu/xfeed_manager.h"
+#include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/statusor.h"
 #include "tsl/platform/test.h"
@@ -54,5 +64,59 @@ TEST(InfeedThunkTest, BufferAndResourceUses) {
   EXPECT_EQ(thunk->resource_uses()[1], ResourceUse::Write(produce_token));
 }
 
+// Infeed buffer that writes data directly into the destination.
+class FillInfeedBuffer : public runtime::XfeedBuffer {
+ public:
+  explicit FillInfeedBuffer(int32_t length) : length_(length) {}
+
+  int32_t length() override { return length_; }
+  void* data() override { return nullptr; }
+
+  absl::Status WriteTo(void* dst) override {
+    float* floats = static_cast<float*>(dst);
+    int32_t n = length_ / static_cast<int32_t>(sizeof(float));
+    for (int32_t i = 0; i < n; ++i) floats[i] = i;
+    return absl::OkStatus();
+  }
+
+  void Done(absl::StatusOr<Shape> shape) override { status_ = shape.status(); }
+
+  const absl::Status& status() const { return status_; }
+
+ private:
+  int32_t length_;
+  absl::Status status_ = absl::UnknownError("not released");
+};
+
+TEST(InfeedThunkTest, FillInfeedBuffer) {
+  auto dst = LiteralUtil::CreateFull<float>({4}, 0.0f);
+  BufferAllocations allocations = CreateBufferAllocations(dst);
+  BufferAllocation alloc = CreateBufferAllocation(0, dst);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  InfeedThunk::InfeedBuffer infeed_buffer = {slice, dst.shape()};
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      InfeedThunk::Create({"infeed"}, {infeed_buffer},
+                          {Resource::Create(Resource::kToken),
+                           Resource::Create(Resource::kToken)}));
+
+  runtime::XfeedManager xfeed;
+  FillInfeedBuffer buffer(4 * sizeof(float));
+  xfeed.infeed()->EnqueueBuffersAtomically({&buffer});
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.xfeed = &xfeed;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(dst, LiteralUtil::CreateR1<float>({0.0f, 1.0f, 2.0f, 3.0f}));
+  EXPECT_TRUE(buffer.status().ok());
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -0,0 +1,311 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/scatter_thunk.h"
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_queue.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/types.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Prefer single-threaded execution for small scatters, and split large
+// scatters into tasks that update at least this many bytes.
+static constexpr int64_t kMinParallelScatterTaskSize = 64 * 1024;
+
+static void AssignRow(std::byte* dst, const std::byte* src,
+                      int64_t row_size_in_bytes) {
+  std::memcpy(dst, src, row_size_in_bytes);
+}
+
+template <typename T>
+static void AddRow(std::byte* dst, const std::byte* src,
+                   int64_t row_size_in_bytes) {
+  T* dst_row = reinterpret_cast<T*>(dst);
+  const T* src_row = reinterpret_cast<const T*>(src);
+
+  int64_t row_size = row_size_in_bytes / sizeof(T);
+  for (int64_t i = 0; i < row_size; ++i) {
+    dst_row[i] += src_row[i];
+  }
+}
+
+static absl::StatusOr<ScatterThunk::UpdateRowFn> GetUpdateRowFn(
+    ScatterThunk::Combiner combiner, PrimitiveType type) {
+  if (combiner == ScatterThunk::Combiner::kAssign) {
+    return &AssignRow;
+  }
+
+  // We add signed integers as unsigned ones to get wrap-around semantics on
+  // overflow without relying on undefined behavior.
+  switch (type) {
+    case F16:
+      return &AddRow<half>;
+    case BF16:
+      return &AddRow<bfloat16>;
+    case F32:
+      return &AddRow<float>;
+    case F64:
+      return &AddRow<double>;
+    case S8:
+    case U8:
+      return &AddRow<uint8_t>;
+    case S16:
+    case U16:
+      return &AddRow<uint16_t>;
+    case S32:
+    case U32:
+      return &AddRow<uint32_t>;
+    case S64:
+    case U64:
+      return &AddRow<uint64_t>;
+    default:
+      return InvalidArgument("Unsupported scatter-add element type: %s",
+                             primitive_util::LowercasePrimitiveTypeName(type));
+  }
+}
+
+absl::StatusOr<std::unique_ptr<ScatterThunk>> ScatterThunk::Create(
+    Info info, BufferAllocation::Slice operand_buffer,
+    const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+    const Shape& indices_shape, BufferAllocation::Slice updates_buffer,
+    const Shape& updates_shape, BufferAllocation::Slice output_buffer,
+    const Shape& output_shape, Combiner combiner, bool indices_are_sorted,
+    bool unique_indices) {
+  if (operand_shape.dimensions_size() == 0) {
+    return InvalidArgument("Scatter operand must have at least one dimension");
+  }
+
+  if (!ShapeUtil::Equal(operand_shape, output_shape)) {
+    return InvalidArgument(
+        "Scatter operand shape %s must be equal to output shape %s",
+        operand_shape.ToString(true), output_shape.ToString(true));
+  }
+
+  if (indices_shape.element_type() != S32 &&
+      indices_shape.element_type() != S64) {
+    return InvalidArgument("Unsupported scatter indices type: %s",
+                           primitive_util::LowercasePrimitiveTypeName(
+                               indices_shape.element_type()));
+  }
+
+  if (operand_shape.element_type() != updates_shape.element_type() ||
+      primitive_util::IsSubByteNonPredType(operand_shape.element_type())) {
+    return InvalidArgument(
+        "Unsupported scatter operand and updates types: %s and %s",
+        operand_shape.ToString(true), updates_shape.ToString(true));
+  }
+
+  for (const Shape* shape : {&operand_shape, &indices_shape, &updates_shape}) {
+    if (!LayoutUtil::IsMonotonicWithDim0Major(shape->layout())) {
+      return InvalidArgument("Scatter shape %s must have a row-major layout",
+                             shape->ToString(true));
+    }
+  }
+
+  int64_t row_size = ShapeUtil::ElementsIn(operand_shape) /
+                     std::max<int64_t>(1, operand_shape.dimensions(0));
+  if (ShapeUtil::ElementsIn(updates_shape) !=
+      ShapeUtil::ElementsIn(indices_shape) * row_size) {
+    return InvalidArgument(
+        "Scatter updates shape %s must contain a row of operand %s for every "
+        "index in %s",
+        updates_shape.ToString(true), operand_shape.ToString(true),
+        indices_shape.ToString(true));
+  }
+
+  TF_ASSIGN_OR_RETURN(UpdateRowFn update_row,
+                      GetUpdateRowFn(combiner, operand_shape.element_type()));
+
+  return absl::WrapUnique(new ScatterThunk(
+      std::move(info), operand_buffer, operand_shape, indices_buffer,
+      indices_shape, updates_buffer, updates_shape, output_buffer,
+      output_shape, combiner, indices_are_sorted, unique_indices, update_row));
+}
+
+ScatterThunk::ScatterThunk(
+    Info info, BufferAllocation::Slice operand_buffer,
+    const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+    const Shape& indices_shape, BufferAllocation::Slice updates_buffer,
+    const Shape& updates_shape, BufferAllocation::Slice output_buffer,
+    const Shape& output_shape, Combiner combiner, bool indices_are_sorted,
+    bool unique_indices, UpdateRowFn update_row)
+    : Thunk(Kind::kScatter, std::move(info)),
+      operand_buffer_(operand_buffer),
+      operand_shape_(operand_shape),
+      indices_buffer_(indices_buffer),
+      indices_shape_(indices_shape),
+      updates_buffer_(updates_buffer),
+      updates_shape_(updates_shape),
+      output_buffer_(output_buffer),
+      output_shape_(output_shape),
+      combiner_(combiner),
+      indices_are_sorted_(indices_are_sorted),
+      unique_indices_(unique_indices),
+      update_row_(update_row),
+      num_rows_(operand_shape_.dimensions(0)),
+      num_updates_(ShapeUtil::ElementsIn(indices_shape_)),
+      row_size_in_bytes_(num_updates_ == 0
+                             ? 0
+                             : ShapeUtil::ByteSizeOf(updates_shape_) /
+                                   num_updates_) {}
+
+template <typename IndexType>
+tsl::AsyncValueRef<Thunk::ExecuteEvent> ScatterThunk::ExecuteTyped(
+    const ExecuteParams& params, std::byte* output, const std::byte* updates,
+    const IndexType* indices) {
+  int64_t num_rows = num_rows_;
+  int64_t num_updates = num_updates_;
+  int64_t row_size = row_size_in_bytes_;
+  UpdateRowFn update_row = update_row_;
+
+  // Applies updates in the [begin, end) range to the output rows in the
+  // [row_begin, row_end) range, and skips all other updates.
+  auto scatter_rows = [=](int64_t begin, int64_t end, int64_t row_begin,
+                          int64_t row_end) {
+    for (int64_t i = begin; i < end; ++i) {
+      int64_t row = indices[i];
+      if (row < row_begin || row >= row_end) continue;
+      update_row(output + row * row_size, updates + i * row_size, row_size);
+    }
+  };
+
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+  int64_t num_tasks =
+      CeilOfRatio(num_updates * row_size, kMinParallelScatterTaskSize);
+
+  if (device == nullptr || num_tasks <= 1) {
+    scatter_rows(0, num_updates, 0, num_rows);
+    return OkExecuteEvent();
+  }
+
+  // With unique indices updates never write to the same row, and we can split
+  // updates into independent blocks.
+  if (unique_indices_) {
+    num_tasks = std::min(num_tasks, num_updates);
+    int64_t task_size = CeilOfRatio(num_updates, num_tasks);
+    int64_t num_workers = std::min<int64_t>(num_tasks, device->numThreads());
+
+    return Worker::Parallelize(
+        device, num_workers, num_tasks, [=](size_t task_index) {
+          int64_t begin = task_index * task_size;
+          scatter_rows(begin, std::min(begin + task_size, num_updates), 0,
+                       num_rows);
+        });
+  }
+
+  // Otherwise split output rows between tasks. Each task reads all indices, so
+  // we don't create more tasks than we have threads.
+  num_tasks = std::min({num_tasks, num_rows,
+                        static_cast<int64_t>(device->numThreads())});
+  if (num_tasks <= 1) {
+    scatter_rows(0, num_updates, 0, num_rows);
+    return OkExecuteEvent();
+  }
+
+  int64_t rows_per_task = CeilOfRatio(num_rows, num_tasks);
+  bool indices_are_sorted = indices_are_sorted_;
+
+  return Worker::Parallelize(
+      device, num_tasks, num_tasks, [=](size_t task_index) {
+        int64_t row_begin = task_index * rows_per_task;
+        int64_t row_end = std::min(row_begin + rows_per_task, num_rows);
+
+        int64_t begin = 0;
+        int64_t end = num_updates;
+
+        // For sorted indices updates for the row range are contiguous.
+        if (indices_are_sorted) {
+          auto less = [](IndexType index, int64_t row) { return index < row; };
+          begin = std::lower_bound(indices, indices + num_updates, row_begin,
+                                   less) -
+                  indices;
+          end = std::lower_bound(indices + begin, indices + num_updates,
+                                 row_end, less) -
+                indices;
+        }
+
+        scatter_rows(begin, end, row_begin, row_end);
+      });
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent> ScatterThunk::Execute(
+    const ExecuteParams& params) {
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase operand_data,
+      params.buffer_allocations->GetDeviceAddress(operand_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase indices_data,
+      params.buffer_allocations->GetDeviceAddress(indices_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase updates_data,
+      params.buffer_allocations->GetDeviceAddress(updates_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output_data,
+      params.buffer_allocations->GetDeviceAddress(output_buffer_));
+
+  // If scatter is not updating operand in place, copy it to the output first.
+  if (operand_data.opaque() != output_data.opaque()) {
+    std::memcpy(output_data.opaque(), operand_data.opaque(),
+                ShapeUtil::ByteSizeOf(output_shape_));
+  }
+
+  // Nothing to scatter if there are no updates or rows are empty.
+  if (num_updates_ == 0 || row_size_in_bytes_ == 0) {
+    return OkExecuteEvent();
+  }
+
+  auto* output = reinterpret_cast<std::byte*>(output_data.opaque());
+  auto* updates = reinterpret_cast<const std::byte*>(updates_data.opaque());
+
+  switch (indices_shape_.element_type()) {
+    case S32:
+      return ExecuteTyped(
+          params, output, updates,
+          reinterpret_cast<const int32_t*>(indices_data.opaque()));
+    case S64:
+      return ExecuteTyped(
+          params, output, updates,
+          reinterpret_cast<const int64_t*>(indices_data.opaque()));
+    default:
+      return Internal("Unsupported scatter indices type: %s",
+                      primitive_util::LowercasePrimitiveTypeName(
+                          indices_shape_.element_type()));
+  }
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,140 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_SCATTER_THUNK_H_
+#define XLA_BACKENDS_CPU_RUNTIME_SCATTER_THUNK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/runtime/buffer_use.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+
+namespace xla::cpu {
+
+// Scatters rows of updates into rows (slices along the most major dimension)
+// of a row-major operand, and writes the result into the output buffer:
+//
+//   output[indices[i], ...] = combiner(output[indices[i], ...],
+//                                      updates[i, ...])
+//
+// Updates with out of bounds indices are skipped. This is the form of scatter
+// used by sparse updates of embedding tables.
+//
+// Scatter runs in parallel in the intra-op thread pool:
+//
+//   (1) If indices are unique, updates are split into blocks that are applied
+//       independently.
+//   (2) Otherwise every task owns a range of output rows and applies (in order)
+//       all updates that fall into its range. If indices are sorted, the task
+//       finds its updates with a binary search, otherwise it scans all indices.
+//
+// Both strategies apply updates to the same row in the original order, so the
+// result is deterministic and doesn't require atomic operations.
+class ScatterThunk final : public Thunk {
+ public:
+  enum class Combiner { kAssign, kAdd };
+
+  // Applies a row of updates to the row of the output.
+  using UpdateRowFn = void (*)(std::byte* dst, const std::byte* src,
+                               int64_t row_size_in_bytes);
+
+  static absl::StatusOr<std::unique_ptr<ScatterThunk>> Create(
+      Info info, BufferAllocation::Slice operand_buffer,
+      const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+      const Shape& indices_shape, BufferAllocation::Slice updates_buffer,
+      const Shape& updates_shape, BufferAllocation::Slice output_buffer,
+      const Shape& output_shape, Combiner combiner, bool indices_are_sorted,
+      bool unique_indices);
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final;
+
+  BufferUses buffer_uses() const final {
+    return {BufferUse::Read(operand_buffer_), BufferUse::Read(indices_buffer_),
+            BufferUse::Read(updates_buffer_), BufferUse::Write(output_buffer_)};
+  }
+
+  const BufferAllocation::Slice& operand_buffer() const {
+    return operand_buffer_;
+  }
+  const Shape& operand_shape() const { return operand_shape_; }
+
+  const BufferAllocation::Slice& indices_buffer() const {
+    return indices_buffer_;
+  }
+  const Shape& indices_shape() const { return indices_shape_; }
+
+  const BufferAllocation::Slice& updates_buffer() const {
+    return updates_buffer_;
+  }
+  const Shape& updates_shape() const { return updates_shape_; }
+
+  const BufferAllocation::Slice& output_buffer() const {
+    return output_buffer_;
+  }
+  const Shape& output_shape() const { return output_shape_; }
+
+  Combiner combiner() const { return combiner_; }
+  bool indices_are_sorted() const { return indices_are_sorted_; }
+  bool unique_indices() const { return unique_indices_; }
+
+ private:
+  ScatterThunk(Info info, BufferAllocation::Slice operand_buffer,
+               const Shape& operand_shape,
+               BufferAllocation::Slice indices_buffer,
+               const Shape& indices_shape,
+               BufferAllocation::Slice updates_buffer,
+               const Shape& updates_shape,
+               BufferAllocation::Slice output_buffer,
+               const Shape& output_shape, Combiner combiner,
+               bool indices_are_sorted, bool unique_indices,
+               UpdateRowFn update_row);
+
+  template <typename IndexType>
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteTyped(const ExecuteParams& params,
+                                                std::byte* output,
+                                                const std::byte* updates,
+                                                const IndexType* indices);
+
+  BufferAllocation::Slice operand_buffer_;
+  Shape operand_shape_;
+
+  BufferAllocation::Slice indices_buffer_;
+  Shape indices_shape_;
+
+  BufferAllocation::Slice updates_buffer_;
+  Shape updates_shape_;
+
+  BufferAllocation::Slice output_buffer_;
+  Shape output_shape_;
+
+  Combiner combiner_;
+  bool indices_are_sorted_;
+  bool unique_indices_;
+  UpdateRowFn update_row_;
+
+  int64_t num_rows_;
+  int64_t num_updates_;
+  int64_t row_size_in_bytes_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_SCATTER_THUNK_H_
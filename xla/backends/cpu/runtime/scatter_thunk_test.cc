@@ -0,0 +1,146 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/scatter_thunk.h"
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+using Combiner = ScatterThunk::Combiner;
+
+// Runs scatter thunk that updates `operand` in place.
+void RunScatter(Literal& operand, Literal& indices, Literal& updates,
+                Combiner combiner, bool indices_are_sorted,
+                bool unique_indices,
+                Eigen::ThreadPoolDevice* device = nullptr) {
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, updates);
+
+  auto [operand_alloc, indices_alloc, updates_alloc] =
+      CreateBufferAllocation(operand, indices, updates);
+  auto [operand_slice, indices_slice, updates_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, updates_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      ScatterThunk::Create({"scatter"}, operand_slice, operand.shape(),
+                           indices_slice, indices.shape(), updates_slice,
+                           updates.shape(), operand_slice, operand.shape(),
+                           combiner, indices_are_sorted, unique_indices));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+}
+
+TEST(ScatterThunkTest, ScatterAssign) {
+  auto operand = LiteralUtil::CreateR2<float>(
+      {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}, {7.0, 8.0}});
+  // Out of bounds updates are skipped, and the last update wins.
+  auto indices = LiteralUtil::CreateR1<int32_t>({2, 0, -1, 4, 2});
+  auto updates = LiteralUtil::CreateR2<float>(
+      {{10.0, 10.0}, {20.0, 20.0}, {30.0, 30.0}, {40.0, 40.0}, {50.0, 50.0}});
+
+  RunScatter(operand, indices, updates, Combiner::kAssign,
+             /*indices_are_sorted=*/false, /*unique_indices=*/false);
+
+  EXPECT_EQ(operand, LiteralUtil::CreateR2<float>(
+                         {{20.0, 20.0}, {3.0, 4.0}, {50.0, 50.0}, {7.0, 8.0}}));
+}
+
+TEST(ScatterThunkTest, ScatterAdd) {
+  auto operand = LiteralUtil::CreateR2<int32_t>({{1, 2}, {3, 4}, {5, 6}});
+  auto indices = LiteralUtil::CreateR1<int64_t>({1, 1, 3, 0});
+  auto updates =
+      LiteralUtil::CreateR2<int32_t>({{10, 10}, {20, 20}, {30, 30}, {40, 40}});
+
+  RunScatter(operand, indices, updates, Combiner::kAdd,
+             /*indices_are_sorted=*/false, /*unique_indices=*/false);
+
+  EXPECT_EQ(operand,
+            LiteralUtil::CreateR2<int32_t>({{41, 42}, {33, 34}, {5, 6}}));
+}
+
+class ScatterThunkParallelTest
+    : public testing::TestWithParam<std::tuple<bool, bool>> {};
+
+TEST_P(ScatterThunkParallelTest, ScatterAddInParallel) {
+  auto [indices_are_sorted, unique_indices] = GetParam();
+
+  static constexpr int64_t kNumRows = 1024;
+  static constexpr int64_t kRowSize = 128;
+  static constexpr int64_t kNumUpdates = 2048;
+
+  // With unique indices every row is updated at most once.
+  int64_t num_updates = unique_indices ? kNumRows : kNumUpdates;
+
+  std::vector<int64_t> indices_vector(num_updates);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices_vector[i] = (i * 7) % kNumRows;
+  }
+  if (indices_are_sorted) absl::c_sort(indices_vector);
+
+  auto operand = LiteralUtil::CreateFull<float>({kNumRows, kRowSize}, 1.0f);
+  auto indices = LiteralUtil::CreateR1<int64_t>(indices_vector);
+  auto updates = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      ShapeUtil::MakeShape(F32, {num_updates, kRowSize}),
+      [](absl::Span<const int64_t> idx) { return idx[0] + idx[1]; });
+
+  // Compute expected result with a single-threaded scatter.
+  Literal expected = operand.Clone();
+  RunScatter(expected, indices, updates, Combiner::kAdd, indices_are_sorted,
+             unique_indices);
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  RunScatter(operand, indices, updates, Combiner::kAdd, indices_are_sorted,
+             unique_indices, &device);
+
+  EXPECT_EQ(operand, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(ScatterThunkParallel, ScatterThunkParallelTest,
+                         testing::Combine(testing::Bool(), testing::Bool()));
+
+}  // namespace
+}  // namespace xla::cpu
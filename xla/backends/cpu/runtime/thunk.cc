@@ -56,6 +56,8 @@ absl::string_view Thunk::KindToString(Kind kind) {
       return "dot";
     case Kind::kFft:
       return "fft";
+    case Kind::kGather:
+      return "gather";
     case Kind::kInfeed:
       return "infeed";
     case Kind::kKernel:
@@ -68,6 +70,8 @@ absl::string_view Thunk::KindToString(Kind kind) {
       return "replica-id";
     case Kind::kRngGetAndUpdateState:
       return "rng-get-and-update-state";
+    case Kind::kScatter:
+      return "scatter";
     case Kind::kSort:
       return "sort";
     case Kind::kTopK:
@@ -71,12 +71,14 @@ class Thunk {
     kCustomCall,
     kDot,
     kFft,
+    kGather,
     kInfeed,
     kKernel,
     kOutfeed,
     kPartitionId,
     kReplicaId,
     kRngGetAndUpdateState,
+    kScatter,
     kSort,
     kTopK,
     kWhile,
@@ -42,6 +42,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -49,6 +50,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
+#include "xla/backends/cpu/runtime/scatter_thunk.h"
 #include "xla/backends/cpu/runtime/serdes_base.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -120,6 +122,8 @@ static absl::StatusOr<Thunk::Kind> ProtoThunkToThunkKind(
       return Thunk::Kind::kDot;
     case ThunkProto::ImplCase::kFftThunk:
       return Thunk::Kind::kFft;
+    case ThunkProto::ImplCase::kGatherThunk:
+      return Thunk::Kind::kGather;
     case ThunkProto::ImplCase::kInfeedThunk:
       return Thunk::Kind::kInfeed;
     case ThunkProto::ImplCase::kKernelThunk:
@@ -128,6 +132,8 @@ static absl::StatusOr<Thunk::Kind> ProtoThunkToThunkKind(
       return Thunk::Kind::kOutfeed;
     case ThunkProto::ImplCase::kRngGetAndUpdateStateThunk:
       return Thunk::Kind::kRngGetAndUpdateState;
+    case ThunkProto::ImplCase::kScatterThunk:
+      return Thunk::Kind::kScatter;
     case ThunkProto::ImplCase::kSortThunk:
       return Thunk::Kind::kSort;
     case ThunkProto::ImplCase::kTopKThunk:
@@ -620,6 +626,50 @@ static absl::Status ToProto(const OutfeedThunk& thunk, ThunkProto& proto) {
   return absl::OkStatus();
 }
 
+static absl::Status ToProto(const GatherThunk& thunk, ThunkProto& proto) {
+  GatherThunkProto* gather_thunk_proto = proto.mutable_gather_thunk();
+
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.operand_buffer(), thunk.operand_shape(),
+      gather_thunk_proto->mutable_operand_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.indices_buffer(), thunk.indices_shape(),
+      gather_thunk_proto->mutable_indices_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.output_buffer(), thunk.output_shape(),
+      gather_thunk_proto->mutable_output_buffer_shape()));
+  return absl::OkStatus();
+}
+
+static absl::Status ToProto(const ScatterThunk& thunk, ThunkProto& proto) {
+  ScatterThunkProto* scatter_thunk_proto = proto.mutable_scatter_thunk();
+
+  switch (thunk.combiner()) {
+    case ScatterThunk::Combiner::kAssign:
+      scatter_thunk_proto->set_combiner(ScatterThunkProto::ASSIGN);
+      break;
+    case ScatterThunk::Combiner::kAdd:
+      scatter_thunk_proto->set_combiner(ScatterThunkProto::ADD);
+      break;
+  }
+  scatter_thunk_proto->set_indices_are_sorted(thunk.indices_are_sorted());
+  scatter_thunk_proto->set_unique_indices(thunk.unique_indices());
+
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.operand_buffer(), thunk.operand_shape(),
+      scatter_thunk_proto->mutable_operand_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.indices_buffer(), thunk.indices_shape(),
+      scatter_thunk_proto->mutable_indices_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.updates_buffer(), thunk.updates_shape(),
+      scatter_thunk_proto->mutable_updates_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.output_buffer(), thunk.output_shape(),
+      scatter_thunk_proto->mutable_output_buffer_shape()));
+  return absl::OkStatus();
+}
+
 static absl::Status ToProto(const SortThunk& thunk, ThunkProto& proto) {
   SortThunkProto* sort_thunk_proto = proto.mutable_sort_thunk();
 
@@ -896,6 +946,10 @@ absl::StatusOr<ThunkProto> ThunkSerDesProtobuf::ToProto(
       TF_RETURN_IF_ERROR(
           ::xla::cpu::ToProto(tsl::down_cast<const DotThunk&>(thunk), proto));
       break;
+    case Thunk::Kind::kGather:
+      TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
+          tsl::down_cast<const GatherThunk&>(thunk), proto));
+      break;
     case Thunk::Kind::kInfeed:
       TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
           tsl::down_cast<const InfeedThunk&>(thunk), proto));
@@ -904,6 +958,10 @@ absl::StatusOr<ThunkProto> ThunkSerDesProtobuf::ToProto(
       TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
           tsl::down_cast<const OutfeedThunk&>(thunk), proto));
       break;
+    case Thunk::Kind::kScatter:
+      TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
+          tsl::down_cast<const ScatterThunk&>(thunk), proto));
+      break;
     case Thunk::Kind::kSort:
       TF_RETURN_IF_ERROR(
           ::xla::cpu::ToProto(tsl::down_cast<const SortThunk&>(thunk), proto));
@@ -1412,6 +1470,82 @@ static absl::StatusOr<std::unique_ptr<SortThunk>> SortThunkFromProto(
       sort_direction);
 }
 
+static absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunkFromProto(
+    const ThunkProto& proto,
+    const std::vector<BufferAllocation>& buffer_allocations) {
+  TF_ASSIGN_OR_RETURN(Thunk::Info info, ThunkInfoFromProto(proto.info()));
+
+  TF_ASSIGN_OR_RETURN(
+      auto operand_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().operand_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto indices_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().indices_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto output_slice_shape,
+      DeserializeSliceShapeFromProto(proto.gather_thunk().output_buffer_shape(),
+                                     buffer_allocations));
+
+  const auto& [operand_buffer, operand_shape] = operand_slice_shape;
+  const auto& [indices_buffer, indices_shape] = indices_slice_shape;
+  const auto& [output_buffer, output_shape] = output_slice_shape;
+
+  return GatherThunk::Create(std::move(info), operand_buffer, operand_shape,
+                             indices_buffer, indices_shape, output_buffer,
+                             output_shape);
+}
+
+static absl::StatusOr<std::unique_ptr<ScatterThunk>> ScatterThunkFromProto(
+    const ThunkProto& proto,
+    const std::vector<BufferAllocation>& buffer_allocations) {
+  TF_ASSIGN_OR_RETURN(Thunk::Info info, ThunkInfoFromProto(proto.info()));
+
+  const ScatterThunkProto& scatter_thunk_proto = proto.scatter_thunk();
+
+  TF_ASSIGN_OR_RETURN(
+      auto operand_slice_shape,
+      DeserializeSliceShapeFromProto(scatter_thunk_proto.operand_buffer_shape(),
+                                     buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto indices_slice_shape,
+      DeserializeSliceShapeFromProto(scatter_thunk_proto.indices_buffer_shape(),
+                                     buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto updates_slice_shape,
+      DeserializeSliceShapeFromProto(scatter_thunk_proto.updates_buffer_shape(),
+                                     buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto output_slice_shape,
+      DeserializeSliceShapeFromProto(scatter_thunk_proto.output_buffer_shape(),
+                                     buffer_allocations));
+
+  ScatterThunk::Combiner combiner;
+  switch (scatter_thunk_proto.combiner()) {
+    case ScatterThunkProto::ASSIGN:
+      combiner = ScatterThunk::Combiner::kAssign;
+      break;
+    case ScatterThunkProto::ADD:
+      combiner = ScatterThunk::Combiner::kAdd;
+      break;
+    default:
+      return InvalidArgument("Unsupported scatter combiner: %d",
+                             static_cast<int>(scatter_thunk_proto.combiner()));
+  }
+
+  const auto& [operand_buffer, operand_shape] = operand_slice_shape;
+  const auto& [indices_buffer, indices_shape] = indices_slice_shape;
+  const auto& [updates_buffer, updates_shape] = updates_slice_shape;
+  const auto& [output_buffer, output_shape] = output_slice_shape;
+
+  return ScatterThunk::Create(
+      std::move(info), operand_buffer, operand_shape, indices_buffer,
+      indices_shape, updates_buffer, updates_shape, output_buffer,
+      output_shape, combiner, scatter_thunk_proto.indices_are_sorted(),
+      scatter_thunk_proto.unique_indices());
+}
+
 static absl::StatusOr<std::unique_ptr<TopKThunk>> TopKThunkFromProto(
     const ThunkProto& proto,
     const std::vector<BufferAllocation>& buffer_allocations) {
@@ -1622,6 +1756,8 @@ absl::StatusOr<std::unique_ptr<Thunk>> ThunkSerDesProtobuf::FromProto(
       return DotThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kFft:
       return FftThunkFromProto(proto, *buffer_allocations_);
+    case Thunk::Kind::kGather:
+      return GatherThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kInfeed:
       return InfeedThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kKernel:
@@ -1630,6 +1766,8 @@ absl::StatusOr<std::unique_ptr<Thunk>> ThunkSerDesProtobuf::FromProto(
       return OutfeedThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kRngGetAndUpdateState:
       return RngGetAndUpdateStateThunkFromProto(proto, *buffer_allocations_);
+    case Thunk::Kind::kScatter:
+      return ScatterThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kSort:
       return SortThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kTopK:
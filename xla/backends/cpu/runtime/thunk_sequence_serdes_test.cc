@@ -39,6 +39,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -46,6 +47,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
+#include "xla/backends/cpu/runtime/scatter_thunk.h"
 #include "xla/backends/cpu/runtime/serdes_base.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -131,6 +133,7 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateCustomCallThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateDotThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateFftThunk());
+    TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateGatherThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateInfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateOutfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
@@ -138,6 +141,7 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateReplicaIdThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
                         CreateRngGetAndUpdateStateThunk());
+    TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateScatterThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateTopKThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateWhileThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateXnnDotThunk());
@@ -504,6 +508,61 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         /*delta=*/0);
   }
 
+  absl::Status AddIndicesBufferAllocation() {
+    literals_.push_back(LiteralUtil::CreateR1<int32_t>({0, 1}));
+    return buffer_allocations_.push_back(
+        CreateBufferAllocation(buffer_allocations_.size(), literals_.back()));
+  }
+
+  absl::StatusOr<std::unique_ptr<Thunk>> CreateGatherThunk() {
+    TF_RETURN_IF_ERROR(AddBufferAllocations(1));
+    TF_RETURN_IF_ERROR(AddIndicesBufferAllocation());
+    TF_RETURN_IF_ERROR(AddBufferAllocations(1));
+
+    return GatherThunk::Create(
+        Thunk::Info(),
+        /*operand_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 3]),
+        /*operand_shape=*/literals_[buffer_allocations_.size() - 3].shape(),
+        /*indices_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 2]),
+        /*indices_shape=*/literals_[buffer_allocations_.size() - 2].shape(),
+        /*output_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 1]),
+        /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape());
+  }
+
+  absl::StatusOr<std::unique_ptr<Thunk>> CreateScatterThunk() {
+    TF_RETURN_IF_ERROR(AddBufferAllocations(1));
+    TF_RETURN_IF_ERROR(AddIndicesBufferAllocation());
+    TF_RETURN_IF_ERROR(AddBufferAllocations(2));
+
+    return ScatterThunk::Create(
+        Thunk::Info(),
+        /*operand_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 4]),
+        /*operand_shape=*/literals_[buffer_allocations_.size() - 4].shape(),
+        /*indices_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 3]),
+        /*indices_shape=*/literals_[buffer_allocations_.size() - 3].shape(),
+        /*updates_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 2]),
+        /*updates_shape=*/literals_[buffer_allocations_.size() - 2].shape(),
+        /*output_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 1]),
+        /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape(),
+        /*combiner=*/ScatterThunk::Combiner::kAdd,
+        /*indices_are_sorted=*/true,
+        /*unique_indices=*/false);
+  }
+
   absl::StatusOr<std::unique_ptr<Thunk>> CreateTopKThunk() {
     TF_RETURN_IF_ERROR(AddBufferAllocations(3));
     return TopKThunk::Create(
@@ -1014,6 +1073,38 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
                          });
   }
 
+  bool VerifyGatherThunkEquality(const GatherThunk& thunk_1,
+                                 const GatherThunk& thunk_2) {
+    return VerifySliceShapeEquality(
+               thunk_1.operand_buffer(), thunk_1.operand_shape(),
+               thunk_2.operand_buffer(), thunk_2.operand_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.indices_buffer(), thunk_1.indices_shape(),
+               thunk_2.indices_buffer(), thunk_2.indices_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.output_buffer(), thunk_1.output_shape(),
+               thunk_2.output_buffer(), thunk_2.output_shape());
+  }
+
+  bool VerifyScatterThunkEquality(const ScatterThunk& thunk_1,
+                                  const ScatterThunk& thunk_2) {
+    return thunk_1.combiner() == thunk_2.combiner() &&
+           thunk_1.indices_are_sorted() == thunk_2.indices_are_sorted() &&
+           thunk_1.unique_indices() == thunk_2.unique_indices() &&
+           VerifySliceShapeEquality(
+               thunk_1.operand_buffer(), thunk_1.operand_shape(),
+               thunk_2.operand_buffer(), thunk_2.operand_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.indices_buffer(), thunk_1.indices_shape(),
+               thunk_2.indices_buffer(), thunk_2.indices_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.updates_buffer(), thunk_1.updates_shape(),
+               thunk_2.updates_buffer(), thunk_2.updates_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.output_buffer(), thunk_1.output_shape(),
+               thunk_2.output_buffer(), thunk_2.output_shape());
+  }
+
   bool VerifyTopKThunkEquality(const TopKThunk& thunk_1,
                                const TopKThunk& thunk_2) {
     return thunk_1.batch_size() == thunk_2.batch_size() &&
@@ -1292,6 +1383,10 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
       case Thunk::Kind::kFft:
         return VerifyFftThunkEquality(tsl::down_cast<const FftThunk&>(thunk_1),
                                       tsl::down_cast<const FftThunk&>(thunk_2));
+      case Thunk::Kind::kGather:
+        return VerifyGatherThunkEquality(
+            tsl::down_cast<const GatherThunk&>(thunk_1),
+            tsl::down_cast<const GatherThunk&>(thunk_2));
       case Thunk::Kind::kInfeed:
         return VerifyInfeedThunkEquality(
             tsl::down_cast<const InfeedThunk&>(thunk_1),
@@ -1320,6 +1415,10 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         return VerifyRngGetAndUpdateStateThunkEquality(
             tsl::down_cast<const RngGetAndUpdateStateThunk&>(thunk_1),
             tsl::down_cast<const RngGetAndUpdateStateThunk&>(thunk_2));
+      case Thunk::Kind::kScatter:
+        return VerifyScatterThunkEquality(
+            tsl::down_cast<const ScatterThunk&>(thunk_1),
+            tsl::down_cast<const ScatterThunk&>(thunk_2));
       case Thunk::Kind::kSort:
         return VerifySortThunkEquality(
             tsl::down_cast<const SortThunk&>(thunk_1),
@@ -15,12 +15,14 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/while_thunk.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/optimization.h"
 #include "absl/log/check.h"
@@ -31,6 +33,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk_executor.h"
 #include "xla/runtime/buffer_use.h"
@@ -41,6 +44,66 @@ limitations under the License.
 
 namespace xla::cpu {
 
+// The max number of loop iterations in the pipelined body executor.
+static constexpr int64_t kMaxPipelineWindow = 4;
+
+// The max number of thunks in the unrolled body thunk sequence, as the cost of
+// building the dependency graph grows quadratically with the number of thunks.
+static constexpr int64_t kMaxPipelinedThunks = 1024;
+
+namespace {
+
+// A thunk that forwards execution to a thunk owned by the body executor, and
+// serializes executions of the same thunk in different loop iterations with
+// an extra resource use.
+class PipelinedThunk final : public Thunk {
+ public:
+  PipelinedThunk(Thunk* thunk, std::shared_ptr<Resource> token)
+      : Thunk(thunk->kind(), thunk->info()),
+        thunk_(thunk),
+        token_(std::move(token)) {}
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final {
+    return thunk_->Execute(params);
+  }
+
+  BufferUses buffer_uses() const final { return thunk_->buffer_uses(); }
+
+  ResourceUses resource_uses() const final {
+    ResourceUses resource_uses = thunk_->resource_uses();
+    resource_uses.push_back(ResourceUse::Write(token_));
+    return resource_uses;
+  }
+
+ private:
+  Thunk* thunk_;
+  std::shared_ptr<Resource> token_;
+};
+
+}  // namespace
+
+// Creates an executor for the body thunk sequence unrolled `window` times.
+static absl::StatusOr<ThunkExecutor> CreatePipelinedBodyExecutor(
+    const ThunkExecutor& body_executor, int64_t window) {
+  const ThunkSequence& body_sequence = body_executor.thunk_sequence();
+
+  std::vector<std::shared_ptr<Resource>> tokens;
+  tokens.reserve(body_sequence.size());
+  for (size_t i = 0; i < body_sequence.size(); ++i) {
+    tokens.push_back(Resource::Create(Resource::kToken));
+  }
+
+  ThunkSequence pipelined_sequence;
+  for (int64_t iteration = 0; iteration < window; ++iteration) {
+    for (size_t i = 0; i < body_sequence.size(); ++i) {
+      pipelined_sequence.push_back(
+          std::make_unique<PipelinedThunk>(body_sequence[i].get(), tokens[i]));
+    }
+  }
+
+  return ThunkExecutor::Create(std::move(pipelined_sequence));
+}
+
 absl::StatusOr<std::unique_ptr<WhileThunk>> WhileThunk::Create(
     Info info, BufferAllocation::Slice cond_buffer, ThunkSequence cond_sequence,
     ThunkSequence body_sequence, std::optional<int64_t> trip_count) {
@@ -48,19 +111,45 @@ absl::StatusOr<std::unique_ptr<WhileThunk>> WhileThunk::Create(
                       ThunkExecutor::Create(std::move(cond_sequence)));
   TF_ASSIGN_OR_RETURN(ThunkExecutor body_executor,
                       ThunkExecutor::Create(std::move(body_sequence)));
-  return absl::WrapUnique(new WhileThunk(std::move(info), cond_buffer,
-                                         std::move(cond_executor),
-                                         std::move(body_executor), trip_count));
+
+  // Pipeline loop iterations if the unrolled body has opportunities for
+  // executing thunks from different iterations concurrently.
+  std::optional<ThunkExecutor> pipelined_body_executor;
+  int64_t pipeline_window = 1;
+
+  size_t num_body_thunks = body_executor.thunk_sequence().size();
+  if (trip_count.has_value() && num_body_thunks > 0) {
+    int64_t window = std::min({kMaxPipelineWindow, *trip_count,
+                               kMaxPipelinedThunks /
+                                   static_cast<int64_t>(num_body_thunks)});
+    if (window > 1) {
+      TF_ASSIGN_OR_RETURN(ThunkExecutor executor,
+                          CreatePipelinedBodyExecutor(body_executor, window));
+      if (!executor.is_sequential()) {
+        pipelined_body_executor = std::move(executor);
+        pipeline_window = window;
+      }
+    }
+  }
+
+  return absl::WrapUnique(new WhileThunk(
+      std::move(info), cond_buffer, std::move(cond_executor),
+      std::move(body_executor), trip_count, std::move(pipelined_body_executor),
+      pipeline_window));
 }
 
 WhileThunk::WhileThunk(Info info, BufferAllocation::Slice cond_buffer,
                        ThunkExecutor cond_executor, ThunkExecutor body_executor,
-                       std::optional<int64_t> trip_count)
+                       std::optional<int64_t> trip_count,
+                       std::optional<ThunkExecutor> pipelined_body_executor,
+                       int64_t pipeline_window)
     : Thunk(Kind::kWhile, std::move(info)),
       cond_buffer_(cond_buffer),
       cond_executor_(std::move(cond_executor)),
       body_executor_(std::move(body_executor)),
-      trip_count_(trip_count) {}
+      trip_count_(trip_count),
+      pipelined_body_executor_(std::move(pipelined_body_executor)),
+      pipeline_window_(pipeline_window) {}
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> WhileThunk::Execute(
     const ExecuteParams& params) {
@@ -86,17 +175,33 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> WhileThunk::Execute(
   return ExecuteWhileLoop(params, condition);
 }
 
+tsl::AsyncValueRef<WhileThunk::ExecuteEvent> WhileThunk::ExecuteBody(
+    const ExecuteParams& params, int64_t loop_counter, int64_t trip_count,
+    int64_t* num_iterations) {
+  if (pipelined_body_executor_.has_value() &&
+      trip_count - loop_counter >= pipeline_window_) {
+    *num_iterations = pipeline_window_;
+    return pipelined_body_executor_->Execute(params);
+  }
+
+  *num_iterations = 1;
+  return body_executor_.Execute(params);
+}
+
 tsl::AsyncValueRef<WhileThunk::ExecuteEvent> WhileThunk::ExecuteForLoop(
     const ExecuteParams& params, int64_t trip_count) {
-  for (int64_t loop_counter = 0; loop_counter < trip_count; ++loop_counter) {
-    auto body_event = body_executor_.Execute(params);
-
-    // If loop iteration has not completed yet, switch to async execution mode
-    // using `body_event` as a dependency and continue the loop iteration
-    // starting from `loop_counter + 1`.
+  for (int64_t loop_counter = 0; loop_counter < trip_count;) {
+    int64_t num_iterations = 0;
+    auto body_event =
+        ExecuteBody(params, loop_counter, trip_count, &num_iterations);
+    loop_counter += num_iterations;
+
+    // If loop iterations have not completed yet, switch to async execution
+    // mode using `body_event` as a dependency and continue the loop iteration
+    // starting from `loop_counter`.
     if (ABSL_PREDICT_FALSE(!body_event.IsAvailable())) {
-      return ExecuteAsyncForLoop(params, std::move(body_event),
-                                 loop_counter + 1, trip_count);
+      return ExecuteAsyncForLoop(params, std::move(body_event), loop_counter,
+                                 trip_count);
     }
 
     if (ABSL_PREDICT_FALSE(body_event.IsError())) {
@@ -171,14 +276,17 @@ tsl::AsyncValueRef<WhileThunk::ExecuteEvent> WhileThunk::ExecuteAsyncForLoop(
       return;
     }
 
-    for (; loop_counter < trip_count; ++loop_counter) {
-      auto body_event = body_executor_.Execute(params);
+    while (loop_counter < trip_count) {
+      int64_t num_iterations = 0;
+      auto body_event =
+          ExecuteBody(params, loop_counter, trip_count, &num_iterations);
+      loop_counter += num_iterations;
 
-      // If loop iteration has not completed yet, continue execution
-      // asynchronously starting from `loop_counter + 1`.
+      // If loop iterations have not completed yet, continue execution
+      // asynchronously starting from `loop_counter`.
       if (!body_event.IsAvailable()) {
         body_event.AndThen([loop, loop_counter](absl::Status status) {
-          (*loop)(loop_counter + 1, std::move(status));
+          (*loop)(loop_counter, std::move(status));
         });
         return;
       }
@@ -36,6 +36,13 @@ namespace xla::cpu {
 // }
 //
 // Condition buffer must be a i1 (bool) buffer that holds a loop predicate.
+//
+// If the trip count is statically known, WhileThunk also builds a pipelined
+// body executor for a window of several consecutive loop iterations. It has a
+// combined dependency graph for the unrolled body thunk sequences, in which
+// iterations are ordered only by true loop-carried dependencies (defined by
+// thunks buffer and resource uses), so that independent thunks of the next
+// iteration can overlap with the tail of the previous one.
 class WhileThunk final : public Thunk {
  public:
   static absl::StatusOr<std::unique_ptr<WhileThunk>> Create(
@@ -54,10 +61,26 @@ class WhileThunk final : public Thunk {
 
   std::optional<int64_t> trip_count() const { return trip_count_; }
 
+  // Returns the executor for `pipeline_window()` unrolled loop iterations, or
+  // nullptr if the while loop is not pipelined.
+  const ThunkExecutor* pipelined_body_executor() const {
+    return pipelined_body_executor_ ? &*pipelined_body_executor_ : nullptr;
+  }
+  int64_t pipeline_window() const { return pipeline_window_; }
+
  private:
   WhileThunk(Info info, BufferAllocation::Slice cond_buffer,
              ThunkExecutor cond_executor, ThunkExecutor body_executor,
-             std::optional<int64_t> trip_count);
+             std::optional<int64_t> trip_count,
+             std::optional<ThunkExecutor> pipelined_body_executor,
+             int64_t pipeline_window);
+
+  // Executes the body for the loop iterations starting from `loop_counter`,
+  // and returns the number of executed iterations in `num_iterations`.
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteBody(const ExecuteParams& params,
+                                               int64_t loop_counter,
+                                               int64_t trip_count,
+                                               int64_t* num_iterations);
 
   tsl::AsyncValueRef<ExecuteEvent> ExecuteForLoop(const ExecuteParams& params,
                                                   int64_t trip_count);
@@ -86,6 +109,11 @@ class WhileThunk final : public Thunk {
   // execute `cond_executor_` and simply call `body_executor_` `trip_count`
   // times (effectively converting while loop into a for loop).
   std::optional<int64_t> trip_count_;
+
+  // Executor for the body thunk sequence unrolled `pipeline_window_` times.
+  // Thunks are owned by `body_executor_`.
+  std::optional<ThunkExecutor> pipelined_body_executor_;
+  int64_t pipeline_window_;
 };
 
 }  // namespace xla::cpu
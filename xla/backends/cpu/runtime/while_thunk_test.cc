@@ -237,5 +237,71 @@ TEST(WhileThunkTest, NonBlockingExecuteWithTripCount) {
   EXPECT_EQ(counter, LiteralUtil::CreateR0<int32_t>(kNumIterations));
 }
 
+// Increments the first element of the buffer.
+class IncrementThunk : public Thunk {
+ public:
+  explicit IncrementThunk(BufferAllocation::Slice slice)
+      : Thunk(Kind::kKernel, {"increment"}), slice_(slice) {}
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final {
+    TF_ASSIGN_OR_RETURN(se::DeviceMemoryBase mem,
+                        params.buffer_allocations->GetDeviceAddress(slice_));
+    ++*reinterpret_cast<int32_t*>(mem.opaque());
+    return OkExecuteEvent();
+  }
+
+  BufferUses buffer_uses() const final { return {BufferUse::Write(slice_)}; }
+
+ private:
+  BufferAllocation::Slice slice_;
+};
+
+TEST(WhileThunkTest, PipelinedForLoop) {
+  static constexpr size_t kNumIterations = 10;
+
+  // Use buffers large enough to make thunk executor run thunks concurrently.
+  auto pred = LiteralUtil::CreateR0<bool>(false);
+  auto c0 = LiteralUtil::CreateFull<int32_t>({1024}, 0);
+  auto c1 = LiteralUtil::CreateFull<int32_t>({1024}, 0);
+  auto c2 = LiteralUtil::CreateFull<int32_t>({1024}, 0);
+
+  BufferAllocations allocations = CreateBufferAllocations(pred, c0, c1, c2);
+
+  auto [pred_alloc, c0_alloc, c1_alloc, c2_alloc] =
+      CreateBufferAllocation(pred, c0, c1, c2);
+  auto [pred_slice, c0_slice, c1_slice, c2_slice] =
+      CreateBufferAllocationSlice(pred_alloc, c0_alloc, c1_alloc, c2_alloc);
+
+  // Three independent loop-carried counters.
+  ThunkSequence body_sequence;
+  body_sequence.push_back(std::make_unique<IncrementThunk>(c0_slice));
+  body_sequence.push_back(std::make_unique<IncrementThunk>(c1_slice));
+  body_sequence.push_back(std::make_unique<IncrementThunk>(c2_slice));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, WhileThunk::Create(
+                      {"while"}, pred_slice, ThunkSequence(),
+                      std::move(body_sequence), /*trip_count=*/kNumIterations));
+
+  ASSERT_NE(thunk->pipelined_body_executor(), nullptr);
+  EXPECT_GT(thunk->pipeline_window(), 1);
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "while-test", 8);
+  Eigen::ThreadPoolDevice device(thread_pool.AsEigenThreadPool(),
+                                 thread_pool.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(c0.data<int32_t>()[0], kNumIterations);
+  EXPECT_EQ(c1.data<int32_t>()[0], kNumIterations);
+  EXPECT_EQ(c2.data<int32_t>()[0], kNumIterations);
+}
+
 }  // namespace
 }  // namespace xla::cpu
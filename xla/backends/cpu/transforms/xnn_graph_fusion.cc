@@ -18,31 +18,97 @@ limitations under the License.
 #include <cstdint>
 #include <string>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/status/statusor.h"
 #include "xla/backends/cpu/xnn_fusion.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
 #include "xla/service/cpu/backend_config.pb.h"
+#include "xla/service/hlo_module_config.h"
 #include "xla/service/instruction_fusion.h"
+#include "xla/shape_util.h"
 #include "xla/tsl/platform/status.h"
 
 namespace xla {
 namespace cpu {
 
+// Returns true if the instruction is a dot operation supported by XNNPACK.
+static bool IsXnnDot(const HloInstruction* instr) {
+  if (instr->opcode() != HloOpcode::kDot) {
+    return false;
+  }
+  absl::StatusOr<bool> is_supported = IsXnnDotSupported(
+      instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+      instr->operand(1)->shape(), instr->shape());
+  return is_supported.ok() && *is_supported;
+}
+
+// Returns true if `operand` of the binary `user` can be an implicit broadcast.
+// XNNPACK subgraph forwards the broadcast operand as is and relies on the
+// binary op to broadcast it, which only produces the correct result shape if
+// the other operand is not broadcasted.
+static bool IsImplicitBroadcastOperand(const HloInstruction* user,
+                                       const HloInstruction* operand) {
+  switch (user->opcode()) {
+    case HloOpcode::kAdd:
+    case HloOpcode::kSubtract:
+    case HloOpcode::kMultiply:
+    case HloOpcode::kMaximum:
+      break;
+    default:
+      return false;
+  }
+  const HloInstruction* other =
+      user->operand(0) == operand ? user->operand(1) : user->operand(0);
+  return other != operand && other->opcode() != HloOpcode::kBroadcast &&
+         ShapeUtil::SameDimensions(other->shape(), user->shape());
+}
+
+// Returns true if the broadcast `operand_index` of `consumer` can be fused
+// into it. For XNN fusions checks all users of the fused parameter.
+static bool CanFuseImplicitBroadcast(const HloInstruction* consumer,
+                                     int64_t operand_index) {
+  if (consumer->opcode() != HloOpcode::kFusion) {
+    return IsImplicitBroadcastOperand(consumer,
+                                      consumer->operand(operand_index));
+  }
+  const HloInstruction* parameter = consumer->fused_parameter(operand_index);
+  return absl::c_all_of(parameter->users(), [&](const HloInstruction* user) {
+    return IsImplicitBroadcastOperand(user, parameter);
+  });
+}
+
 FusionDecision XnnGraphFusion::ShouldFuse(HloInstruction* consumer,
                                           int64_t operand_index) {
   if (!IsXnnGraphFusion(consumer)) {
-    if (!(consumer->IsRoot() && IsOpSupported(consumer)))
+    if (!(IsOpSupported(consumer) &&
+          (consumer->IsRoot() || IsDotEpilogue(consumer))))
       return FusionDecision::Forbid("Unsupported consumer");
   }
 
   HloInstruction* producer = consumer->mutable_operand(operand_index);
   if (!(producer->opcode() == HloOpcode::kParameter ||
-        producer->opcode() == HloOpcode::kConstant || IsOpSupported(producer)))
+        producer->opcode() == HloOpcode::kConstant || IsOpSupported(producer) ||
+        IsXnnImplicitBroadcast(producer) || IsXnnDot(producer)))
     return FusionDecision::Forbid("Unsupported producer");
 
+  // XNNPACK reads constant literals directly as row-major tensors.
+  if (producer->opcode() == HloOpcode::kConstant &&
+      !LayoutUtil::IsMonotonicWithDim0Major(producer->shape().layout()))
+    return FusionDecision::Forbid("Constant is not row-major");
+
+  if (producer->opcode() == HloOpcode::kBroadcast &&
+      !CanFuseImplicitBroadcast(consumer, operand_index))
+    return FusionDecision::Forbid("Broadcast is not a binary op operand");
+
+  // Never duplicate dot operations into multiple fusions.
+  if (producer->opcode() == HloOpcode::kDot && producer->user_count() > 1)
+    return FusionDecision::Forbid("Dot has multiple users");
+
   return FusionDecision::Allow();
 }
 
@@ -71,10 +137,27 @@ bool XnnGraphFusion::IsOpSupported(HloInstruction* instr) const {
     case HloOpcode::kSubtract:
     case HloOpcode::kMultiply:
       return true;
+    case HloOpcode::kMaximum:
+      // XNNPACK maximum does not propagate NaNs.
+      return instr->GetModule()
+          ->config()
+          .debug_options()
+          .xla_cpu_enable_fast_min_max();
     default:
       return false;
   }
 }
+
+bool XnnGraphFusion::IsDotEpilogue(HloInstruction* instr) const {
+  if (!IsOpSupported(instr)) {
+    return false;
+  }
+  return absl::c_any_of(instr->operands(), [&](HloInstruction* operand) {
+    if (operand->user_count() != 1) return false;
+    return IsXnnDot(operand) || IsDotEpilogue(operand);
+  });
+}
+
 bool XnnGraphFusion::IsXnnGraphFusion(const HloInstruction* instr) const {
   if (instr->opcode() != HloOpcode::kFusion) {
     return false;
@@ -41,6 +41,12 @@ class XnnGraphFusion : public InstructionFusion {
 
   bool IsOpSupported(HloInstruction* instr) const;
 
+  // Returns true if `instr` is an elementwise op that (transitively) consumes
+  // the result of a dot supported by XNNPACK, i.e. it is a part of the dot
+  // epilogue (bias add, activation, residual add) that can be applied to the
+  // dot result inside the same XNNPACK subgraph.
+  bool IsDotEpilogue(HloInstruction* instr) const;
+
   bool IsXnnGraphFusion(const HloInstruction* instr) const;
 };
 
@@ -67,5 +67,170 @@ ENTRY entry {
   EXPECT_EQ(backend_config.fusion_config().kind(), kXnnFusionKind);
 }
 
+TEST_F(XnnGraphFusionTest, DotEpilogueFusion) {
+  std::string hlo_string = R"(
+HloModule DotEpilogue
+
+ENTRY entry {
+   %lhs = f32[64,64]{1,0} parameter(0)
+   %rhs = f32[64,64]{1,0} parameter(1)
+   %bias = f32[64]{0} parameter(2)
+   %dot = f32[64,64]{1,0} dot(%lhs, %rhs), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %bias.broadcast = f32[64,64]{1,0} broadcast(%bias), dimensions={1}
+   %add = f32[64,64]{1,0} add(%dot, %bias.broadcast)
+   %zero = f32[] constant(0)
+   %zero.broadcast = f32[64,64]{1,0} broadcast(%zero), dimensions={}
+   %relu = f32[64,64]{1,0} maximum(%add, %zero.broadcast)
+   ROOT %result = f32[64,64]{1,0} negate(%relu)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  module->mutable_config()
+      .mutable_debug_options()
+      .set_xla_cpu_enable_fast_min_max(true);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+
+  // The whole dot epilogue is fused with the dot, but not the unsupported
+  // negate consumer.
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, op::Negate(op::Fusion()));
+
+  HloFusionInstruction* fusion = Cast<HloFusionInstruction>(root->operand(0));
+  EXPECT_EQ(fusion->operand_count(), 3);
+  TF_ASSERT_OK_AND_ASSIGN(auto backend_config,
+                          fusion->backend_config<BackendConfig>());
+  EXPECT_EQ(backend_config.fusion_config().kind(), kXnnFusionKind);
+  EXPECT_THAT(fusion->fused_expression_root(),
+              op::Maximum(op::Add(op::Dot(), op::Broadcast(op::Parameter())),
+                          op::Broadcast(op::Constant())));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotFuseMaximumWithoutFastMinMax) {
+  std::string hlo_string = R"(
+HloModule DotEpilogue
+
+ENTRY entry {
+   %lhs = f32[64,64]{1,0} parameter(0)
+   %rhs = f32[64,64]{1,0} parameter(1)
+   %bias = f32[64]{0} parameter(2)
+   %dot = f32[64,64]{1,0} dot(%lhs, %rhs), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %bias.broadcast = f32[64,64]{1,0} broadcast(%bias), dimensions={1}
+   %add = f32[64,64]{1,0} add(%dot, %bias.broadcast)
+   %zero = f32[] constant(0)
+   %zero.broadcast = f32[64,64]{1,0} broadcast(%zero), dimensions={}
+   ROOT %relu = f32[64,64]{1,0} maximum(%add, %zero.broadcast)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  module->mutable_config()
+      .mutable_debug_options()
+      .set_xla_cpu_enable_fast_min_max(false);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+
+  // XNNPACK maximum does not propagate NaNs, and stays outside of the fusion.
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, op::Maximum(op::Fusion(), op::Broadcast()));
+  EXPECT_THAT(root->operand(0)->fused_expression_root(),
+              op::Add(op::Dot(), op::Broadcast(op::Parameter())));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotFuseBroadcastsIntoSameBinaryOp) {
+  std::string hlo_string = R"(
+HloModule BroadcastAdd
+
+ENTRY entry {
+   %a = f32[64]{0} parameter(0)
+   %b = f32[64]{0} parameter(1)
+   %a.broadcast = f32[64,64]{1,0} broadcast(%a), dimensions={1}
+   %b.broadcast = f32[64,64]{1,0} broadcast(%b), dimensions={1}
+   ROOT %add = f32[64,64]{1,0} add(%a.broadcast, %b.broadcast)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  EXPECT_FALSE(changed);
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              op::Add(op::Broadcast(), op::Broadcast()));
+}
+
+TEST_F(XnnGraphFusionTest, FuseBroadcastNextToFullShapeOperand) {
+  std::string hlo_string = R"(
+HloModule BroadcastAdd
+
+ENTRY entry {
+   %a = f32[64]{0} parameter(0)
+   %b = f32[64,64]{1,0} parameter(1)
+   %a.broadcast = f32[64,64]{1,0} broadcast(%a), dimensions={1}
+   ROOT %add = f32[64,64]{1,0} add(%a.broadcast, %b)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_THAT(root, op::Fusion());
+  EXPECT_THAT(root->fused_expression_root(),
+              op::Add(op::Broadcast(op::Parameter()), op::Parameter()));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotFuseColumnMajorConstant) {
+  std::string hlo_string = R"(
+HloModule ColumnMajorConstant
+
+ENTRY entry {
+   %a = f32[2,3]{1,0} parameter(0)
+   %b = f32[2,3]{1,0} parameter(1)
+   %c = f32[2,3]{0,1} constant({{1, 2, 3}, {4, 5, 6}})
+   %add = f32[2,3]{1,0} add(%a, %b)
+   ROOT %mul = f32[2,3]{1,0} multiply(%add, %c)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_THAT(root, op::Fusion());
+  EXPECT_THAT(root->operands(), ::testing::Contains(op::Constant()));
+  EXPECT_THAT(root->fused_expression_root(),
+              op::Multiply(op::Add(), op::Parameter()));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotDuplicateDot) {
+  std::string hlo_string = R"(
+HloModule DotWithMultipleUsers
+
+ENTRY entry {
+   %lhs = f32[64,64]{1,0} parameter(0)
+   %rhs = f32[64,64]{1,0} parameter(1)
+   %dot = f32[64,64]{1,0} dot(%lhs, %rhs), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %add = f32[64,64]{1,0} add(%dot, %lhs)
+   ROOT %result = (f32[64,64]{1,0}, f32[64,64]{1,0}) tuple(%dot, %add)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
 #include "xla/primitive_util.h"
 #include "xla/shape.h"
 #include "xla/tsl/platform/logging.h"
@@ -67,6 +68,8 @@ static absl::StatusOr<xnn_binary_operator> XnnBinaryOperator(
       return xnn_binary_multiply;
     case HloOpcode::kSubtract:
       return xnn_binary_subtract;
+    case HloOpcode::kMaximum:
+      return xnn_binary_maximum;
     default:
       return InvalidArgument("Unsupported XNNPACK binary operator: %s",
                              HloOpcodeString(opcode));
@@ -139,6 +142,47 @@ static absl::StatusOr<uint32_t> DefineParameter(xnn_subgraph_t subgraph,
   return tensor_id;
 }
 
+static absl::StatusOr<uint32_t> DefineConstant(xnn_subgraph_t subgraph,
+                                               const HloInstruction* constant) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for constant: %s",
+                                constant->ToString());
+
+  // XNNPACK tensors are row-major, and the constant data is passed as is.
+  if (!LayoutUtil::IsMonotonicWithDim0Major(constant->shape().layout())) {
+    return InvalidArgument("Unsupported XNNPACK constant layout: %s",
+                           constant->ToString());
+  }
+
+  auto dims = XnnDimensions(constant->shape());
+  TF_ASSIGN_OR_RETURN(auto type,
+                      XnnDatatype(constant->shape().element_type()));
+
+  // Constant literal is owned by the HLO module, which outlives the XNNPACK
+  // subgraph built from the fusion computation.
+  uint32_t tensor_id = XNN_INVALID_VALUE_ID;
+  XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
+      subgraph, type, dims.size(), dims.data(),
+      constant->literal().untyped_data(),
+      /*external_id=*/XNN_INVALID_VALUE_ID, /*flags=*/0, &tensor_id));
+
+  return tensor_id;
+}
+
+static absl::StatusOr<uint32_t> DefineBroadcast(TensorIdMap& tensor_ids,
+                                                const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for broadcast: %s",
+                                instr->ToString());
+
+  // XNNPACK binary operators broadcast their operands implicitly, so we forward
+  // the operand tensor instead of materializing the broadcasted value.
+  if (!IsXnnImplicitBroadcast(instr)) {
+    return InvalidArgument("Unsupported XNNPACK broadcast: %s",
+                           instr->ToString());
+  }
+
+  return FindTensorValue(tensor_ids, instr->operand(0));
+}
+
 static absl::StatusOr<uint32_t> DefineBinaryOp(xnn_subgraph_t subgraph,
                                                TensorIdMap& tensor_ids,
                                                const HloInstruction* instr) {
@@ -225,9 +269,20 @@ static absl::StatusOr<xnn_subgraph_t> EmitXnnSubgraph(
                             DefineParameter(subgraph, instr));
       } break;
 
+      case HloOpcode::kConstant: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineConstant(subgraph, instr));
+      } break;
+
+      case HloOpcode::kBroadcast: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineBroadcast(tensor_ids, instr));
+      } break;
+
       case HloOpcode::kAdd:
       case HloOpcode::kSubtract:
-      case HloOpcode::kMultiply: {
+      case HloOpcode::kMultiply:
+      case HloOpcode::kMaximum: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
                             DefineBinaryOp(subgraph, tensor_ids, instr));
       } break;
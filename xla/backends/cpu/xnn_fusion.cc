@@ -24,6 +24,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/platform/statusor.h"
@@ -104,4 +105,26 @@ absl::StatusOr<bool> IsXnnDotSupported(
          !dot_canonical_dims.rhs_column_major;
 }
 
+bool IsXnnImplicitBroadcast(const HloInstruction* hlo) {
+  if (hlo->opcode() != HloOpcode::kBroadcast) {
+    return false;
+  }
+
+  const Shape& in_shape = hlo->operand(0)->shape();
+  const Shape& out_shape = hlo->shape();
+
+  // XNNPACK tensors are dense row-major arrays.
+  if (!LayoutUtil::IsMonotonicWithDim0Major(in_shape.layout()) ||
+      !LayoutUtil::IsMonotonicWithDim0Major(out_shape.layout())) {
+    return false;
+  }
+
+  // Operand dimensions must map to the trailing dimensions of the result.
+  int64_t offset = out_shape.rank() - in_shape.rank();
+  for (int64_t i = 0; i < in_shape.rank(); ++i) {
+    if (hlo->dimensions(i) != offset + i) return false;
+  }
+  return true;
+}
+
 }  // namespace xla::cpu
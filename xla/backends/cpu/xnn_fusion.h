@@ -39,6 +39,13 @@ absl::StatusOr<bool> IsXnnDotSupported(
     const DotDimensionNumbers& dot_dimensions, const Shape& lhs_shape,
     const Shape& rhs_shape, const Shape& out_shape);
 
+// Returns true if the broadcast instruction only adds major (leading)
+// dimensions to a row-major operand. Such broadcasts match XNNPACK implicit
+// (NumPy-style) broadcasting of binary operands, and can be fused into XNNPACK
+// subgraphs without materializing the broadcasted value, e.g. a bias vector
+// added to the result of a dot operation.
+bool IsXnnImplicitBroadcast(const HloInstruction* hlo);
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_XNN_FUSION_H_
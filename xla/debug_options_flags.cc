@@ -89,6 +89,8 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
 #endif
   opts.set_xla_cpu_use_thunk_runtime(true);
   opts.set_xla_cpu_use_xnnpack(false);
+  opts.set_xla_cpu_experimental_fusion_mode(
+      DebugOptions::CPU_FUSION_MODE_DEFAULT);
   opts.set_xla_cpu_experimental_xnn_graph_fusion_mode(
       DebugOptions::XNN_GRAPH_FUSION_MODE_DISABLED);
   opts.set_xla_cpu_parallel_codegen_split_count(32);
@@ -96,6 +98,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_cpu_enable_concurrency_optimized_scheduler(true);
   opts.set_xla_cpu_prefer_vector_width(256);
   opts.set_xla_cpu_max_isa("");
+  opts.set_xla_cpu_multi_versioned_isas("");
 
   opts.set_xla_cpu_enable_fast_math(false);
   // Disable forms of fast math that have caused users problems in the past.
@@ -674,6 +677,18 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
     return absl::StrJoin(collective_ops, ", ", Formatter());
   };
 
+  // Custom parser for `xla_cpu_experimental_fusion_mode` flag.
+  auto setter_for_xla_cpu_experimental_fusion_mode =
+      [debug_options](absl::string_view input) {
+        DebugOptions::CpuFusionMode mode;
+        if (!DebugOptions::CpuFusionMode_Parse(absl::AsciiStrToUpper(input),
+                                               &mode)) {
+          return false;
+        }
+        debug_options->set_xla_cpu_experimental_fusion_mode(mode);
+        return true;
+      };
+
   // Custom parser for `xla_cpu_xnn_graph_fusion_mode` flag.
   auto setter_for_xla_cpu_experimental_xnn_graph_fusion_mode =
       [debug_options](absl::string_view input) {
@@ -954,6 +969,16 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 bool_setter_for(&DebugOptions::set_xla_cpu_use_xnnpack),
                 debug_options->xla_cpu_use_xnnpack(),
                 "Use XNNPACK for supported operations."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_fusion_mode",
+      setter_for_xla_cpu_experimental_fusion_mode,
+      DebugOptions::CpuFusionMode_Name(
+          debug_options->xla_cpu_experimental_fusion_mode()),
+      "Controls XLA:CPU fusion decisions. "
+      "`CPU_FUSION_MODE_DEFAULT` - default value, fixed fusion heuristics, "
+      "`CPU_FUSION_MODE_COST_MODEL` - fuse instructions and create sibling "
+      "multi-output fusions only when the cache-aware cost model predicts a "
+      "speedup."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_experimental_xnn_graph_fusion_mode",
       setter_for_xla_cpu_experimental_xnn_graph_fusion_mode,
@@ -995,6 +1020,15 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "use newer instructions. Available values: SSE4_2, AVX, AVX2, AVX512, "
       "AVX512_VNNI, AVX512_BF16, AMX, and AMX_FP16. (`AMX` will enable both "
       "`AMX_BF16` and `AMX_INT8` instructions.)"));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_multi_versioned_isas",
+      uppercase_string_setter_for(
+          &DebugOptions::set_xla_cpu_multi_versioned_isas),
+      debug_options->xla_cpu_multi_versioned_isas(),
+      "Comma-separated list of ISAs (in the `xla_cpu_max_isa` format) for "
+      "which XLA:CPU additionally compiles all kernels, e.g. `AVX2,AVX512`. "
+      "Exported executables carry machine code for every listed ISA, and pick "
+      "the newest one supported by the host CPU at load time."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_crash_on_verification_failures",
       bool_setter_for(
@@ -575,10 +575,14 @@ absl::Status CallFrame::UpdateWithBuffers(
   return absl::OkStatus();
 }
 
+CallFrame CallFrame::Copy() const {
+  return CallFrame(CopyArgs(*arguments_), CopyRets(*results_), attributes_);
+}
+
 absl::StatusOr<CallFrame> CallFrame::CopyWithBuffers(
     absl::Span<const se::DeviceMemoryBase> args,
     absl::Span<const se::DeviceMemoryBase> rets) {
-  CallFrame clone(CopyArgs(*arguments_), CopyRets(*results_), attributes_);
+  CallFrame clone = Copy();
   TF_RETURN_IF_ERROR(clone.UpdateWithBuffers(args, rets));
   return clone;
 }
@@ -154,6 +154,11 @@ class CallFrame {
   absl::Status UpdateWithBuffers(absl::Span<const se::DeviceMemoryBase> args,
                                  absl::Span<const se::DeviceMemoryBase> rets);
 
+  // Creates a copy of the call frame that shares attributes with *this. The
+  // copy owns its arguments and results, and can be updated with new device
+  // memory pointers in place with `UpdateWithBuffers` without allocations.
+  CallFrame Copy() const;
+
   // Creates a copy of the call frame with updated arguments and results.
   absl::StatusOr<CallFrame> CopyWithBuffers(
       absl::Span<const se::DeviceMemoryBase> args,
@@ -108,6 +108,56 @@ TEST(CallFrameTest, UpdateCallFrame) {
   }
 }
 
+TEST(CallFrameTest, CopyCallFrame) {
+  se::DeviceMemoryBase mem0(reinterpret_cast<void*>(0x12345678), 1024);
+  se::DeviceMemoryBase mem1(reinterpret_cast<void*>(0x87654321), 1024);
+
+  std::vector<int64_t> dims = {1, 2, 3, 4};
+
+  CallFrameBuilder::AttributesBuilder attrs_builder;
+  attrs_builder.Insert("attr1", "value1");
+
+  CallFrameBuilder builder(/*num_args=*/1, /*num_rets=*/1);
+  builder.AddBufferArg(mem0, PrimitiveType::F32, dims);
+  builder.AddBufferRet(mem1, PrimitiveType::F32, dims);
+  builder.AddAttributes(attrs_builder.Build());
+
+  std::optional<CallFrame> call_frame = builder.Build();
+  CallFrame copy = call_frame->Copy();
+
+  // Updating the copy in place must not change the original call frame.
+  TF_ASSERT_OK(copy.UpdateWithBuffers({mem1}, {mem0}));
+
+  {  // Original call frame still points to the original buffers.
+    XLA_FFI_CallFrame ffi_call_frame = call_frame->Build(
+        /*api=*/nullptr, /*ctx=*/nullptr, XLA_FFI_ExecutionStage_EXECUTE);
+    EXPECT_EQ(static_cast<XLA_FFI_Buffer*>(ffi_call_frame.args.args[0])->data,
+              mem0.opaque());
+    EXPECT_EQ(static_cast<XLA_FFI_Buffer*>(ffi_call_frame.rets.rets[0])->data,
+              mem1.opaque());
+  }
+
+  // Copy must not reference any memory owned by the original call frame.
+  call_frame.reset();
+
+  {  // Construct XLA_FFI_CallFrame from the updated copy.
+    XLA_FFI_CallFrame ffi_call_frame = copy.Build(
+        /*api=*/nullptr, /*ctx=*/nullptr, XLA_FFI_ExecutionStage_EXECUTE);
+
+    EXPECT_EQ(ffi_call_frame.args.size, 1);
+    EXPECT_EQ(static_cast<XLA_FFI_Buffer*>(ffi_call_frame.args.args[0])->data,
+              mem1.opaque());
+    EXPECT_EQ(static_cast<XLA_FFI_Buffer*>(ffi_call_frame.args.args[0])->rank,
+              4);
+
+    EXPECT_EQ(ffi_call_frame.rets.size, 1);
+    EXPECT_EQ(static_cast<XLA_FFI_Buffer*>(ffi_call_frame.rets.rets[0])->data,
+              mem0.opaque());
+
+    EXPECT_EQ(ffi_call_frame.attrs.size, 1);
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Performance benchmarks below
 //===----------------------------------------------------------------------===//
@@ -884,6 +884,44 @@ HloEvaluator::HloEvaluator(int64_t max_loop_iterations)
       });
 }
 
+/* static */ bool HloEvaluator::HaveSameLinearLayout(
+    const Literal& result, absl::Span<const Literal* const> operands) {
+  const Shape& shape = result.shape();
+  if (!shape.IsArray() || !shape.is_static() ||
+      !LayoutUtil::IsDenseArray(shape)) {
+    return false;
+  }
+  return absl::c_all_of(operands, [&](const Literal* operand) {
+    const Shape& operand_shape = operand->shape();
+    return operand_shape.IsArray() && operand_shape.is_static() &&
+           LayoutUtil::IsDenseArray(operand_shape) &&
+           ShapeUtil::SameDimensions(shape, operand_shape) &&
+           LayoutUtil::MinorToMajor(shape) ==
+               LayoutUtil::MinorToMajor(operand_shape);
+  });
+}
+
+/* static */ void HloEvaluator::ForEachLinearIndexRangeParallel(
+    int64_t num_elements, absl::FunctionRef<void(int64_t, int64_t)> fn) {
+  // Don't hand out chunks that are too small to amortize the task overhead.
+  static constexpr int64_t kMinChunkSize = 4096;
+  const int64_t thread_count = ShapeUtil::GetForEachIndexParallelThreadCount();
+  const int64_t chunk_size = std::max(
+      kMinChunkSize, CeilOfRatio<int64_t>(num_elements, thread_count));
+  if (num_elements <= chunk_size) {
+    fn(0, num_elements);
+    return;
+  }
+  const Shape index_space = ShapeUtil::MakeShape(S64, {num_elements});
+  ShapeUtil::ForEachIndexParallel(
+      index_space, /*base=*/{0}, /*count=*/{num_elements},
+      /*incr=*/{chunk_size},
+      [&](absl::Span<const int64_t> indexes, int) -> absl::StatusOr<bool> {
+        fn(indexes[0], std::min(indexes[0] + chunk_size, num_elements));
+        return true;
+      });
+}
+
 absl::StatusOr<Literal> HloEvaluator::Evaluate(
     const HloComputation& computation,
     absl::Span<const Literal* const> arg_literals) {
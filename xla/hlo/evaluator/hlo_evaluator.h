@@ -36,6 +36,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/array2d.h"
@@ -461,6 +462,18 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
   bool use_fast_path_reduce_ = true;
 
  private:
+  // Returns true if `result` and all `operands` are static dense arrays with
+  // the same dimensions and the same minor-to-major order. Elementwise ops can
+  // then address every literal by linear index instead of computing a linear
+  // index from a multi-dimensional index for each element.
+  static bool HaveSameLinearLayout(const Literal& result,
+                                   absl::Span<const Literal* const> operands);
+
+  // Calls `fn(begin, end)` on contiguous chunks of the linear index space
+  // [0, num_elements), processing the chunks in parallel.
+  static void ForEachLinearIndexRangeParallel(
+      int64_t num_elements, absl::FunctionRef<void(int64_t, int64_t)> fn);
+
   template <typename ReturnT, typename NativeT>
   static absl::StatusOr<Literal> ElementWiseUnaryOpImpl(
       const HloInstruction* instruction,
@@ -471,6 +484,18 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
     TF_RET_CHECK(ShapeUtil::SameDimensions(shape, operand->shape()));
 
     Literal result(shape);
+    if (HaveSameLinearLayout(result, {&operand_literal})) {
+      absl::Span<ReturnT> result_data = result.data<ReturnT>();
+      absl::Span<const NativeT> operand_data = operand_literal.data<NativeT>();
+      ForEachLinearIndexRangeParallel(
+          result_data.size(), [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+              result_data[i] = unary_op(operand_data[i]);
+            }
+          });
+      return std::move(result);
+    }
+
     TF_RETURN_IF_ERROR(result.PopulateParallel<ReturnT>(
         [&](absl::Span<const int64_t> multi_index, int) {
           return unary_op(operand_literal.Get<NativeT>(multi_index));
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/hlo/evaluator/hlo_evaluator.h"
 
+#include <algorithm>
 #include <array>
 #include <complex>
 #include <cstdint>
@@ -375,6 +376,53 @@ TEST_F(HloEvaluatorTest, DoesAdd) {
   TestBinaryOp(HloOpcode::kAdd, std::move(expected), std::move(lhs),
                std::move(rhs));
 }
+// Verifies that element-wise ops produce the same results when operands have
+// a different layout than the result and the linear fast path can't be used.
+TEST_F(HloEvaluatorTest, DoesAddWithMismatchedLayouts) {
+  auto lhs = LiteralUtil::CreateR2<int64_t>({{1, 0, 7}, {-100, 4, 3}});
+  auto rhs = LiteralUtil::CreateR2<int64_t>({{2, 4, 1}, {4, 4, 5}})
+                 .Relayout(LayoutUtil::MakeLayout({0, 1}));
+  auto expected = LiteralUtil::CreateR2<int64_t>({{3, 4, 8}, {-96, 8, 8}});
+  TestBinaryOp(HloOpcode::kAdd, std::move(expected), std::move(lhs),
+               std::move(rhs));
+}
+
+// Verifies element-wise ops on literals large enough to be split into chunks
+// that are evaluated in parallel.
+TEST_F(HloEvaluatorTest, DoesLargeElementwiseOps) {
+  constexpr int64_t kNumElements = 100003;
+  std::vector<float> lhs(kNumElements), rhs(kNumElements),
+      expected(kNumElements);
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    lhs[i] = i;
+    rhs[i] = 2 * i;
+    expected[i] = std::max(lhs[i], rhs[i] - 7);
+  }
+  Literal lhs_literal = LiteralUtil::CreateR1<float>(lhs);
+  Literal rhs_literal = LiteralUtil::CreateR1<float>(rhs);
+
+  HloComputation::Builder b(TestName());
+  Shape shape = ShapeUtil::MakeShape(F32, {kNumElements});
+  auto c1 = b.AddInstruction(
+      HloInstruction::CreateConstant(std::move(lhs_literal)));
+  auto c2 = b.AddInstruction(
+      HloInstruction::CreateConstant(std::move(rhs_literal)));
+  auto seven = b.AddInstruction(HloInstruction::CreateBroadcast(
+      shape,
+      b.AddInstruction(
+          HloInstruction::CreateConstant(LiteralUtil::CreateR0<float>(7))),
+      {}));
+  auto sub = b.AddInstruction(
+      HloInstruction::CreateBinary(shape, HloOpcode::kSubtract, c2, seven));
+  b.AddInstruction(
+      HloInstruction::CreateBinary(shape, HloOpcode::kMaximum, c1, sub));
+  m_->AddEntryComputation(b.Build());
+
+  TF_ASSERT_OK_AND_ASSIGN(Literal result, Evaluate());
+  EXPECT_TRUE(
+      LiteralTestUtil::Equal(LiteralUtil::CreateR1<float>(expected), result));
+}
+
 // Verifies that HloEvaluator evaluates a HLO instruction that performs
 // element-wise and with 2 operands.
 TEST_P(HloEvaluatorBf16Test, DoesAnd) {
@@ -2679,6 +2727,37 @@ void BM_ReducePrecisely(::testing::benchmark::State& state) {
 
 BENCHMARK(BM_ReducePrecisely);
 
+// Constant folding of large tables is dominated by element-wise ops.
+void BM_ElementwiseOps(::testing::benchmark::State& state) {
+  const int64_t num_elements = state.range(0);
+  HloComputation::Builder b("BM_ElementwiseOps");
+  HloModuleConfig config;
+  config.set_debug_options(GetDebugOptionsFromFlags());
+  HloModule module("BM_ElementwiseOps", config);
+
+  Shape shape = ShapeUtil::MakeShape(F32, {num_elements});
+  std::vector<float> v(num_elements, 1.5f);
+  HloInstruction* lhs = b.AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::CreateR1<float>(v)));
+  HloInstruction* rhs = b.AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::CreateR1<float>(v)));
+  HloInstruction* mul = b.AddInstruction(
+      HloInstruction::CreateBinary(shape, HloOpcode::kMultiply, lhs, rhs));
+  HloInstruction* add = b.AddInstruction(
+      HloInstruction::CreateBinary(shape, HloOpcode::kAdd, mul, lhs));
+  HloInstruction* exp = b.AddInstruction(
+      HloInstruction::CreateUnary(shape, HloOpcode::kExp, add));
+  module.AddEntryComputation(b.Build());
+
+  for (auto s : state) {
+    HloEvaluator hlo_eval;
+    hlo_eval.Evaluate(exp).value();
+  }
+  state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+BENCHMARK(BM_ElementwiseOps)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+
 TEST_P(HloEvaluatorBf16Test, ReduceAdd) {
   HloComputation::Builder b(TestName());
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstring>
 #include <optional>
 #include <string>
+#include <system_error>  // NOLINT
 #include <utility>
 
 #include "absl/base/casts.h"
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/charconv.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
@@ -48,6 +50,13 @@ bool IsIdentifierChar(char c) {
          c == '.' || c == '_';
 }
 
+// Returns true if `c` may continue one of the digit-led patterns (dim labels,
+// dxd, pad) after a plain number, in which case the number fast path must
+// defer to the regular expressions in LexNumberOrPattern.
+bool MayContinueNumberPattern(char c) {
+  return IsIdentifierChar(c) || c == '?' || c == '>';
+}
+
 }  // namespace
 
 int HloLexer::GetNextChar() {
@@ -393,6 +402,10 @@ TokKind HloLexer::LexPercent() {
 // int ::=  [-]?[0-9]+
 // negative inf ::= '-inf'
 TokKind HloLexer::LexNumberOrPattern() {
+  if (std::optional<TokKind> kind = LexPlainNumber()) {
+    return *kind;
+  }
+
   absl::string_view consumable = StringViewFromPointers(
       token_state_.token_start, buf_.data() + buf_.size());
   static LazyRE2 float_pattern = {
@@ -469,6 +482,69 @@ TokKind HloLexer::LexNumberOrPattern() {
   return TokKind::kError;
 }
 
+// Fast path for the plain integer and floating-point values that make up the
+// bulk of large constant literals. Scans the token by hand and converts it in
+// place without going through RE2 or copying it into a temporary string.
+// Returns std::nullopt if the token is anything else (e.g. a pattern, -inf,
+// -nan or an out-of-range value), in which case the caller falls back to the
+// regular expression based lexing.
+std::optional<TokKind> HloLexer::LexPlainNumber() {
+  const char* begin = token_state_.token_start;
+  const char* end = buf_.data() + buf_.size();
+  const char* ptr = begin;
+
+  if (ptr != end && *ptr == '-') ++ptr;
+  const char* int_begin = ptr;
+  while (ptr != end && absl::ascii_isdigit(static_cast<unsigned char>(*ptr))) {
+    ++ptr;
+  }
+  bool has_int_digits = ptr != int_begin;
+  bool is_decimal = false;
+
+  if (ptr != end && *ptr == '.') {
+    ++ptr;
+    const char* frac_begin = ptr;
+    while (ptr != end &&
+           absl::ascii_isdigit(static_cast<unsigned char>(*ptr))) {
+      ++ptr;
+    }
+    if (!has_int_digits && ptr == frac_begin) return std::nullopt;
+    is_decimal = true;
+  } else if (!has_int_digits) {
+    return std::nullopt;
+  }
+
+  if (ptr != end && (*ptr == 'e' || *ptr == 'E')) {
+    const char* exp_ptr = ptr + 1;
+    if (exp_ptr != end && (*exp_ptr == '+' || *exp_ptr == '-')) ++exp_ptr;
+    const char* exp_digits = exp_ptr;
+    while (exp_ptr != end &&
+           absl::ascii_isdigit(static_cast<unsigned char>(*exp_ptr))) {
+      ++exp_ptr;
+    }
+    if (exp_ptr == exp_digits) return std::nullopt;
+    ptr = exp_ptr;
+    is_decimal = true;
+  }
+
+  if (ptr != end && MayContinueNumberPattern(*ptr)) return std::nullopt;
+
+  absl::string_view slice = StringViewFromPointers(begin, ptr);
+  if (is_decimal) {
+    double value;
+    absl::from_chars_result result =
+        absl::from_chars(slice.data(), slice.data() + slice.size(), value);
+    if (result.ec != std::errc() || result.ptr != ptr) return std::nullopt;
+    token_state_.decimal_val = value;
+    current_ptr_ = ptr;
+    return TokKind::kDecimal;
+  }
+
+  if (!absl::SimpleAtoi(slice, &token_state_.int64_val)) return std::nullopt;
+  current_ptr_ = ptr;
+  return TokKind::kInt;
+}
+
 std::pair<unsigned, unsigned> HloLexer::GetLineAndColumn(LocTy location) const {
   unsigned line_no = 1;
   const char* start = buf_.data();
@@ -103,7 +103,7 @@ class HloLexer {
   TokKind Lex() { return token_state_.current_kind = LexToken(); }
 
   TokKind GetKind() const { return token_state_.current_kind; }
-  std::string GetStrVal() const {
+  const std::string& GetStrVal() const {
     switch (GetKind()) {
       case TokKind::kName:
       case TokKind::kAttributeName:
@@ -179,6 +179,7 @@ class HloLexer {
   TokKind LexShape();
   TokKind LexConstant();
   TokKind LexNumberOrPattern();
+  std::optional<TokKind> LexPlainNumber();
   TokKind LexString();
 
   std::optional<int64_t> LexNanPayload(absl::string_view& consumable);
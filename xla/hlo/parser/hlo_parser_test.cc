@@ -44,6 +44,7 @@ limitations under the License.
 #include "xla/hlo/testlib/verified_hlo_module.h"
 #include "xla/layout.h"
 #include "xla/layout_util.h"
+#include "xla/literal_util.h"
 #include "xla/protobuf_util.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/pattern_matcher.h"
@@ -3265,6 +3266,19 @@ ENTRY %ConstantWithExp.v4 () -> f32[] {
   // printed as "300".
 }
 
+TEST_F(HloParserTest, ConstantDecimalForms) {
+  const std::string original = R"(
+      HloModule test_module
+      ENTRY test {
+        ROOT c = f64[8] constant({1, -2, 3., -.5, 2.5e1, -1E-1, 0.125, 7e+0})
+      })";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnUnverifiedModule(original));
+  EXPECT_EQ(module->entry_computation()->root_instruction()->literal(),
+            LiteralUtil::CreateR1<double>(
+                {1.0, -2.0, 3.0, -0.5, 25.0, -0.1, 0.125, 7.0}));
+}
+
 TEST_F(HloParserTest, ShortConstant) {
   const std::string original =
       R"(HloModule ShortConstant_module, entry_computation_layout={()->f32[67,89]{1,0}}
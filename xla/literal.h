@@ -1914,6 +1914,20 @@ TF_ATTRIBUTE_NOINLINE absl::Status MutableLiteralBase::PopulateInternal(
       << " using data of type "
       << primitive_util::LowercasePrimitiveTypeName(
              primitive_util::NativeToPrimitiveType<NativeT>());
+  if (!parallel && LayoutUtil::IsMonotonicWithDim0Major(this_shape.layout())) {
+    // Fill major-to-minor literals in linear order, advancing the index in
+    // place, instead of calling the generator through the type-erased
+    // populator of PopulateInplaceInternal() for every element.
+    DimensionVector indexes(this_shape.rank(), 0);
+    for (NativeT& value : data<NativeT>()) {
+      value = generator(indexes, /*thread_id=*/-1);
+      for (int64_t i = indexes.size() - 1; i >= 0; --i) {
+        if (++indexes[i] < this_shape.dimensions(i)) break;
+        indexes[i] = 0;
+      }
+    }
+    return absl::OkStatus();
+  }
   PopulateInplaceInternal(
       [&](void* dest, absl::Span<const int64_t> indices, int thread_id) {
         *static_cast<NativeT*>(dest) = generator(indices, thread_id);
@@ -21,9 +21,12 @@ limitations under the License.
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <set>
@@ -32,6 +35,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
@@ -173,6 +177,64 @@ absl::Status Equal(LiteralSlice expected, LiteralSlice actual,
   return result;
 }
 
+// Returns true if `expected` and `actual` are static dense arrays of the same
+// type, dimensions and layout whose buffers are bitwise identical. Floating
+// point values are compared bitwise by Equal() and bitwise identical values
+// have zero error in Near(), so such literals always compare equal and the
+// element-by-element comparison can be replaced by a single memcmp.
+bool IsBitwiseEqualDenseArray(const LiteralSlice& expected,
+                              const LiteralSlice& actual) {
+  const Shape& expected_shape = expected.shape();
+  const Shape& actual_shape = actual.shape();
+  if (!expected_shape.IsArray() || !actual_shape.IsArray() ||
+      !expected_shape.is_static() || !actual_shape.is_static() ||
+      !LayoutUtil::IsDenseArray(expected_shape) ||
+      !LayoutUtil::IsDenseArray(actual_shape) ||
+      expected_shape.element_type() != actual_shape.element_type() ||
+      !ShapeUtil::SameDimensions(expected_shape, actual_shape) ||
+      LayoutUtil::MinorToMajor(expected_shape) !=
+          LayoutUtil::MinorToMajor(actual_shape)) {
+    return false;
+  }
+  const int64_t size_bytes = expected.size_bytes();
+  return size_bytes == actual.size_bytes() &&
+         (size_bytes == 0 || std::memcmp(expected.untyped_data(),
+                                         actual.untyped_data(),
+                                         size_bytes) == 0);
+}
+
+// Returns true if both literals are static arrays with a major-to-minor
+// layout, i.e. their linear element order is the order in which Equal() above
+// visits multi-dimensional indices.
+bool HaveMajorToMinorLinearOrder(const LiteralSlice& expected,
+                                 const LiteralSlice& actual) {
+  auto is_major_to_minor = [](const Shape& shape) {
+    return shape.IsArray() && shape.is_static() &&
+           LayoutUtil::IsDenseArray(shape) &&
+           LayoutUtil::IsMonotonicWithDim0Major(shape.layout());
+  };
+  return is_major_to_minor(expected.shape()) &&
+         is_major_to_minor(actual.shape());
+}
+
+// Same as Equal() above without a `mismatched` literal, but walks the raw
+// data of literals with a major-to-minor layout by linear index and stops at
+// the first mismatch.
+template <typename NativeT>
+absl::Status EqualMajorToMinor(const LiteralSlice& expected,
+                               const LiteralSlice& actual) {
+  absl::Span<const NativeT> expected_data = expected.data<NativeT>();
+  absl::Span<const NativeT> actual_data = actual.data<NativeT>();
+  for (int64_t i = 0; i < expected_data.size(); ++i) {
+    if (!CompareEqual<NativeT>(expected_data[i], actual_data[i], {i})) {
+      return MakeErrorStatus<NativeT>(
+          expected_data[i], actual_data[i],
+          IndexUtil::LinearIndexToMultidimensionalIndex(expected.shape(), i));
+    }
+  }
+  return absl::OkStatus();
+}
+
 // Gets the total element count.  For tuples, this is not the count of tuple
 // elements, but the sum of elements of each tuple element.
 int64_t RecursiveElementCount(const Shape& shape) {
@@ -347,7 +409,7 @@ class NearComparator {
   }
 
   template <typename T>
-  int CalculateFloatDistance(T expected, T actual) {
+  int CalculateFloatDistance(T expected, T actual) const {
     if (error_.low_precision_fp_error_spec.type ==
         PrimitiveType::PRIMITIVE_TYPE_INVALID)
       return -1;
@@ -368,13 +430,26 @@ class NearComparator {
         error_.low_precision_fp_error_spec.type);
   }
 
-  // Compares the two given elements from the expected and actual literals at
-  // the given literal_index and keeps track of various mismatch statistics.
+  // Errors between a pair of expected and actual elements.
+  struct ElementError {
+    double abs_error;
+    double rel_error;
+    int float_distance = -1;
+    bool nan_mismatch = false;
+    bool is_abs_mismatch;
+    bool is_rel_mismatch;
+
+    bool is_mismatch() const { return is_abs_mismatch && is_rel_mismatch; }
+  };
+
+  // Computes the errors between the two given elements from the expected and
+  // actual literals at the given linear_index, without updating statistics.
   template <typename T>
-  void CompareValues(T expected, T actual, int64_t linear_index) {
+  ElementError ComputeError(T expected, T actual, int64_t linear_index) const {
     double abs_error;
     double rel_error;
     int float_distance = -1;
+    bool nan_mismatch = false;
     if (CompareEqual<T>(expected, actual, {linear_index})) {
       abs_error = 0;
       rel_error = 0;
@@ -384,7 +459,7 @@ class NearComparator {
         rel_error = 0;
       } else if ((!error_.relaxed_nans && IsNan(expected) != IsNan(actual)) ||
                  (error_.relaxed_nans && !IsNan(expected) && IsNan(actual))) {
-        num_nan_mismatches_++;
+        nan_mismatch = true;
         // A nan mismatch is considered to have infinite error. rel_error is
         // used for sorting a std::set of the top mismatches, and a nan value
         // here will result in undefined behavior because nan's do not satisfy
@@ -448,7 +523,41 @@ class NearComparator {
         (should_use_float_error_spec && is_within_n_floats)
             ? false
             : (rel_error > error_.rel);
-    const bool is_mismatch = is_abs_mismatch && is_rel_mismatch;
+    return {/*abs_error=*/abs_error,
+            /*rel_error=*/rel_error,
+            /*float_distance=*/float_distance,
+            /*nan_mismatch=*/nan_mismatch,
+            /*is_abs_mismatch=*/is_abs_mismatch,
+            /*is_rel_mismatch=*/is_rel_mismatch};
+  }
+
+  // Returns true if the two given elements are a mismatch, i.e. whether
+  // CompareValues() below would count them in `num_mismatches_`.
+  template <typename T>
+  bool IsMismatch(T expected, T actual, int64_t linear_index) const {
+    return ComputeError<T>(expected, actual, linear_index).is_mismatch();
+  }
+  template <typename T>
+  bool IsMismatch(std::complex<T> expected, std::complex<T> actual,
+                  int64_t linear_index) const {
+    return IsMismatch<T>(expected.real(), actual.real(), linear_index) ||
+           IsMismatch<T>(expected.imag(), actual.imag(), linear_index);
+  }
+
+  // Compares the two given elements from the expected and actual literals at
+  // the given literal_index and keeps track of various mismatch statistics.
+  template <typename T>
+  void CompareValues(T expected, T actual, int64_t linear_index) {
+    const ElementError error = ComputeError<T>(expected, actual, linear_index);
+    const double abs_error = error.abs_error;
+    const double rel_error = error.rel_error;
+    const int float_distance = error.float_distance;
+    const bool is_abs_mismatch = error.is_abs_mismatch;
+    const bool is_rel_mismatch = error.is_rel_mismatch;
+    const bool is_mismatch = error.is_mismatch();
+    if (error.nan_mismatch) {
+      num_nan_mismatches_++;
+    }
 
     // Update the error of the relative bucket only if the *absolute* error
     // bound is exceeded and vice versa.
@@ -512,6 +621,11 @@ class NearComparator {
         expected_.shape().is_static() && actual_.shape().is_static()) {
       absl::Span<const NativeT> expected_data = expected_.data<NativeT>();
       absl::Span<const NativeT> actual_data = actual_.data<NativeT>();
+      // The statistics below are only reported on failure, so skip them if
+      // there are no mismatches at all.
+      if (!HasMismatch(expected_data, actual_data)) {
+        return;
+      }
       const int64_t len = expected_data.size();
       for (int64_t i = 0; i < len; ++i) {
         CompareValues(expected_data[i], actual_data[i], i);
@@ -522,6 +636,46 @@ class NearComparator {
     CompareLiteralsSlow(0, &multi_index);
   }
 
+  // Returns true if any pair of elements in [begin, end) is a mismatch,
+  // stopping at the first one.
+  bool HasMismatch(absl::Span<const NativeT> expected_data,
+                   absl::Span<const NativeT> actual_data, int64_t begin,
+                   int64_t end) const {
+    for (int64_t i = begin; i < end; ++i) {
+      if (IsMismatch(expected_data[i], actual_data[i], i)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if any pair of elements is a mismatch. Large literals are
+  // split into blocks that are scanned in parallel.
+  bool HasMismatch(absl::Span<const NativeT> expected_data,
+                   absl::Span<const NativeT> actual_data) const {
+    const int64_t len = expected_data.size();
+    if (len < kParallelScanMinElements) {
+      return HasMismatch(expected_data, actual_data, 0, len);
+    }
+    const int64_t num_blocks = CeilOfRatio(len, kParallelScanBlockSize);
+    std::atomic<bool> has_mismatch = false;
+    ShapeUtil::ForEachIndexParallel(
+        ShapeUtil::MakeShape(PRED, {num_blocks}),
+        [&](absl::Span<const int64_t> block, int) -> absl::StatusOr<bool> {
+          // Skip the remaining blocks once a mismatch has been found.
+          if (has_mismatch.load(std::memory_order_relaxed)) {
+            return true;
+          }
+          const int64_t begin = block[0] * kParallelScanBlockSize;
+          const int64_t end = std::min(begin + kParallelScanBlockSize, len);
+          if (HasMismatch(expected_data, actual_data, begin, end)) {
+            has_mismatch.store(true, std::memory_order_relaxed);
+          }
+          return true;
+        });
+    return has_mismatch.load();
+  }
+
   // Slow path for CompareLiterals when 'actual' and 'expected' literals are
   // dynamic or have different layouts. In this case, multidimensional indices
   // are constructed and indexed for each element.
@@ -654,6 +808,11 @@ class NearComparator {
   // magnitude.
   static constexpr int64_t kTopRelativeErrorCount = 5;
 
+  // Literals with at least this many elements are scanned for mismatches in
+  // parallel, in blocks of kParallelScanBlockSize elements.
+  static constexpr int64_t kParallelScanMinElements = 1 << 20;
+  static constexpr int64_t kParallelScanBlockSize = 1 << 16;
+
   // The set of mismatches with the largest relative error. The size of this set
   // is bounded by kTopRelativeErrorCount.
   std::multiset<Mismatch> top_rel_mismatches_;
@@ -706,6 +865,10 @@ absl::Status EqualHelper(const LiteralSlice& expected,
       next_index.pop_back();
     }
   } else {
+    if (IsBitwiseEqualDenseArray(expected, actual)) {
+      return absl::OkStatus();
+    }
+
     std::vector<int64_t> multi_index(expected.shape().dimensions_size(), 0);
     auto index = absl::MakeSpan(multi_index);
 
@@ -720,6 +883,11 @@ absl::Status EqualHelper(const LiteralSlice& expected,
           if constexpr (primitive_util::IsArrayType(primitive_type_constant)) {
             using NativeT =
                 primitive_util::NativeTypeOf<primitive_type_constant>;
+            if (miscompared_ptr == nullptr &&
+                HaveMajorToMinorLinearOrder(expected, actual)) {
+              result = EqualMajorToMinor<NativeT>(expected, actual);
+              return;
+            }
             result =
                 Equal<NativeT>(expected, actual, index, 0, miscompared_ptr);
             return;
@@ -792,6 +960,9 @@ absl::Status NearHelper(const LiteralSlice& expected,
 
   if (ShapeUtil::ElementIsFloating(expected.shape()) ||
       ShapeUtil::ElementIsComplex(expected.shape())) {
+    if (IsBitwiseEqualDenseArray(expected, actual)) {
+      return absl::OkStatus();
+    }
     bool use_detailed_message = detailed_message.value_or(
         ShapeUtil::ElementsIn(expected.shape()) >= 64);
     return primitive_util::PrimitiveTypeSwitch<absl::Status>(
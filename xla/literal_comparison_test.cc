@@ -15,10 +15,18 @@ limitations under the License.
 
 #include "xla/literal_comparison.h"
 
+#include <cstdint>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "xla/error_spec.h"
 #include "xla/hlo/testlib/test_helpers.h"
+#include "xla/layout_util.h"
+#include "xla/literal.h"
 #include "xla/literal_util.h"
+#include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/ml_dtypes.h"
@@ -120,5 +128,63 @@ TYPED_TEST(LiteralComparisonTest, FloatUsingCompareNear_NotEqual_4ulps) {
                                         /*miscompare_callback=*/nullptr));
 }
 
+TEST(LiteralComparisonTest, EqualReportsFirstMismatchInRowMajorOrder) {
+  auto expected = LiteralUtil::CreateR2<int32_t>({{1, 2, 3}, {4, 5, 6}});
+  auto actual = LiteralUtil::CreateR2<int32_t>({{1, 2, 3}, {7, 5, 8}});
+  absl::Status status = literal_comparison::Equal(expected, actual);
+  ASSERT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), ::testing::HasSubstr("{1,0}"));
+
+  // Same mismatches with a column-major layout, which is compared through the
+  // multi-dimensional index walk instead of the linear scan.
+  auto expected_col_major =
+      expected.Relayout(LayoutUtil::MakeLayout({0, 1}));
+  auto actual_col_major = actual.Relayout(LayoutUtil::MakeLayout({0, 1}));
+  status = literal_comparison::Equal(expected_col_major, actual_col_major);
+  ASSERT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), ::testing::HasSubstr("{1,0}"));
+}
+
+TEST(LiteralComparisonTest, EqualAndNearWithDifferentLayouts) {
+  auto expected = LiteralUtil::CreateR2<float>({{1, 2, 3}, {4, 5, 6}});
+  auto actual = expected.Relayout(LayoutUtil::MakeLayout({0, 1}));
+  TF_EXPECT_OK(literal_comparison::Equal(expected, actual));
+  TF_EXPECT_OK(literal_comparison::Near(expected, actual, ErrorSpec(0.0, 0.0),
+                                        /*detailed_message=*/false,
+                                        /*miscompare_callback=*/nullptr));
+}
+
+TEST(LiteralComparisonTest, EqualDistinguishesSignedZeros) {
+  auto expected = LiteralUtil::CreateR1<float>({0.0f, 1.0f});
+  auto actual = LiteralUtil::CreateR1<float>({-0.0f, 1.0f});
+  EXPECT_IS_NOT_OK(literal_comparison::Equal(expected, actual));
+  TF_EXPECT_OK(literal_comparison::Near(expected, actual, ErrorSpec(0.0, 0.0),
+                                        /*detailed_message=*/false,
+                                        /*miscompare_callback=*/nullptr));
+}
+
+TEST(LiteralComparisonTest, NearLargeLiteral) {
+  // Large enough to be scanned for mismatches in parallel.
+  constexpr int64_t kNumElements = (1 << 21) + 3;
+  Literal expected(ShapeUtil::MakeShape(F32, {kNumElements}));
+  expected.PopulateWithValue(1.0f);
+  Literal actual(ShapeUtil::MakeShape(F32, {kNumElements}));
+  actual.PopulateWithValue(1.05f);
+  TF_EXPECT_OK(literal_comparison::Near(expected, actual, ErrorSpec(0.1, 0.1),
+                                        /*detailed_message=*/false,
+                                        /*miscompare_callback=*/nullptr));
+
+  for (int64_t index : {int64_t{0}, kNumElements / 2, kNumElements - 1}) {
+    Literal mismatch = actual.Clone();
+    mismatch.Set<float>({index}, 2.0f);
+    absl::Status status = literal_comparison::Near(
+        expected, mismatch, ErrorSpec(0.1, 0.1), /*detailed_message=*/false,
+        /*miscompare_callback=*/nullptr);
+    ASSERT_FALSE(status.ok());
+    EXPECT_THAT(status.message(),
+                ::testing::HasSubstr(absl::StrCat("{", index, "}")));
+  }
+}
+
 }  // namespace
 }  // namespace xla
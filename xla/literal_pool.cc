@@ -19,8 +19,10 @@ limitations under the License.
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/literal.h"
 #include "xla/shape.h"
@@ -35,10 +37,11 @@ LiteralPool* LiteralPool::Default() {
 
 // Erases expired weak pointers from the vector and returns the number of
 // elements that were erased.
-static size_t EraseExpiredLiterals(
-    std::vector<std::weak_ptr<Literal>>& literals) {
-  auto it = std::remove_if(literals.begin(), literals.end(),
-                           [](auto& ptr) { return ptr.expired(); });
+template <typename Entry>
+static size_t EraseExpiredLiterals(std::vector<Entry>& literals) {
+  auto it = std::remove_if(literals.begin(), literals.end(), [](auto& entry) {
+    return entry.literal.expired();
+  });
   size_t num_erased = std::distance(it, literals.end());
 
   literals.erase(it, literals.end());
@@ -70,45 +73,49 @@ size_t LiteralPool::GarbageCollect(Shape shape) {
   return num_erased;
 }
 
-// Tried to find a canonical literal in the pool. Return nullptr if not found.
-static std::shared_ptr<Literal> FindCanonicalLiteral(
-    std::vector<std::weak_ptr<Literal>>& literals, const Literal& literal) {
-  for (std::weak_ptr<Literal>& ptr : literals) {
-    if (auto locked_ptr = ptr.lock()) {
+// Hashes the literal contents. This is done outside of the pool lock, as it
+// touches the whole literal buffer.
+static size_t HashLiteral(const Literal& literal) {
+  return absl::HashOf(Literal::AbslHashable</*layout_sensitive=*/true>(literal));
+}
+
+template <typename MakeLiteral>
+std::shared_ptr<Literal> LiteralPool::GetOrAddCanonicalLiteral(
+    const Literal& literal, size_t hash, MakeLiteral make_literal) {
+  absl::MutexLock lock(&mu_);
+
+  auto& literals = literals_[literal.shape()];
+  for (Entry& entry : literals) {
+    if (entry.hash != hash) continue;
+    if (auto locked_ptr = entry.literal.lock()) {
       if (locked_ptr->Equal(literal, /*layout_sensitive=*/true)) {
         return locked_ptr;
       }
     }
   }
 
-  return nullptr;
+  std::shared_ptr<Literal> new_literal = make_literal();
+  literals.push_back(Entry{hash, new_literal});
+  return new_literal;
 }
 
 std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     const Literal& literal) {
-  absl::MutexLock lock(&mu_);
-
-  auto& literals = literals_[literal.shape()];
-  if (auto ptr = FindCanonicalLiteral(literals, literal)) {
-    return ptr;
-  }
+  return GetOrAddCanonicalLiteral(literal, HashLiteral(literal), [&] {
+    return std::shared_ptr<Literal>(literal.CloneToUnique());
+  });
+}
 
-  std::shared_ptr<Literal> new_literal = literal.CloneToUnique();
-  literals.push_back(new_literal);
-  return new_literal;
+std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(Literal&& literal) {
+  return GetOrAddCanonicalLiteral(literal, HashLiteral(literal), [&] {
+    return std::make_shared<Literal>(std::move(literal));
+  });
 }
 
 std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     std::shared_ptr<Literal> literal) {
-  absl::MutexLock lock(&mu_);
-
-  auto& literals = literals_[literal->shape()];
-  if (auto ptr = FindCanonicalLiteral(literals, *literal)) {
-    return ptr;
-  }
-
-  literals.push_back(literal);
-  return literal;
+  return GetOrAddCanonicalLiteral(*literal, HashLiteral(*literal),
+                                  [&] { return literal; });
 }
 
 }  // namespace xla
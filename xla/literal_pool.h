@@ -40,6 +40,11 @@ class LiteralPool {
   // pool, it is added to the pool and returned back.
   std::shared_ptr<Literal> GetCanonicalLiteral(const Literal& literal);
 
+  // Returns a canonical literal from the pool. If the literal is not in the
+  // pool, it is moved into the pool (without copying its buffers) and returned
+  // back.
+  std::shared_ptr<Literal> GetCanonicalLiteral(Literal&& literal);
+
   // Returns a canonical literal from the pool. If the literal is not in the
   // pool, it is added to the pool and returned back.
   std::shared_ptr<Literal> GetCanonicalLiteral(
@@ -57,9 +62,24 @@ class LiteralPool {
   // We keep weak pointers to the literals in the pool to allow for garbage
   // collection when owning HLO modules are destroyed. We run periodic garbage
   // collection to clean up the literals that are no longer referenced.
+  //
+  // Each literal is stored together with the hash of its contents, so that
+  // lookups only compare the buffers of literals with a matching hash instead
+  // of every literal of the same shape.
+  struct Entry {
+    size_t hash;
+    std::weak_ptr<Literal> literal;
+  };
+
+  // Finds a canonical literal equal to `literal` with the given `hash` and
+  // adds the literal created by `make_literal` if there is none.
+  template <typename MakeLiteral>
+  std::shared_ptr<Literal> GetOrAddCanonicalLiteral(const Literal& literal,
+                                                    size_t hash,
+                                                    MakeLiteral make_literal);
+
   absl::Mutex mu_;
-  absl::flat_hash_map<Shape, std::vector<std::weak_ptr<Literal>>> literals_
-      ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<Shape, std::vector<Entry>> literals_ ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace xla
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/literal_pool.h"
 
+#include <utility>
+
 #include "xla/literal_util.h"
 #include "xla/tsl/platform/test.h"
 
@@ -41,5 +43,24 @@ TEST(LiteralPoolTest, GetCanonicalLiteral) {
   ASSERT_EQ(pool.GarbageCollect(), 2);
 }
 
+TEST(LiteralPoolTest, GetCanonicalLiteralByMove) {
+  LiteralPool pool;
+
+  auto l0 = LiteralUtil::CreateR1<float>({1., 2., 3., 4.});
+  const void* l0_data = l0.untyped_data();
+
+  auto cl0_0 = pool.GetCanonicalLiteral(std::move(l0));
+  // The literal buffer is moved into the pool without a copy.
+  EXPECT_EQ(cl0_0->untyped_data(), l0_data);
+
+  auto cl0_1 =
+      pool.GetCanonicalLiteral(LiteralUtil::CreateR1<float>({1., 2., 3., 4.}));
+  EXPECT_EQ(cl0_0, cl0_1);
+
+  auto cl1 =
+      pool.GetCanonicalLiteral(LiteralUtil::CreateR1<float>({4., 3., 2., 1.}));
+  EXPECT_NE(cl0_0, cl1);
+}
+
 }  // namespace
 }  // namespace xla
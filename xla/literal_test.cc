@@ -1487,6 +1487,7 @@ TEST_F(LiteralUtilTest, Populate) {
       {{4, 16}, {1, 0}},
       {{21, 12}, {0, 1}},
       {{6, 11, 17}, {2, 0, 1}},
+      {{6, 11, 17}, {2, 1, 0}},
       {{6, 11, 5, 17}, {3, 2, 0, 1}},
   };
   for (const auto& data : populate_data) {
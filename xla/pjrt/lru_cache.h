@@ -16,8 +16,12 @@ limitations under the License.
 #ifndef XLA_PJRT_LRU_CACHE_H_
 #define XLA_PJRT_LRU_CACHE_H_
 
+#include <array>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include "absl/container/node_hash_map.h"
 #include "tsl/platform/logging.h"
@@ -74,6 +78,15 @@ class LRUCache {
     LRUListEntry head_;
   };
 
+  // Reference to a cache entry, that allows to mark the entry as most recently
+  // used without looking up its key (see `Touch`). Expires when the entry is
+  // evicted or removed from the cache.
+  class Handle {
+   private:
+    friend class LRUCache;
+    std::weak_ptr<LRUListEntry*> entry_;
+  };
+
   explicit LRUCache(LRUList* lru_list) : lru_list_(lru_list) {}
   ~LRUCache();
 
@@ -83,9 +96,14 @@ class LRUCache {
   LRUCache& operator=(LRUCache&&) = delete;
 
   // Returns the `value` associated with `key`. Creates a value with `factory`
-  // and inserts it if absent.
+  // and inserts it if absent. If `handle` is not null, sets it to the entry.
   Value GetOrCreateIfAbsent(const Key& key,
-                            const std::function<Value(const Key&)>& factory);
+                            const std::function<Value(const Key&)>& factory,
+                            Handle* handle = nullptr);
+
+  // Returns the value of the entry referenced by `handle` and marks it as most
+  // recently used, or std::nullopt if the handle has expired.
+  std::optional<Value> Touch(const Handle& handle);
 
   void Remove(const Key& key);
 
@@ -109,8 +127,14 @@ class LRUCache {
     const Key* key;
     LRUCache* container;
     std::optional<Value> value;
+
+    // Referenced by handles to this entry, created on demand.
+    std::shared_ptr<LRUListEntry*> handle;
   };
 
+  // Moves `entry` to the back of the LRU list, as the most recently used.
+  void MoveToBack(Entry& entry);
+
   // We use `unordered_map` because (a) we want to guarantee pointer stability
   // for keys and values, and (b) we need exception safety so we can't use
   // absl hashtables.
@@ -151,9 +175,36 @@ void LRUCache<Key, Value, Hash, Eq>::Remove(const Key& key) {
   entries_.erase(key);
 }
 
+template <typename Key, typename Value, typename Hash, typename Eq>
+void LRUCache<Key, Value, Hash, Eq>::MoveToBack(Entry& entry) {
+  // Removes the entry from the LRU list, in preparation for adding it
+  // to the back of the list.
+  entry.prev->next = entry.next;
+  entry.next->prev = entry.prev;
+
+  // Since it is now the most recently used element, it goes at the back.
+  LRUListEntry& lru_head = lru_list_->head_;
+  entry.prev = lru_head.prev;
+  entry.next = &lru_head;
+  lru_head.prev->next = &entry;
+  lru_head.prev = &entry;
+}
+
+template <typename Key, typename Value, typename Hash, typename Eq>
+std::optional<Value> LRUCache<Key, Value, Hash, Eq>::Touch(
+    const Handle& handle) {
+  std::shared_ptr<LRUListEntry*> ref = handle.entry_.lock();
+  if (ref == nullptr) return std::nullopt;
+  Entry& entry = *static_cast<Entry*>(*ref);
+  if (entry.container != this) return std::nullopt;
+  MoveToBack(entry);
+  return *entry.value;
+}
+
 template <typename Key, typename Value, typename Hash, typename Eq>
 Value LRUCache<Key, Value, Hash, Eq>::GetOrCreateIfAbsent(
-    const Key& key, const std::function<Value(const Key&)>& factory) {
+    const Key& key, const std::function<Value(const Key&)>& factory,
+    Handle* handle) {
   auto [it, inserted] = entries_.try_emplace(key);
   Entry& entry = it->second;
   if (inserted) {
@@ -175,6 +226,13 @@ Value LRUCache<Key, Value, Hash, Eq>::GetOrCreateIfAbsent(
   lru_head.prev->next = &entry;
   lru_head.prev = &entry;
 
+  if (handle != nullptr) {
+    if (entry.handle == nullptr) {
+      entry.handle = std::make_shared<LRUListEntry*>(&entry);
+    }
+    handle->entry_ = entry.handle;
+  }
+
   Value v = *entry.value;
 
   // Evict an LRU entry if we are over capacity.
@@ -191,6 +249,76 @@ Value LRUCache<Key, Value, Hash, Eq>::GetOrCreateIfAbsent(
   return v;
 }
 
+// A handful of recently used entries of an `LRUCache`, for callers that look up
+// the same few keys over and over. Not thread-safe.
+//
+// Entries hold handles to the `LRUCache` entries, so that a hit marks the entry
+// as most recently used in its (possibly shared) LRU list without hashing the
+// key again. Entries evicted from the `LRUCache` are missed here as well.
+template <typename Key, typename Value, int kSize>
+class InlineLRUCache {
+ public:
+  using Cache = LRUCache<Key, Value>;
+  using Handle = typename Cache::Handle;
+
+  // Returns the value associated with `key` in `cache`. On a miss in this
+  // cache, looks up `key` in `cache`, creates a value with `factory` and
+  // inserts it if absent, and sets `*handle` to the entry in `cache`. Sets
+  // `*hit` to whether `key` was found in this cache.
+  Value GetOrCreateIfAbsent(const Key& key, Cache& cache,
+                            const std::function<Value(const Key&)>& factory,
+                            Handle* handle, bool* hit);
+
+  // Adds `key` with the `cache` entry `handle` to this cache, replacing the
+  // oldest entry.
+  void Update(const Key& key, Handle handle);
+
+  // Removes all entries from this cache.
+  void Clear();
+
+ private:
+  struct Entry {
+    std::optional<Key> key;
+    Handle handle;
+  };
+  std::array<Entry, kSize> entries_;
+  int next_ = 0;
+};
+
+template <typename Key, typename Value, int kSize>
+Value InlineLRUCache<Key, Value, kSize>::GetOrCreateIfAbsent(
+    const Key& key, Cache& cache,
+    const std::function<Value(const Key&)>& factory, Handle* handle,
+    bool* hit) {
+  for (const Entry& entry : entries_) {
+    if (entry.key.has_value() && *entry.key == key) {
+      if (std::optional<Value> value = cache.Touch(entry.handle)) {
+        *hit = true;
+        return *std::move(value);
+      }
+      break;
+    }
+  }
+  *hit = false;
+  return cache.GetOrCreateIfAbsent(key, factory, handle);
+}
+
+template <typename Key, typename Value, int kSize>
+void InlineLRUCache<Key, Value, kSize>::Update(const Key& key, Handle handle) {
+  Entry& entry = entries_[next_];
+  entry.key = key;
+  entry.handle = std::move(handle);
+  next_ = (next_ + 1) % kSize;
+}
+
+template <typename Key, typename Value, int kSize>
+void InlineLRUCache<Key, Value, kSize>::Clear() {
+  for (Entry& entry : entries_) {
+    entry = Entry();
+  }
+  next_ = 0;
+}
+
 }  // namespace xla
 
 #endif  // XLA_PJRT_LRU_CACHE_H_
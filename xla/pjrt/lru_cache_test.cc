@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "xla/pjrt/lru_cache.h"
 
+#include <memory>
+#include <optional>
 #include <random>
+#include <utility>
 
 #include "xla/hlo/testlib/test.h"
 
@@ -115,5 +118,123 @@ TEST(LRUCache, RandomInsertions) {
   }
 }
 
+TEST(InlineLRUCache, HitsKeepEntriesFromBeingEvicted) {
+  using Cache = LRUCache<int, std::shared_ptr<int>>;
+  Cache::LRUList list(2);
+  Cache cache(&list);
+  InlineLRUCache<int, std::shared_ptr<int>, 1> inline_cache;
+  int creations = 0;
+  auto factory = [&](int key) {
+    ++creations;
+    return std::make_shared<int>(key);
+  };
+
+  bool hit;
+  Cache::Handle handle;
+  std::shared_ptr<int> hot =
+      inline_cache.GetOrCreateIfAbsent(0, cache, factory, &handle, &hit);
+  EXPECT_FALSE(hit);
+  inline_cache.Update(0, handle);
+  for (int i = 1; i < 10; ++i) {
+    EXPECT_EQ(hot, inline_cache.GetOrCreateIfAbsent(0, cache, factory,
+                                                    &handle, &hit));
+    EXPECT_TRUE(hit);
+    // Other keys only go to the LRU cache, which is full. The key hit above
+    // must not be the one evicted.
+    cache.GetOrCreateIfAbsent(i, factory);
+  }
+  EXPECT_EQ(10, creations);
+  EXPECT_EQ(hot, cache.GetOrCreateIfAbsent(0, factory));
+  EXPECT_EQ(10, creations);
+}
+
+TEST(InlineLRUCache, MissesEvictedEntries) {
+  using Cache = LRUCache<int, std::shared_ptr<int>>;
+  Cache::LRUList list(1);
+  Cache cache(&list);
+  InlineLRUCache<int, std::shared_ptr<int>, 2> inline_cache;
+  int creations = 0;
+  auto factory = [&](int key) {
+    ++creations;
+    return std::make_shared<int>(key);
+  };
+
+  bool hit;
+  Cache::Handle handle;
+  std::shared_ptr<int> value =
+      inline_cache.GetOrCreateIfAbsent(0, cache, factory, &handle, &hit);
+  inline_cache.Update(0, handle);
+  cache.GetOrCreateIfAbsent(1, factory);  // Evicts 0.
+  EXPECT_EQ(2, creations);
+
+  // The evicted entry is created again, even though its value is alive.
+  EXPECT_NE(value, inline_cache.GetOrCreateIfAbsent(0, cache, factory,
+                                                    &handle, &hit));
+  EXPECT_FALSE(hit);
+  EXPECT_EQ(3, creations);
+}
+
+// Key that counts equality comparisons.
+struct CountingKey {
+  int value;
+  int* num_comparisons;
+
+  bool operator==(const CountingKey& other) const {
+    ++*num_comparisons;
+    return value == other.value;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const CountingKey& key) {
+    return H::combine(std::move(h), key.value);
+  }
+};
+
+TEST(InlineLRUCache, HitsDoNotLookUpCache) {
+  using Cache = LRUCache<CountingKey, int>;
+  Cache::LRUList list(4);
+  Cache cache(&list);
+  InlineLRUCache<CountingKey, int, 2> inline_cache;
+  int num_comparisons = 0;
+  CountingKey key{42, &num_comparisons};
+  auto factory = [](const CountingKey& key) { return key.value; };
+
+  bool hit;
+  Cache::Handle handle;
+  EXPECT_EQ(42, inline_cache.GetOrCreateIfAbsent(key, cache, factory, &handle,
+                                                 &hit));
+  inline_cache.Update(key, handle);
+
+  // Looking up the key in the LRU cache compares it with the cached key.
+  num_comparisons = 0;
+  EXPECT_EQ(42, cache.GetOrCreateIfAbsent(key, factory));
+  EXPECT_GE(num_comparisons, 1);
+
+  // A hit compares the key only with the inline entry.
+  num_comparisons = 0;
+  EXPECT_EQ(42, inline_cache.GetOrCreateIfAbsent(key, cache, factory, &handle,
+                                                 &hit));
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(num_comparisons, 1);
+}
+
+TEST(LRUCache, HandlesExpireWhenEntriesAreRemoved) {
+  LRUCache<int, int>::LRUList list(2);
+  LRUCache<int, int> cache(&list);
+  LRUCache<int, int>::Handle handle;
+  EXPECT_EQ(0, cache.GetOrCreateIfAbsent(0, [](int) { return 0; }, &handle));
+  EXPECT_EQ(0, cache.Touch(handle));
+
+  // Touching 0 makes 1 the least recently used entry, which is evicted.
+  cache.GetOrCreateIfAbsent(1, [](int) { return 1; });
+  EXPECT_EQ(0, cache.Touch(handle));
+  cache.GetOrCreateIfAbsent(2, [](int) { return 2; });
+  EXPECT_EQ(0, cache.Touch(handle));
+  EXPECT_EQ(2, cache.Size());
+
+  cache.Remove(0);
+  EXPECT_EQ(std::nullopt, cache.Touch(handle));
+}
+
 }  // namespace
 }  // namespace xla
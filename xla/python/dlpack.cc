@@ -54,6 +54,7 @@ limitations under the License.
 #include "xla/python/util.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
+#include "xla/tsl/lib/monitoring/counter.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
@@ -66,6 +67,14 @@ namespace {
 
 const char* const kDlTensorCapsuleName = "dltensor";
 
+auto* dlpack_zero_copy_imports = tsl::monitoring::Counter<0>::New(
+    "/jax/dlpack/zero_copy_imports",
+    "The number of DLPack tensors imported without copying their data.");
+
+auto* dlpack_copied_imports = tsl::monitoring::Counter<0>::New(
+    "/jax/dlpack/copied_imports",
+    "The number of DLPack tensors whose data was copied on import.");
+
 struct DLPackTensor {
   ~DLPackTensor();
 
@@ -215,19 +224,31 @@ absl::StatusOr<PrimitiveType> DLDataTypeToPrimitiveType(DLDataType type) {
 absl::StatusOr<std::vector<int64_t>> StridesToLayout(
     absl::Span<int64_t const> dims, absl::Span<int64_t const> strides) {
   CHECK_EQ(dims.size(), strides.size());
-  std::vector<int64_t> minor_to_major(dims.size());
-  std::iota(minor_to_major.begin(), minor_to_major.end(), 0);
-  absl::c_sort(minor_to_major, [&](int a, int b) {
-    if (strides[a] < strides[b]) {
-      return true;
-    }
-    if (strides[a] > strides[b]) {
-      return false;
-    }
-    // If two dimensions have the same stride, prefer the major-to-minor
-    // interpretation of the ordering, since that's what JAX wants.
-    return b < a;
+  // The strides of dimensions of size 1 are meaningless, and producers such as
+  // PyTorch set them arbitrarily. Order only the other dimensions by stride.
+  std::vector<int64_t> strided_dims;
+  std::vector<int64_t> unit_dims;
+  for (int64_t d = dims.size() - 1; d >= 0; --d) {
+    (dims[d] == 1 ? unit_dims : strided_dims).push_back(d);
+  }
+  absl::c_stable_sort(strided_dims, [&](int64_t a, int64_t b) {
+    // If two dimensions have the same stride, the major-to-minor
+    // interpretation of the ordering is kept, since that's what JAX wants.
+    return strides[a] < strides[b];
   });
+  // Place the dimensions of size 1 where the major-to-minor layout would have
+  // them, so that they do not turn an otherwise default layout into a
+  // non-default one.
+  std::vector<int64_t> minor_to_major;
+  minor_to_major.reserve(dims.size());
+  auto unit_dim = unit_dims.begin();
+  for (int64_t d : strided_dims) {
+    while (unit_dim != unit_dims.end() && *unit_dim > d) {
+      minor_to_major.push_back(*unit_dim++);
+    }
+    minor_to_major.push_back(d);
+  }
+  minor_to_major.insert(minor_to_major.end(), unit_dim, unit_dims.end());
   int64_t stride = 1;
   for (int64_t d : minor_to_major) {
     if (dims[d] > 1 && strides[d] != stride) {
@@ -325,42 +346,76 @@ absl::StatusOr<std::vector<int64_t>> GetByteStrides(const DLTensor& dl_tensor) {
   return strides;
 }
 
+// Returns the minor-to-major layout described by the strides of `dl_tensor`.
+absl::StatusOr<std::vector<int64_t>> DLTensorLayout(
+    const DLTensor& dl_tensor, absl::Span<int64_t const> dimensions) {
+  if (dl_tensor.strides && absl::c_find(dimensions, 0) == dimensions.end()) {
+    absl::Span<int64_t const> strides(
+        reinterpret_cast<int64_t*>(dl_tensor.strides), dl_tensor.ndim);
+    return StridesToLayout(dimensions, strides);
+  }
+  std::vector<int64_t> minor_to_major(dl_tensor.ndim);
+  std::iota(minor_to_major.rbegin(), minor_to_major.rend(), 0);
+  return minor_to_major;
+}
+
+// Imports the DLPack tensor as a view of its memory if `view_shape` is set,
+// and by copying it into a buffer with the default layout otherwise. Copying
+// is only possible for CPU tensors; it goes through the client's transpose
+// plans and so handles any striding.
 absl::StatusOr<std::unique_ptr<PjRtBuffer>> MakePjrtBuffer(
-    PjRtDevice& device, ::DLManagedTensor* dlmt, const Shape& shape,
-    PrimitiveType element_type, absl::Span<int64_t const> dimensions,
+    PjRtDevice& device, ::DLManagedTensor* dlmt,
+    const std::optional<Shape>& view_shape, PrimitiveType element_type,
+    absl::Span<int64_t const> dimensions,
     std::optional<std::intptr_t> stream = std::nullopt) {
   std::function<void()> on_delete_callback;
   if (dlmt->deleter) {
     on_delete_callback = [dlmt]() { dlmt->deleter(dlmt); };
   }
 
-  // First try to create a view.
   void* data =
       static_cast<char*>(dlmt->dl_tensor.data) + dlmt->dl_tensor.byte_offset;
-  auto result = device.client()->CreateViewOfDeviceBuffer(
-      data, shape, *device.default_memory_space(), on_delete_callback, stream);
-
-  // If that fails with invalid argument, it's possibly because of the incorrect
-  // alignment. If we're on CPU, we can create a copy of buffer.
-  if (result.status().code() == absl::StatusCode::kInvalidArgument &&
-      dlmt->dl_tensor.device.device_type == kDLCPU) {
+  if (view_shape.has_value()) {
+    // First try to create a view.
+    auto result = device.client()->CreateViewOfDeviceBuffer(
+        data, *view_shape, *device.default_memory_space(), on_delete_callback,
+        stream);
+    if (result.ok()) {
+      static auto* zero_copy_imports_cell =
+          dlpack_zero_copy_imports->GetCell();
+      zero_copy_imports_cell->IncrementBy(1);
+      return result;
+    }
+    // If that fails with invalid argument, it's possibly because of the
+    // incorrect alignment. If we're on CPU, we can create a copy of buffer.
+    if (result.status().code() != absl::StatusCode::kInvalidArgument ||
+        dlmt->dl_tensor.device.device_type != kDLCPU) {
+      return result;
+    }
     LOG(WARNING) << "DLPack buffer is not aligned (data at: " << data
                  << "). Creating a copy.";
+  } else {
+    TF_RET_CHECK(dlmt->dl_tensor.device.device_type == kDLCPU);
+    VLOG(1) << "DLPack buffer striding cannot be used as is. Creating a copy.";
+  }
 
-    // Convert tensor strides (expressed in number of elements) to byte strides.
-    std::optional<std::vector<int64_t>> byte_strides;
-    if (dlmt->dl_tensor.strides) {
-      TF_ASSIGN_OR_RETURN(byte_strides, GetByteStrides(dlmt->dl_tensor));
-    }
+  // Convert tensor strides (expressed in number of elements) to byte strides.
+  std::optional<std::vector<int64_t>> byte_strides;
+  if (dlmt->dl_tensor.strides) {
+    TF_ASSIGN_OR_RETURN(byte_strides, GetByteStrides(dlmt->dl_tensor));
+  }
 
-    TF_ASSIGN_OR_RETURN(auto* memory_space, device.default_memory_space());
+  TF_ASSIGN_OR_RETURN(auto* memory_space, device.default_memory_space());
 
-    // Create a copy.
-    result = device.client()->BufferFromHostBuffer(
-        data, element_type, dimensions, byte_strides,
-        PjRtClient::HostBufferSemantics::kMutableZeroCopy, on_delete_callback,
-        memory_space, /*device_layout=*/nullptr);
-  }
+  // Create a copy.
+  TF_ASSIGN_OR_RETURN(
+      auto result,
+      device.client()->BufferFromHostBuffer(
+          data, element_type, dimensions, byte_strides,
+          PjRtClient::HostBufferSemantics::kMutableZeroCopy,
+          on_delete_callback, memory_space, /*device_layout=*/nullptr));
+  static auto* copied_imports_cell = dlpack_copied_imports->GetCell();
+  copied_imports_cell->IncrementBy(1);
   return result;
 }
 
@@ -480,43 +535,41 @@ absl::StatusOr<nb::object> DLPackManagedTensorToBuffer(
   TF_ASSIGN_OR_RETURN(PrimitiveType element_type,
                       DLDataTypeToPrimitiveType(dlmt->dl_tensor.dtype));
 
-  std::vector<int64_t> minor_to_major;
-  if (dlmt->dl_tensor.strides &&
-      absl::c_find(dimensions, 0) == dimensions.end()) {
-    absl::Span<int64_t const> strides(
-        reinterpret_cast<int64_t*>(dlmt->dl_tensor.strides),
-        dlmt->dl_tensor.ndim);
-    TF_ASSIGN_OR_RETURN(minor_to_major, StridesToLayout(dimensions, strides));
-  } else {
-    minor_to_major.resize(dlmt->dl_tensor.ndim);
-    std::iota(minor_to_major.rbegin(), minor_to_major.rend(), 0);
-  }
-  Shape shape = ShapeUtil::MakeShapeWithDenseLayout(element_type, dimensions,
-                                                    minor_to_major);
-
-  // Raise an error if the resulting PjRtBuffer would have a non-default layout.
-  // TODO(skyewm): we do this because JAX doesn't currently have good support
-  // for non-default layouts, and will return wrong results if a non-default
-  // layout is passed to a computation expecting default layouts. Remove this
-  // special case when non-default layouts are better supported by JAX.
-  TF_ASSIGN_OR_RETURN(Layout default_layout, device->client()->GetDefaultLayout(
-                                                 element_type, dimensions));
-  if (shape.layout() != default_layout) {
-    return Unimplemented(
-        "from_dlpack got array with non-default layout with minor-to-major "
-        "dimensions (%s), expected (%s)",
-        absl::StrJoin(shape.layout().minor_to_major(), ","),
-        absl::StrJoin(default_layout.minor_to_major(), ","));
+  // CPU tensors that cannot be viewed are copied instead.
+  const bool can_copy = dlmt->dl_tensor.device.device_type == kDLCPU;
+  absl::StatusOr<std::vector<int64_t>> minor_to_major =
+      DLTensorLayout(dlmt->dl_tensor, dimensions);
+  if (!minor_to_major.ok() && !can_copy) {
+    return minor_to_major.status();
   }
-
-  std::function<void()> on_delete_callback;
-  if (dlmt->deleter) {
-    on_delete_callback = [dlmt]() { dlmt->deleter(dlmt); };
+  std::optional<Shape> view_shape;
+  if (minor_to_major.ok()) {
+    Shape shape = ShapeUtil::MakeShapeWithDenseLayout(element_type, dimensions,
+                                                      *minor_to_major);
+
+    // Only view tensors whose resulting PjRtBuffer would have the default
+    // layout, and raise an error for others that cannot be copied.
+    // TODO(skyewm): we do this because JAX doesn't currently have good support
+    // for non-default layouts, and will return wrong results if a non-default
+    // layout is passed to a computation expecting default layouts. Remove this
+    // special case when non-default layouts are better supported by JAX.
+    TF_ASSIGN_OR_RETURN(
+        Layout default_layout,
+        device->client()->GetDefaultLayout(element_type, dimensions));
+    if (shape.layout() == default_layout) {
+      view_shape = std::move(shape);
+    } else if (!can_copy) {
+      return Unimplemented(
+          "from_dlpack got array with non-default layout with minor-to-major "
+          "dimensions (%s), expected (%s)",
+          absl::StrJoin(shape.layout().minor_to_major(), ","),
+          absl::StrJoin(default_layout.minor_to_major(), ","));
+    }
   }
 
   TF_ASSIGN_OR_RETURN(
       auto pjrt_buffer,
-      MakePjrtBuffer(*device, dlmt, shape, element_type, dimensions));
+      MakePjrtBuffer(*device, dlmt, view_shape, element_type, dimensions));
 
   // We have taken ownership of the array inside the capsule; make sure the
   // capsule it cannot be used again.
@@ -570,22 +623,20 @@ absl::StatusOr<nb::object> DLPackManagedTensorToBuffer(
   TF_ASSIGN_OR_RETURN(PrimitiveType element_type,
                       DLDataTypeToPrimitiveType(dlmt->dl_tensor.dtype));
 
-  std::vector<int64_t> minor_to_major;
-  if (dlmt->dl_tensor.strides &&
-      absl::c_find(dimensions, 0) == dimensions.end()) {
-    absl::Span<int64_t const> strides(
-        reinterpret_cast<int64_t*>(dlmt->dl_tensor.strides),
-        dlmt->dl_tensor.ndim);
-    TF_ASSIGN_OR_RETURN(minor_to_major, StridesToLayout(dimensions, strides));
-  } else {
-    minor_to_major.resize(dlmt->dl_tensor.ndim);
-    std::iota(minor_to_major.rbegin(), minor_to_major.rend(), 0);
+  // Tensors are viewed with the layout given by their strides. Those whose
+  // striding no XLA layout can represent are copied instead, on CPU only.
+  absl::StatusOr<std::vector<int64_t>> minor_to_major =
+      DLTensorLayout(dlmt->dl_tensor, dimensions);
+  std::optional<Shape> view_shape;
+  if (minor_to_major.ok()) {
+    view_shape = ShapeUtil::MakeShapeWithDenseLayout(element_type, dimensions,
+                                                     *minor_to_major);
+  } else if (dlmt->dl_tensor.device.device_type != kDLCPU) {
+    return minor_to_major.status();
   }
-  Shape shape = ShapeUtil::MakeShapeWithDenseLayout(element_type, dimensions,
-                                                    minor_to_major);
 
   TF_ASSIGN_OR_RETURN(auto pjrt_buffer,
-                      MakePjrtBuffer(*device->pjrt_device(), dlmt, shape,
+                      MakePjrtBuffer(*device->pjrt_device(), dlmt, view_shape,
                                      element_type, dimensions, stream));
 
   // We have taken ownership of the array inside the capsule; make sure the
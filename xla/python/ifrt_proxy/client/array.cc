@@ -433,8 +433,9 @@ Array::RemapArrays(xla::ifrt::Client* client,
       result_handles.push_back(ArrayHandle{h});
       req->add_result_handles(h);
     }
-    CheckResponseAfterAsyncCall(rpc_helper->RemapArrays(std::move(req)),
-                                result_handles);
+    CheckResponseAfterAsyncCall(
+        rpc_helper->RemapArrays(std::move(req), RpcHelper::kDeferred),
+        result_handles);
   }
 
   std::vector<tsl::RCReference<xla::ifrt::Array>> result;
@@ -319,7 +319,7 @@ Client::CopyArrays(absl::Span<tsl::RCReference<xla::ifrt::Array>> arrays,
       result_handles.push_back(rpc_helper_->NextHandle());
       req->add_result_handles(result_handles.back());
     }
-    rpc_helper_->CopyArrays(std::move(req))
+    rpc_helper_->CopyArrays(std::move(req), RpcHelper::kDeferred)
         .OnReady([result_handles](
                      absl::StatusOr<std::shared_ptr<CopyArraysResponse>> r) {
           if (r.ok()) {
@@ -18,6 +18,7 @@
 #define XLA_PYTHON_IFRT_PROXY_CLIENT_CLIENT_SESSION_H_
 
 #include <memory>
+#include <utility>
 
 #include "absl/status/status.h"
 #include "xla/python/ifrt/future.h"
@@ -44,6 +45,15 @@ class ClientSession {
   // response for the given op id becomes ready.
   virtual Future<Response> Enqueue(std::unique_ptr<IfrtRequest> request) = 0;
 
+  // Same as `Enqueue()`, but hints that more requests will be enqueued right
+  // away, so the implementation may hold `request` back and send it together
+  // with them. A burst of such requests must be terminated by a plain
+  // `Enqueue()` call, which sends everything held back so far.
+  virtual Future<Response> EnqueueWithMoreToFollow(
+      std::unique_ptr<IfrtRequest> request) {
+    return Enqueue(std::move(request));
+  }
+
   // Terminates the `ClientSession` if it has not already been terminated.
   virtual void Finish(const absl::Status& s) {}
 };
@@ -520,11 +520,15 @@ LoadedExecutable::Execute(absl::Span<tsl::RCReference<xla::ifrt::Array>> args,
     if (result_needs_exec_status) {
       req->set_result_status_handle(status_handle);
     }
-    rpc_helper_->LoadedExecutableExecute(std::move(req));
+    // The outputs are referred to by client-generated handles, so there is no
+    // need to wait for the response; deferring the request lets it share a
+    // network write with whatever RPC comes next.
+    rpc_helper_->LoadedExecutableExecute(std::move(req), RpcHelper::kDeferred);
     if (result_needs_exec_status) {
       // Note that `CheckFuture` needs to be sent after
       // `LoadedExecutableExecute` above, or the server will not recognize the
-      // handle being sent.
+      // handle being sent. Being an immediate RPC, it flushes the deferred
+      // `LoadedExecutableExecute`.
       result.status = rpc_helper_->CheckFuture(status_handle);
     }
   } else {
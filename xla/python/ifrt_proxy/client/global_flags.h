@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_PYTHON_IFRT_PROXY_CLIENT_GLOBAL_FLAGS_H_
 #define XLA_PYTHON_IFRT_PROXY_CLIENT_GLOBAL_FLAGS_H_
 
+#include <cstdint>
 #include <ostream>
 
 namespace xla {
@@ -36,6 +37,17 @@ struct GlobalClientFlags {
 
   // TODO(b/375021159): Implement faster is_delete without needing a hack.
   bool array_is_deleted_hack;
+
+  // Maximum size of a single message when sending host buffers to the server.
+  int64_t host_buffer_chunk_size;
+
+  // Compresses host buffers sent to the server with gzip. Useful on slow links
+  // when the data compresses well.
+  bool compress_host_buffer_stores;
+
+  // Passes host buffers through shared memory when the server is on the same
+  // machine as the client.
+  bool shared_memory_host_buffers;
 };
 
 GlobalClientFlags* GetGlobalClientFlags();
@@ -44,7 +56,12 @@ inline std::ostream& operator<<(std::ostream& os, GlobalClientFlags flags) {
   return os << "xla::ifrt::proxy::GlobalClientFlags{"
             << "synchronous_host_buffer_store="
             << flags.synchronous_host_buffer_store << ","
-            << "array_is_deleted_hack=" << flags.array_is_deleted_hack << "}";
+            << "array_is_deleted_hack=" << flags.array_is_deleted_hack << ","
+            << "host_buffer_chunk_size=" << flags.host_buffer_chunk_size << ","
+            << "compress_host_buffer_stores="
+            << flags.compress_host_buffer_stores << ","
+            << "shared_memory_host_buffers=" << flags.shared_memory_host_buffers
+            << "}";
 }
 
 }  // namespace proxy
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 
@@ -37,6 +38,17 @@ bool GetBoolFromEnv(const char* key) {
   return false;
 }
 
+int64_t GetInt64FromEnv(const char* key, int64_t default_value) {
+  if (const char* valptr = std::getenv(key)) {
+    std::string val(valptr);
+    int64_t result;
+    QCHECK(absl::SimpleAtoi(val, &result) && result > 0)
+        << " " << key << ": '" << val << "'";
+    return result;
+  }
+  return default_value;
+}
+
 }  // namespace
 
 static GlobalClientFlags DefaultGlobalClientFlags() {
@@ -44,6 +56,12 @@ static GlobalClientFlags DefaultGlobalClientFlags() {
   result.synchronous_host_buffer_store = false;
   result.array_is_deleted_hack =
       GetBoolFromEnv("IFRT_PROXY_ARRAY_IS_DELETED_HACK");
+  result.host_buffer_chunk_size =
+      GetInt64FromEnv("IFRT_PROXY_HOST_BUFFER_CHUNK_SIZE", 1024 * 1024);
+  result.compress_host_buffer_stores =
+      GetBoolFromEnv("IFRT_PROXY_COMPRESS_HOST_BUFFER_STORES");
+  result.shared_memory_host_buffers =
+      GetBoolFromEnv("IFRT_PROXY_SHARED_MEMORY_HOST_BUFFERS");
   return result;
 };
 
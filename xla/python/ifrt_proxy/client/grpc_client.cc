@@ -25,6 +25,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "grpc/compression.h"
 #include "grpcpp/client_context.h"
 #include "xla/pjrt/distributed/util.h"
 #include "xla/python/ifrt/attribute_map.h"
@@ -139,8 +140,17 @@ absl::StatusOr<std::unique_ptr<Client>> AttemptConnection(
                             ? control_path_stub
                             : CreateGrpcStub(server_address);
 
+  GrpcClientHostBufferStore::Options host_buffer_store_options;
+  host_buffer_store_options.chunk_size =
+      GetGlobalClientFlags()->host_buffer_chunk_size;
+  if (GetGlobalClientFlags()->compress_host_buffer_stores) {
+    host_buffer_store_options.compression = GRPC_COMPRESS_GZIP;
+  }
+  host_buffer_store_options.use_shared_memory =
+      GetGlobalClientFlags()->shared_memory_host_buffers;
   auto host_buffer_store = std::make_unique<GrpcClientHostBufferStore>(
-      data_path_stub, metadata.version(), init_response->session_id());
+      data_path_stub, metadata.version(), init_response->session_id(),
+      std::move(host_buffer_store_options));
   rpc_helper->set_host_buffer_store(std::move(host_buffer_store));
 
   return Client::Create(std::move(rpc_helper), std::move(*init_response));
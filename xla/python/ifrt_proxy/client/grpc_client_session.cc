@@ -37,6 +37,8 @@
 #include "grpcpp/create_channel.h"
 #include "grpcpp/security/credentials.h"
 #include "grpcpp/support/channel_arguments.h"
+#include "grpcpp/support/sync_stream.h"
+#include "grpcpp/support/write_options.h"
 #include "xla/pjrt/distributed/util.h"
 #include "xla/python/ifrt/future.h"
 #include "xla/python/ifrt_proxy/common/grpc_credentials.h"
@@ -124,6 +126,17 @@ GrpcClientSession::GrpcClientSession(
 
 Future<std::shared_ptr<IfrtResponse>> GrpcClientSession::Enqueue(
     std::unique_ptr<IfrtRequest> request) {
+  return EnqueueWithFuture(std::move(request), /*more_to_follow=*/false);
+}
+
+Future<std::shared_ptr<IfrtResponse>>
+GrpcClientSession::EnqueueWithMoreToFollow(
+    std::unique_ptr<IfrtRequest> request) {
+  return EnqueueWithFuture(std::move(request), /*more_to_follow=*/true);
+}
+
+Future<std::shared_ptr<IfrtResponse>> GrpcClientSession::EnqueueWithFuture(
+    std::unique_ptr<IfrtRequest> request, bool more_to_follow) {
   auto promise = Future<std::shared_ptr<IfrtResponse>>::CreatePromise();
   absl::Status status = Enqueue(
       std::move(request),
@@ -133,7 +146,8 @@ Future<std::shared_ptr<IfrtResponse>> GrpcClientSession::Enqueue(
                          response = std::move(response)]() mutable -> void {
           promise.Set(std::move(response));
         });
-      });
+      },
+      more_to_follow);
   if (!status.ok()) {
     user_futures_work_queue_->Schedule([promise, status]() mutable -> void {
       promise.Set(std::move(status));
@@ -143,7 +157,8 @@ Future<std::shared_ptr<IfrtResponse>> GrpcClientSession::Enqueue(
 }
 
 absl::Status GrpcClientSession::Enqueue(std::unique_ptr<IfrtRequest> req,
-                                        ResponseCallback callback) {
+                                        ResponseCallback callback,
+                                        bool more_to_follow) {
   absl::MutexLock l(&writer_mu_);
   const OpId op_id = writer_next_op_id_++;
 
@@ -157,8 +172,15 @@ absl::Status GrpcClientSession::Enqueue(std::unique_ptr<IfrtRequest> req,
   CHECK_EQ(req->mutable_request_metadata()->op_id(), 0);
   req->mutable_request_metadata()->set_op_id(op_id);
 
+  // With the buffer hint set, gRPC may hold the message back until a later
+  // write without the hint, so that a burst of requests is sent together.
+  ::grpc::WriteOptions options;
+  if (more_to_follow) {
+    options.set_buffer_hint();
+  }
+
   tsl::profiler::TraceMe t("grpc_stream_write");
-  if (!stream_->Write(*req)) {
+  if (!stream_->Write(*req, options)) {
     CHECK(response_callbacks_->Pop(op_id).has_value());
     return absl::UnknownError("GrpcClientSession: writing to stream failed.");
   }
@@ -67,6 +67,11 @@ class GrpcClientSession : public ClientSession {
   Future<std::shared_ptr<IfrtResponse>> Enqueue(
       std::unique_ptr<IfrtRequest> request) override;
 
+  // Writes `request` with gRPC's buffer hint set, which allows gRPC to coalesce
+  // it with the requests that follow into fewer network writes.
+  Future<std::shared_ptr<IfrtResponse>> EnqueueWithMoreToFollow(
+      std::unique_ptr<IfrtRequest> request) override;
+
   // `ResponseCallback` represents a function that can be invoked when
   // `ClientSession` receives an `IfrtResponse`. May be invoked by the "primary"
   // thread and with various mutex locks held.
@@ -74,7 +79,7 @@ class GrpcClientSession : public ClientSession {
       std::function<void(absl::StatusOr<std::shared_ptr<IfrtResponse>>)>;
 
   absl::Status Enqueue(std::unique_ptr<IfrtRequest> req,
-                       ResponseCallback callback);
+                       ResponseCallback callback, bool more_to_follow = false);
 
   // Terminates the `GrpcClientSession` if it has not already been terminated.
   // Waits until `stream_terminated_cb` returns.
@@ -96,6 +101,10 @@ class GrpcClientSession : public ClientSession {
                     std::unique_ptr<::grpc::ClientContext> context,
                     StreamTerminatedCallback stream_terminated_cb);
 
+  // Implements the future-returning `Enqueue()` variants.
+  Future<std::shared_ptr<IfrtResponse>> EnqueueWithFuture(
+      std::unique_ptr<IfrtRequest> request, bool more_to_follow);
+
   // Repeatedly waits for a `IfrtResponse` message to arrive; for each message,
   // looks up the corresponding callback registered in `response_callbacks_` and
   // invokes it inline.
@@ -14,26 +14,35 @@
 
 #include "xla/python/ifrt_proxy/client/grpc_host_buffer.h"
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/cleanup/cleanup.h"
+#include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "grpcpp/client_context.h"
 #include "grpcpp/support/client_callback.h"
 #include "grpcpp/support/status.h"
 #include "grpcpp/support/sync_stream.h"
+#include "grpcpp/support/write_options.h"
 #include "xla/pjrt/distributed/util.h"
 #include "xla/python/ifrt/future.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/prof_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
 #include "xla/tsl/protobuf/status.pb.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/statusor.h"
 #include "tsl/platform/unbounded_work_queue.h"
 #include "tsl/profiler/lib/traceme.h"
 
@@ -41,8 +50,6 @@ namespace xla {
 namespace ifrt {
 namespace proxy {
 
-static constexpr int64_t kChunkSize = 1024 * 1024;
-
 static void SetDataFromStringView(GrpcHostBufferStoreRequest& req,
                                   absl::string_view data) {
 #if defined(PLATFORM_GOOGLE)
@@ -55,12 +62,18 @@ static void SetDataFromStringView(GrpcHostBufferStoreRequest& req,
 
 GrpcClientHostBufferStore::GrpcClientHostBufferStore(
     std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub,
-    IfrtProxyVersion version, uint64_t session_id)
+    IfrtProxyVersion version, uint64_t session_id, Options options)
     : stub_(std::move(stub)),
       version_(std::move(version)),
       session_id_(session_id),
+      options_(std::move(options)),
+      shared_memory_state_(options_.use_shared_memory
+                               ? SharedMemoryState::kUnknown
+                               : SharedMemoryState::kUnavailable),
       work_queue_(std::make_unique<tsl::UnboundedWorkQueue>(
-          tsl::Env::Default(), "HostBufferStoreLookupsWorkQueue")) {}
+          tsl::Env::Default(), "HostBufferStoreLookupsWorkQueue")) {
+  CHECK_GT(options_.chunk_size, 0);
+}
 
 GrpcClientHostBufferStore::~GrpcClientHostBufferStore() {
   LOG(INFO) << "Waiting for destruction of HostBufferStoreLookupsWorkQueue...";
@@ -68,63 +81,53 @@ GrpcClientHostBufferStore::~GrpcClientHostBufferStore() {
   LOG(INFO) << "Destructed HostBufferStoreLookupsWorkQueue.";
 }
 
-Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
-                                          absl::string_view data) {
-  auto promise = Future<>::CreatePromise();
-
-  XFlowHelper flow("GrpcClientHostBufferStore::StoreAsync");
-  flow.InstantActivity<XFlowHelper::kSend>();
-
-  std::unique_ptr<std::string> buffered_data;
+absl::Status GrpcClientHostBufferStore::StoreInSharedMemory(
+    uint64_t handle, const absl::Cord& data) {
+  absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> created =
+      SharedMemoryRegion::Create(data.size());
+  if (!created.ok()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Cannot create shared memory: ", created.status().message()));
+  }
+  std::unique_ptr<SharedMemoryRegion> region = *std::move(created);
+  // The segment is only needed until the server has copied it.
+  absl::Cleanup unlink = [&] { region->Unlink().IgnoreError(); };
+  {
+    tsl::profiler::TraceMe trace_me_copy([size = data.size()]() {
+      return tsl::profiler::TraceMeEncode(
+          "GrpcClientHostBufferStore::StoreInSharedMemory_Copy",
+          {{"size", size}});
+    });
+    char* dst = region->mutable_data();
+    for (absl::string_view chunk : data.Chunks()) {
+      std::memcpy(dst, chunk.data(), chunk.size());
+      dst += chunk.size();
+    }
+  }
 
-  work_queue_->Schedule([this, handle, promise, data, flow]() mutable -> void {
-    auto span = flow.Span<XFlowHelper::kRecv>();
-    GrpcHostBufferStoreMetadata metadata;
-    metadata.set_session_id(session_id_);
-    metadata.set_handle(handle);
-    metadata.set_buffer_size(data.size());
-    VLOG(3) << "GrpcClientHostBufferStore::Store start "
-            << metadata.ShortDebugString();
-
-    ::grpc::ClientContext context;
-    context.AddMetadata("ifrt-proxy-grpc-host-buffer-store-metadata-bin",
-                        metadata.SerializeAsString());
-
-    GrpcHostBufferStoreResponse response;
-    auto writer = stub_->HostBufferStore(&context, &response);
-
-    {
-      tsl::profiler::TraceMe trace_me_send_data([size = data.size()]() {
-        return tsl::profiler::TraceMeEncode(
-            "GrpcClientHostBufferStore::StoreAsync_Send", {{"size", size}});
-      });
-      for (int64_t offset = 0; offset < data.size(); offset += kChunkSize) {
-        GrpcHostBufferStoreRequest request;
-        SetDataFromStringView(request, data.substr(offset, kChunkSize));
-        writer->Write(request);
-      }
+  GrpcHostBufferStoreMetadata metadata;
+  metadata.set_session_id(session_id_);
+  metadata.set_handle(handle);
+  metadata.set_buffer_size(data.size());
+  metadata.set_shared_memory_name(region->name());
+  VLOG(3) << "GrpcClientHostBufferStore::StoreInSharedMemory start "
+          << metadata.ShortDebugString();
 
-      if (!writer->WritesDone()) {
-        writer->Finish().IgnoreError();
-        promise.Set(
-            absl::InternalError("Failed to write all host buffer chunks"));
-        return;
-      }
-    }
+  ::grpc::ClientContext context;
+  context.AddMetadata("ifrt-proxy-grpc-host-buffer-store-metadata-bin",
+                      metadata.SerializeAsString());
 
-    VLOG(3) << "GrpcClientHostBufferStore::Store done "
-            << metadata.ShortDebugString();
-    promise.Set(xla::FromGrpcStatus(writer->Finish()));
-  });
-  return Future<>(promise);
+  GrpcHostBufferStoreResponse response;
+  auto writer = stub_->HostBufferStore(&context, &response);
+  if (!writer->WritesDone()) {
+    writer->Finish().IgnoreError();
+    return absl::InternalError("Failed to send host buffer store metadata");
+  }
+  return xla::FromGrpcStatus(writer->Finish());
 }
 
-Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
-                                          const absl::Cord& data) {
-  // The current implementation synchronously sends host buffer chunks. We may
-  // consider making it asynchronous if the caller can leverage such asynchrony.
-  tsl::profiler::TraceMe traceme("GrpcClientHostBufferStore::StoreSync");
-
+absl::Status GrpcClientHostBufferStore::StoreChunks(uint64_t handle,
+                                                    const absl::Cord& data) {
   GrpcHostBufferStoreMetadata metadata;
   metadata.set_session_id(session_id_);
   metadata.set_handle(handle);
@@ -135,6 +138,7 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
   ::grpc::ClientContext context;
   context.AddMetadata("ifrt-proxy-grpc-host-buffer-store-metadata-bin",
                       metadata.SerializeAsString());
+  context.set_compression_algorithm(options_.compression);
 
   GrpcHostBufferStoreResponse response;
   auto writer = stub_->HostBufferStore(&context, &response);
@@ -144,58 +148,155 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
       return tsl::profiler::TraceMeEncode(
           "GrpcClientHostBufferStore::StoreAsync_Send", {{"size", size}});
     });
+    // The last chunk is sent together with the half-close of the stream, which
+    // saves a separate `WritesDone()` round.
+    int64_t remaining = data.size();
+    bool ok = true;
     for (absl::string_view chunk : data.Chunks()) {
-      for (int64_t offset = 0; offset < chunk.size(); offset += kChunkSize) {
+      for (int64_t offset = 0; ok && offset < chunk.size();
+           offset += options_.chunk_size) {
+        absl::string_view piece = chunk.substr(offset, options_.chunk_size);
+        remaining -= piece.size();
         GrpcHostBufferStoreRequest request;
-        SetDataFromStringView(request, chunk.substr(offset, kChunkSize));
-        writer->Write(request);
+        SetDataFromStringView(request, piece);
+        ok = remaining > 0 ? writer->Write(request)
+                           : writer->WriteLast(request, ::grpc::WriteOptions());
       }
     }
-    if (!writer->WritesDone()) {
+    if (ok && data.empty()) {
+      ok = writer->WritesDone();
+    }
+    if (!ok) {
       writer->Finish().IgnoreError();
-      return Future<>(
-          absl::InternalError("Failed to write all host buffer chunks"));
+      return absl::InternalError("Failed to write all host buffer chunks");
     }
   }
+
   VLOG(3) << "GrpcClientHostBufferStore::Store done "
           << metadata.ShortDebugString();
+  return xla::FromGrpcStatus(writer->Finish());
+}
 
-  return Future<>(xla::FromGrpcStatus(writer->Finish()));
+Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
+                                          absl::string_view data) {
+  // The caller keeps `data` alive until the returned future is ready, so the
+  // chunks can be sent without copying it into the cord.
+  return Store(handle, absl::MakeCordFromExternal(data, [] {}));
 }
 
-Future<absl::Cord> GrpcClientHostBufferStore::Lookup(uint64_t handle) {
-  auto promise = Future<absl::Cord>::CreatePromise();
+Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
+                                          const absl::Cord& data) {
+  auto promise = Future<>::CreatePromise();
 
-  XFlowHelper flow("GrpcClientHostBufferStore::Lookup");
+  XFlowHelper flow("GrpcClientHostBufferStore::StoreAsync");
   flow.InstantActivity<XFlowHelper::kSend>();
 
-  work_queue_->Schedule([this, handle, promise, flow]() mutable -> void {
+  work_queue_->Schedule([this, handle, promise, data, flow]() mutable -> void {
     auto span = flow.Span<XFlowHelper::kRecv>();
-    GrpcHostBufferLookupRequest request;
-    request.set_handle(handle);
-    request.set_session_id(session_id_);
-    VLOG(3) << "GrpcClientHostBufferStore::Lookup start "
-            << request.ShortDebugString();
+    if (!data.empty() &&
+        shared_memory_state_.load(std::memory_order_relaxed) !=
+            SharedMemoryState::kUnavailable) {
+      absl::Status status = StoreInSharedMemory(handle, data);
+      // Servers on other machines cannot open the segment, and servers that
+      // predate shared memory support see a stream without data.
+      if (!absl::IsFailedPrecondition(status) && !absl::IsDataLoss(status)) {
+        if (status.ok()) {
+          shared_memory_state_.store(SharedMemoryState::kAvailable,
+                                     std::memory_order_relaxed);
+        }
+        promise.Set(std::move(status));
+        return;
+      }
+      VLOG(1) << "Falling back to streaming host buffer stores: " << status;
+      shared_memory_state_.store(SharedMemoryState::kUnavailable,
+                                 std::memory_order_relaxed);
+    }
+    promise.Set(StoreChunks(handle, data));
+  });
+  return Future<>(promise);
+}
 
-    ::grpc::ClientContext context;
+absl::StatusOr<absl::Cord> GrpcClientHostBufferStore::LookupChunks(
+    uint64_t handle, bool accept_shared_memory) {
+  GrpcHostBufferLookupRequest request;
+  request.set_handle(handle);
+  request.set_session_id(session_id_);
+  request.set_accept_shared_memory(accept_shared_memory);
+  VLOG(3) << "GrpcClientHostBufferStore::Lookup start "
+          << request.ShortDebugString();
 
-    std::unique_ptr<::grpc::ClientReaderInterface<GrpcHostBufferLookupResponse>>
-        stream = stub_->HostBufferLookup(&context, request);
+  ::grpc::ClientContext context;
 
-    absl::Cord data;
-    GrpcHostBufferLookupResponse response;
-    while (stream->Read(&response)) {
-      data.Append(response.data());
+  std::unique_ptr<::grpc::ClientReaderInterface<GrpcHostBufferLookupResponse>>
+      stream = stub_->HostBufferLookup(&context, request);
+
+  absl::Cord data;
+  std::shared_ptr<SharedMemoryRegion> region;
+  absl::Status region_status;
+  GrpcHostBufferLookupResponse response;
+  while (stream->Read(&response)) {
+    if (!response.shared_memory_name().empty()) {
+      // Open and unlink the segment right away, whatever happens to the rest
+      // of the stream, so that it does not outlive this call. The server
+      // removes it too once the host buffer is deleted, in case we never get
+      // here.
+      const std::string& name = response.shared_memory_name();
+      absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> opened =
+          SharedMemoryRegion::Open(name);
+      if (opened.ok()) {
+        region = *std::move(opened);
+        region_status = region->Unlink();
+      } else {
+        region_status = opened.status();
+        SharedMemoryRegion::Remove(name).IgnoreError();
+      }
+      continue;
     }
+#if defined(PLATFORM_GOOGLE)
+    data.Append(response.data());
+#else
+    // Large strings are adopted by the cord without copying them.
+    data.Append(std::move(*response.mutable_data()));
+#endif
+  }
+
+  TF_RETURN_IF_ERROR(xla::FromGrpcStatus(stream->Finish()));
+  TF_RETURN_IF_ERROR(region_status);
+  if (region != nullptr) {
+    // The cord references the mapping, which is released with the cord.
+    absl::string_view view = region->data();
+    data = absl::MakeCordFromExternal(view, [region = std::move(region)] {});
+  }
+  VLOG(3) << "GrpcClientHostBufferStore::Lookup done "
+          << request.ShortDebugString();
+  return data;
+}
+
+Future<absl::Cord> GrpcClientHostBufferStore::Lookup(uint64_t handle) {
+  auto promise = Future<absl::Cord>::CreatePromise();
 
-    absl::Status status = xla::FromGrpcStatus(stream->Finish());
-    if (status.ok()) {
-      promise.Set(std::move(data));
-    } else {
-      promise.Set(status);
+  XFlowHelper flow("GrpcClientHostBufferStore::Lookup");
+  flow.InstantActivity<XFlowHelper::kSend>();
+
+  work_queue_->Schedule([this, handle, promise, flow]() mutable -> void {
+    auto span = flow.Span<XFlowHelper::kRecv>();
+    // Shared memory is only requested after a store through shared memory
+    // has shown that the server is on the same machine.
+    const bool accept_shared_memory =
+        shared_memory_state_.load(std::memory_order_relaxed) ==
+        SharedMemoryState::kAvailable;
+    absl::StatusOr<absl::Cord> data =
+        LookupChunks(handle, accept_shared_memory);
+    if (accept_shared_memory &&
+        absl::IsFailedPrecondition(data.status())) {
+      // The segment could not be opened; look up the data again by streaming.
+      VLOG(1) << "Falling back to streaming host buffer lookups: "
+              << data.status();
+      shared_memory_state_.store(SharedMemoryState::kUnavailable,
+                                 std::memory_order_relaxed);
+      data = LookupChunks(handle, /*accept_shared_memory=*/false);
     }
-    VLOG(3) << "GrpcClientHostBufferStore::Lookup done "
-            << request.ShortDebugString();
+    promise.Set(std::move(data));
   });
 
   return Future<absl::Cord>(promise);
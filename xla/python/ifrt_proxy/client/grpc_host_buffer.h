@@ -17,11 +17,15 @@
 #ifndef XLA_PYTHON_IFRT_PROXY_CLIENT_GRPC_HOST_BUFFER_H_
 #define XLA_PYTHON_IFRT_PROXY_CLIENT_GRPC_HOST_BUFFER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
+#include "grpc/compression.h"
 #include "xla/python/ifrt/future.h"
 #include "xla/python/ifrt_proxy/client/host_buffer.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
@@ -34,9 +38,25 @@ namespace proxy {
 
 class GrpcClientHostBufferStore : public ClientHostBufferStore {
  public:
+  struct Options {
+    // Maximum size of the data sent in a single `HostBufferStore` message.
+    int64_t chunk_size = 1024 * 1024;
+
+    // Compression used for the `HostBufferStore` streams. gRPC servers
+    // decompress them transparently.
+    grpc_compression_algorithm compression = GRPC_COMPRESS_NONE;
+
+    // Passes host buffers through POSIX shared memory instead of streaming
+    // them if the server turns out to be on the same machine. Stores try
+    // shared memory first and permanently fall back to streaming if the
+    // server cannot open the segment.
+    bool use_shared_memory = false;
+  };
+
   GrpcClientHostBufferStore(
       std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub,
-      IfrtProxyVersion version, uint64_t session_id);
+      IfrtProxyVersion version, uint64_t session_id,
+      Options options = Options());
 
   ~GrpcClientHostBufferStore() override;
 
@@ -48,15 +68,41 @@ class GrpcClientHostBufferStore : public ClientHostBufferStore {
   Future<> Delete(uint64_t handle) override;
 
  private:
+  enum class SharedMemoryState {
+    // No store has used shared memory yet.
+    kUnknown,
+    // A store through shared memory succeeded, so the server is on the same
+    // machine and lookups may use shared memory as well.
+    kAvailable,
+    // Shared memory is disabled or cannot be used with this server.
+    kUnavailable,
+  };
+
+  // Writes `data` to a shared memory segment and passes its name to the
+  // server, which copies it into its host buffer store.
+  absl::Status StoreInSharedMemory(uint64_t handle, const absl::Cord& data);
+
+  // Reads the host buffer `handle` from the server, letting the server pass
+  // it in shared memory if `accept_shared_memory` is true.
+  absl::StatusOr<absl::Cord> LookupChunks(uint64_t handle,
+                                          bool accept_shared_memory);
+
+  // Sends `data` to the server in chunks of at most `options_.chunk_size`
+  // bytes. Blocks until the server has received all the chunks.
+  absl::Status StoreChunks(uint64_t handle, const absl::Cord& data);
+
   const std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub_;
   const IfrtProxyVersion version_;
   const uint64_t session_id_;
+  const Options options_;
+  std::atomic<SharedMemoryState> shared_memory_state_;
 
   // Implementation note: `work_queue_` may have closures that invoke
   // user-defined code. Each `Store()` and `Lookup()` call is associated with a
   // scheduled closure, and the closure is used to first perform synchronous
   // RPC reads or writes, and then to do `promise.Set()` for the Future returned
-  // to the caller.
+  // to the caller. Since every closure runs on its own thread, transfers of
+  // different host buffers proceed concurrently on separate streams.
   std::unique_ptr<tsl::UnboundedWorkQueue> work_queue_;
 };
 
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/cleanup/cleanup.h"
 #include "absl/functional/bind_front.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -52,7 +53,8 @@ namespace {
 
 constexpr absl::Duration kPeriodicFlushInterval = absl::Microseconds(50);
 
-// Thread-safe data structure for holding batched operations.
+// Thread-safe data structure for holding batched operations and deferred
+// requests until they are sent.
 class BatchedOps {
  public:
   using BatchOperation = RpcHelper::BatchOperation;
@@ -62,37 +64,74 @@ class BatchedOps {
     batched_[op].push_back(handle);
   }
 
-  struct IfrtRequests {
-    std::unique_ptr<IfrtRequest> delete_req;
-    std::unique_ptr<IfrtRequest> destruct_req;
+  // A request waiting to be sent. Deferred requests carry the promise to be
+  // fulfilled with their response, batched operations have none.
+  struct PendingRequest {
+    std::unique_ptr<IfrtRequest> request;
+    std::optional<Promise<ClientSession::Response>> promise;
   };
 
-  IfrtRequests Consume() {
-    IfrtRequests result;
+  // Enqueues a deferred request behind all operations batched so far. Fails
+  // `promise` instead if `Close()` was already called.
+  void AddDeferred(std::unique_ptr<IfrtRequest> request,
+                   Promise<ClientSession::Response> promise) {
+    {
+      absl::MutexLock l(&mu_);
+      if (!closed_) {
+        MoveBatchedToPending();
+        pending_.push_back({std::move(request), std::move(promise)});
+        return;
+      }
+    }
+    promise.Set(
+        absl::FailedPreconditionError("RpcHelper::Finish() already called."));
+  }
+
+  // Returns all pending requests in the order in which they must be sent.
+  std::vector<PendingRequest> Consume() {
     absl::MutexLock l(&mu_);
+    MoveBatchedToPending();
+    return std::exchange(pending_, {});
+  }
+
+  // Same as `Consume()`, but also rejects any requests deferred afterwards.
+  std::vector<PendingRequest> Close() {
+    {
+      absl::MutexLock l(&mu_);
+      closed_ = true;
+    }
+    return Consume();
+  }
+
+ private:
+  // Appends the operations batched so far to `pending_`, as one delete and one
+  // destruct request, so that they are sent ahead of requests deferred later.
+  void MoveBatchedToPending() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     if (!batched_[BatchOperation::kDeleteArray].empty()) {
-      result.delete_req = std::make_unique<IfrtRequest>();
+      auto req = std::make_unique<IfrtRequest>();
       for (const auto& arr_handle : batched_[BatchOperation::kDeleteArray]) {
-        result.delete_req->mutable_delete_array_request()->add_array_handle(
+        req->mutable_delete_array_request()->add_array_handle(
             arr_handle.handle);
       }
       batched_[BatchOperation::kDeleteArray].clear();
+      pending_.push_back({std::move(req), std::nullopt});
     }
     if (!batched_[BatchOperation::kDestructArray].empty()) {
-      result.destruct_req = std::make_unique<IfrtRequest>();
+      auto req = std::make_unique<IfrtRequest>();
       for (const auto& arr_handle : batched_[BatchOperation::kDestructArray]) {
-        result.destruct_req->mutable_destruct_array_request()->add_array_handle(
+        req->mutable_destruct_array_request()->add_array_handle(
             arr_handle.handle);
       }
       batched_[BatchOperation::kDestructArray].clear();
+      pending_.push_back({std::move(req), std::nullopt});
     }
-    return result;
   }
 
- private:
   absl::Mutex mu_;
   std::array<std::vector<ArrayHandle>, BatchOperation::kSentinelDoNotUse>
       batched_ ABSL_GUARDED_BY(mu_);
+  std::vector<PendingRequest> pending_ ABSL_GUARDED_BY(mu_);
+  bool closed_ ABSL_GUARDED_BY(mu_) = false;
 };
 
 }  // namespace
@@ -100,7 +139,8 @@ class BatchedOps {
 // Batches any requested operations and flushes them periodically in the
 // background, and allows sending other requested operations immediately.
 // Immediate operations are guaranteed to be sent after all previously enqueued
-// batched operations.
+// batched and deferred operations. Everything sent by a single flush is handed
+// to the transport as one burst.
 class RpcHelper::Batcher {
  public:
   explicit Batcher(std::shared_ptr<ClientSession> session)
@@ -114,16 +154,33 @@ class RpcHelper::Batcher {
   // that have been previously enqueued.
   Future<ClientSession::Response> Immediate(
       std::unique_ptr<IfrtRequest> request) {
+    std::vector<SentRequest> flushed;
+    // Destroyed after `l` below, i.e., runs without holding `mu_`.
+    absl::Cleanup forward_responses = [&flushed] {
+      ForwardResponses(std::move(flushed));
+    };
     absl::MutexLock l(&mu_);
     if (finished_) {
       LOG(WARNING) << "After RpcHelper::Finish(): " << request->DebugString();
       return Future<ClientSession::Response>(
           absl::FailedPreconditionError("RpcHelper::Finish() already called."));
     }
-    Flush();
+    flushed = Flush(/*more_to_follow=*/true);
     return session_->Enqueue(std::move(request));
   }
 
+  // Enqueues `request` to be sent with the next flush, i.e., together with the
+  // next immediate request or by the periodic flusher, whichever comes first.
+  // Deferred requests and batched operations are sent in the order in which
+  // they were enqueued. Guaranteed to not be blocked by the underlying
+  // transport.
+  Future<ClientSession::Response> Deferred(
+      std::unique_ptr<IfrtRequest> request) {
+    auto promise = Future<ClientSession::Response>::CreatePromise();
+    batched_.AddDeferred(std::move(request), promise);
+    return Future<ClientSession::Response>(std::move(promise));
+  }
+
   // Enqueues an operation to be sent later. Guaranteed to not be blocked by the
   // underlying transport.
   void Batch(BatchOperation op, ArrayHandle handle) {
@@ -132,17 +189,26 @@ class RpcHelper::Batcher {
 
   // Asks the underlying transport to terminate.
   void Finish(absl::Status s) {
+    std::vector<BatchedOps::PendingRequest> unsent;
     {
       absl::MutexLock l(&mu_);
       finished_ = true;
-      auto remaining = batched_.Consume();
-      if (remaining.delete_req != nullptr) {
-        LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
-                        "still batched delete operations";
+      unsent = batched_.Close();
+      for (const auto& pending : unsent) {
+        if (pending.request->has_delete_array_request()) {
+          LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
+                          "still batched delete operations";
+        } else if (pending.request->has_destruct_array_request()) {
+          LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
+                          "still batched destruct operations";
+        }
       }
-      if (remaining.destruct_req != nullptr) {
-        LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
-                        "still batched destruct operations";
+    }
+    // Fulfilled without holding `mu_`, since callbacks may issue new RPCs.
+    for (auto& pending : unsent) {
+      if (pending.promise.has_value()) {
+        pending.promise->Set(absl::FailedPreconditionError(
+            "RpcHelper::Finish() called before the request was sent."));
       }
     }
     thread_pool_.reset();
@@ -153,6 +219,10 @@ class RpcHelper::Batcher {
   void PeriodicFlusher() {
     while (true) {
       absl::SleepFor(kPeriodicFlushInterval);
+      std::vector<SentRequest> flushed;
+      absl::Cleanup forward_responses = [&flushed] {
+        ForwardResponses(std::move(flushed));
+      };
       absl::MutexLock l(&mu_);
       if (finished_) {
         return;
@@ -166,28 +236,63 @@ class RpcHelper::Batcher {
         }
       }
       tsl::profiler::TraceMe traceme("proxy_periodic_flush");
-      Flush();
+      flushed = Flush(/*more_to_follow=*/false);
     }
   }
 
-  // Sends all enqueued batched operations.
-  void Flush() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    auto reqs = batched_.Consume();
-    if (reqs.delete_req != nullptr) {
-      XFlowHelper x_flow_helper("batch_delete");
+  // A deferred request that has been handed to the transport.
+  struct SentRequest {
+    Future<ClientSession::Response> response;
+    Promise<ClientSession::Response> promise;
+  };
+
+  // Sends all enqueued deferred requests and batched operations, in the order
+  // in which they were enqueued. If `more_to_follow` is true, the caller must
+  // enqueue another request right after the flush, which terminates the burst.
+  // The caller must pass the returned requests to `ForwardResponses()` after
+  // releasing `mu_`.
+  std::vector<SentRequest> Flush(bool more_to_follow)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    std::vector<BatchedOps::PendingRequest> reqs = batched_.Consume();
+    int remaining = reqs.size();
+    // All but the last request of the burst are sent with a hint that more
+    // requests follow, which lets the transport coalesce them.
+    auto enqueue = [&](std::unique_ptr<IfrtRequest> req) {
+      VLOG(3) << "Sending req: " << req->ShortDebugString();
+      --remaining;
+      if (remaining > 0 || more_to_follow) {
+        return session_->EnqueueWithMoreToFollow(std::move(req));
+      }
+      return session_->Enqueue(std::move(req));
+    };
+    std::vector<SentRequest> sent;
+    for (auto& pending : reqs) {
+      if (pending.promise.has_value()) {
+        sent.push_back({enqueue(std::move(pending.request)),
+                        *std::move(pending.promise)});
+        continue;
+      }
+      XFlowHelper x_flow_helper(pending.request->has_delete_array_request()
+                                    ? "batch_delete"
+                                    : "batch_destruct");
       auto traceme = x_flow_helper.Span<XFlowHelper::kSend>();
-      VLOG(3) << "Sending req: " << reqs.delete_req->ShortDebugString();
-      session_->Enqueue(std::move(reqs.delete_req))
+      enqueue(std::move(pending.request))
           .OnReady(
               absl::bind_front(HandleBatchResponse, session_, x_flow_helper));
     }
-    if (reqs.destruct_req != nullptr) {
-      XFlowHelper x_flow_helper("batch_destruct");
-      auto traceme = x_flow_helper.Span<XFlowHelper::kSend>();
-      VLOG(3) << "Sending req: " << reqs.destruct_req->ShortDebugString();
-      session_->Enqueue(std::move(reqs.destruct_req))
-          .OnReady(
-              absl::bind_front(HandleBatchResponse, session_, x_flow_helper));
+    return sent;
+  }
+
+  // Fulfills the promises of deferred requests with their responses. Must not
+  // be called with `mu_` held, since the promises' callbacks may issue new
+  // RPCs.
+  static void ForwardResponses(std::vector<SentRequest> sent) {
+    for (auto& s : sent) {
+      s.response.OnReady(
+          [promise = std::move(s.promise)](
+              absl::StatusOr<ClientSession::Response> r) mutable {
+            promise.Set(std::move(r));
+          });
     }
   }
 
@@ -240,7 +345,8 @@ Future<std::shared_ptr<Resp>> DoRpc(RpcHelper::Batcher* batcher,
                                     Resp* (IfrtResponse::*get_resp)(),
                                     bool (IfrtResponse::*has_resp)() const,
                                     std::unique_ptr<Req> req,
-                                    absl::string_view profiling_name) {
+                                    absl::string_view profiling_name,
+                                    RpcHelper::Dispatch dispatch) {
   auto ifrt_req = std::make_unique<IfrtRequest>();
   (ifrt_req.get()->*set_req)(req.release());
 
@@ -303,18 +409,37 @@ Future<std::shared_ptr<Resp>> DoRpc(RpcHelper::Batcher* batcher,
     promise.Set(std::move(result));
   };
   VLOG(3) << ifrt_req->ShortDebugString();
-  batcher->Immediate(std::move(ifrt_req)).OnReady(on_ready);
+  switch (dispatch) {
+    case RpcHelper::kImmediate:
+      batcher->Immediate(std::move(ifrt_req)).OnReady(on_ready);
+      break;
+    case RpcHelper::kDeferred:
+      batcher->Deferred(std::move(ifrt_req)).OnReady(on_ready);
+      break;
+  }
 
   return Future<std::shared_ptr<Resp>>(promise);
 }
 
-#define RPC(METHOD, PROPERTY)                                                 \
-  RpcHelper::ResponseFuture<METHOD##Response> RpcHelper::METHOD(              \
-      std::unique_ptr<METHOD##Request> req) {                                 \
-    return DoRpc(                                                             \
-        batcher_.get(), &IfrtRequest::set_allocated_##PROPERTY##_request,     \
-        &IfrtResponse::mutable_##PROPERTY##_response,                         \
-        &IfrtResponse::has_##PROPERTY##_response, std::move(req), #PROPERTY); \
+#define RPC(METHOD, PROPERTY)                                             \
+  RpcHelper::ResponseFuture<METHOD##Response> RpcHelper::METHOD(          \
+      std::unique_ptr<METHOD##Request> req) {                             \
+    return DoRpc(batcher_.get(),                                          \
+                 &IfrtRequest::set_allocated_##PROPERTY##_request,        \
+                 &IfrtResponse::mutable_##PROPERTY##_response,            \
+                 &IfrtResponse::has_##PROPERTY##_response, std::move(req), \
+                 #PROPERTY, kImmediate);                                  \
+  }
+
+// Same as `RPC`, for RPCs that callers may choose to defer.
+#define DEFERRABLE_RPC(METHOD, PROPERTY)                                  \
+  RpcHelper::ResponseFuture<METHOD##Response> RpcHelper::METHOD(          \
+      std::unique_ptr<METHOD##Request> req, Dispatch dispatch) {          \
+    return DoRpc(batcher_.get(),                                          \
+                 &IfrtRequest::set_allocated_##PROPERTY##_request,        \
+                 &IfrtResponse::mutable_##PROPERTY##_response,            \
+                 &IfrtResponse::has_##PROPERTY##_response, std::move(req), \
+                 #PROPERTY, dispatch);                                    \
   }
 
 RPC(Init, init);
@@ -324,17 +449,17 @@ RPC(CheckValueReady, check_value_ready);
 RPC(MakeArrayFromHostBuffer, make_array_from_host_buffer);
 RPC(AssembleArrayFromSingleDeviceArrays,
     assemble_array_from_single_device_arrays);
-RPC(RemapArrays, remap_arrays);
+DEFERRABLE_RPC(RemapArrays, remap_arrays);
 RPC(DisassembleIntoSingleDeviceArrays, disassemble_into_single_device_arrays);
 RPC(CopyToHostBuffer, copy_to_host_buffer);
 RPC(IsArrayDeleted, is_array_deleted);
 RPC(DestructArray, destruct_array)
-RPC(CopyArrays, copy_arrays);
+DEFERRABLE_RPC(CopyArrays, copy_arrays);
 RPC(FullyReplicatedShard, fully_replicated_shard);
 RPC(DeleteArray, delete_array);
 RPC(Compile, compile);
 RPC(LoadedExecutableMetadata, loaded_executable_metadata);
-RPC(LoadedExecutableExecute, loaded_executable_execute);
+DEFERRABLE_RPC(LoadedExecutableExecute, loaded_executable_execute);
 RPC(LoadedExecutableDelete, loaded_executable_delete);
 RPC(LoadedExecutableIsDeleted, loaded_executable_is_deleted);
 RPC(LoadedExecutableDestruct, loaded_executable_destruct);
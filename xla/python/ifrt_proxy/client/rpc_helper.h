@@ -79,6 +79,19 @@ class RpcHelper {
   // from the wrapper functions below.
   void Batch(BatchOperation op, ArrayHandle handle);
 
+  // How a logical RPC is sent to the server.
+  enum Dispatch {
+    // Sent right away, together with all previously deferred RPCs and batched
+    // operations.
+    kImmediate,
+    // Sent with the next immediate RPC or periodic flush, whichever comes
+    // first, as part of a single burst of writes. Meant for RPCs whose results
+    // are only referred to by client-generated handles, so that the caller
+    // does not wait for the response before issuing dependent RPCs. Deferred
+    // RPCs and batched operations are sent in the order they were issued.
+    kDeferred,
+  };
+
   // Wrapper function for various logical RPCs defined in ifrt_service.proto.
   // Whenever the RPC finishes, `on_done` will be called with the result or the
   // return status. `on_done` can be called with various locks held and should
@@ -104,14 +117,15 @@ class RpcHelper {
   AssembleArrayFromSingleDeviceArrays(
       std::unique_ptr<AssembleArrayFromSingleDeviceArraysRequest> req);
   ResponseFuture<RemapArraysResponse> RemapArrays(
-      std::unique_ptr<RemapArraysRequest> req);
+      std::unique_ptr<RemapArraysRequest> req,
+      Dispatch dispatch = kImmediate);
   ResponseFuture<DisassembleIntoSingleDeviceArraysResponse>
   DisassembleIntoSingleDeviceArrays(
       std::unique_ptr<DisassembleIntoSingleDeviceArraysRequest> req);
   ResponseFuture<CopyToHostBufferResponse> CopyToHostBuffer(
       std::unique_ptr<CopyToHostBufferRequest> req);
   ResponseFuture<CopyArraysResponse> CopyArrays(
-      std::unique_ptr<CopyArraysRequest> req);
+      std::unique_ptr<CopyArraysRequest> req, Dispatch dispatch = kImmediate);
   ResponseFuture<FullyReplicatedShardResponse> FullyReplicatedShard(
       std::unique_ptr<FullyReplicatedShardRequest> req);
   ResponseFuture<IsArrayDeletedResponse> IsArrayDeleted(
@@ -126,7 +140,8 @@ class RpcHelper {
   ResponseFuture<LoadedExecutableMetadataResponse> LoadedExecutableMetadata(
       std::unique_ptr<LoadedExecutableMetadataRequest> req);
   ResponseFuture<LoadedExecutableExecuteResponse> LoadedExecutableExecute(
-      std::unique_ptr<LoadedExecutableExecuteRequest> req);
+      std::unique_ptr<LoadedExecutableExecuteRequest> req,
+      Dispatch dispatch = kImmediate);
   ResponseFuture<LoadedExecutableDeleteResponse> LoadedExecutableDelete(
       std::unique_ptr<LoadedExecutableDeleteRequest> req);
   ResponseFuture<LoadedExecutableIsDeletedResponse> LoadedExecutableIsDeleted(
@@ -31,10 +31,13 @@
 #include "xla/python/ifrt_proxy/common/test_utils.h"
 #include "xla/python/ifrt_proxy/common/types.h"
 #include "xla/python/ifrt_proxy/common/types.pb.h"
+#include "xla/tsl/platform/status_matchers.h"
 #include "tsl/platform/test.h"
 
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::UnorderedElementsAre;
+using ::tsl::testing::StatusIs;
 
 namespace xla {
 namespace ifrt {
@@ -149,6 +152,73 @@ TEST_F(RpcHelperTest, BatchedNoPeriodicFlush) {
               UnorderedElementsAre(2, 4, 8, 6));
 }
 
+TEST_F(RpcHelperTest, DeferredSentInOrderWithNextImmediate) {
+  PausePeriodicFlushes();
+  auto copy_req = std::make_unique<CopyArraysRequest>();
+  copy_req->add_array_handles(1);
+  auto copy_future =
+      rpc_helper_->CopyArrays(std::move(copy_req), RpcHelper::kDeferred);
+  rpc_helper_->Batch(RpcHelper::kDestructArray, ArrayHandle{2});
+  auto remap_req = std::make_unique<RemapArraysRequest>();
+  remap_req->add_array_handles(3);
+  auto remap_future =
+      rpc_helper_->RemapArrays(std::move(remap_req), RpcHelper::kDeferred);
+
+  // Nothing has been sent yet, so the deferred RPCs are still pending.
+  EXPECT_FALSE(copy_future.IsReady());
+  EXPECT_FALSE(remap_future.IsReady());
+
+  {
+    auto dummy_request = std::make_unique<CheckFutureRequest>();
+    dummy_request->set_future_handle(4);
+    rpc_helper_->CheckFuture(std::move(dummy_request));
+    requests_.AllowNonEmptyDestruction(/*allow=*/true);
+  }
+
+  // Deferred RPCs and batched operations are sent in the order in which they
+  // were issued, followed by the immediate RPC.
+  EXPECT_THAT(requests_.Pop()->copy_arrays_request().array_handles(),
+              ElementsAre(1));
+  EXPECT_THAT(requests_.Pop()->destruct_array_request().array_handle(),
+              ElementsAre(2));
+  EXPECT_THAT(requests_.Pop()->remap_arrays_request().array_handles(),
+              ElementsAre(3));
+  EXPECT_EQ(requests_.Pop()->check_future_request().future_handle(), 4);
+
+  // Responses of the deferred RPCs are delivered to their futures.
+  EXPECT_THAT(copy_future.Await(),
+              StatusIs(absl::StatusCode::kUnavailable));
+  EXPECT_THAT(remap_future.Await(),
+              StatusIs(absl::StatusCode::kUnavailable));
+}
+
+TEST_F(RpcHelperTest, BatchedSentBeforeLaterDeferred) {
+  PausePeriodicFlushes();
+  rpc_helper_->Batch(RpcHelper::kDeleteArray, ArrayHandle{1});
+  rpc_helper_->Batch(RpcHelper::kDestructArray, ArrayHandle{2});
+  auto execute_req = std::make_unique<LoadedExecutableExecuteRequest>();
+  execute_req->set_loaded_executable_handle(3);
+  auto execute_future = rpc_helper_->LoadedExecutableExecute(
+      std::move(execute_req), RpcHelper::kDeferred);
+  rpc_helper_->Batch(RpcHelper::kDestructArray, ArrayHandle{4});
+  ResumePeriodicFlushes();
+
+  // Operations batched before the deferred RPC are sent ahead of it, the ones
+  // batched afterwards are sent after it.
+  EXPECT_THAT(requests_.Pop()->delete_array_request().array_handle(),
+              ElementsAre(1));
+  EXPECT_THAT(requests_.Pop()->destruct_array_request().array_handle(),
+              ElementsAre(2));
+  EXPECT_EQ(requests_.Pop()
+                ->loaded_executable_execute_request()
+                .loaded_executable_handle(),
+            3);
+  EXPECT_THAT(requests_.Pop()->destruct_array_request().array_handle(),
+              ElementsAre(4));
+  EXPECT_THAT(execute_future.Await(),
+              StatusIs(absl::StatusCode::kUnavailable));
+}
+
 }  // namespace
 }  // namespace proxy
 }  // namespace ifrt
@@ -0,0 +1,225 @@
+// Copyright 2025 The OpenXLA Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/cleanup/cleanup.h"
+#include "absl/log/log.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/tsl/platform/errors.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+namespace {
+
+// Rejects names that `SharedMemoryRegion::Create()` cannot have returned, so
+// that a peer cannot make us open or remove arbitrary segments.
+absl::Status CheckName(absl::string_view name) {
+  if (!absl::StartsWith(name, SharedMemoryRegion::kNamePrefix) ||
+      name.find('/', 1) != absl::string_view::npos) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Not an IFRT proxy shared memory name: ", name));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+#if defined(__linux__)
+
+namespace {
+
+absl::Status ErrnoToStatus(absl::string_view what, absl::string_view name) {
+  return absl::InternalError(
+      absl::StrCat(what, " of shared memory ", name, " failed: ",
+                   std::strerror(errno)));
+}
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> SharedMemoryRegion::Create(
+    size_t size) {
+  if (size == 0) {
+    return absl::InvalidArgumentError("Cannot create empty shared memory");
+  }
+
+  // Names only need to be unique on this machine. The random part keeps other
+  // processes from guessing them.
+  static std::atomic<uint64_t> next_id = 0;
+  absl::BitGen bitgen;
+  std::string name = absl::StrCat(
+      SharedMemoryRegion::kNamePrefix, getpid(), ".", next_id.fetch_add(1),
+      ".", absl::Hex(absl::Uniform<uint64_t>(bitgen)));
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return ErrnoToStatus("Creation", name);
+  }
+  // Allocate the pages up front: `ftruncate` alone does not reserve them, and
+  // writing to the mapping would crash with SIGBUS if /dev/shm is full.
+  if (int err = posix_fallocate(fd, 0, size); err != 0) {
+    errno = err;
+    absl::Status status = err == ENOSPC
+                              ? absl::ResourceExhaustedError(absl::StrCat(
+                                    "Not enough space for ", size,
+                                    " bytes of shared memory ", name))
+                              : ErrnoToStatus("Allocation", name);
+    close(fd);
+    shm_unlink(name.c_str());
+    return status;
+  }
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping keeps the segment alive; the descriptor is no longer needed.
+  close(fd);
+  if (data == MAP_FAILED) {
+    absl::Status status = ErrnoToStatus("Mapping", name);
+    shm_unlink(name.c_str());
+    return status;
+  }
+  return std::unique_ptr<SharedMemoryRegion>(
+      new SharedMemoryRegion(std::move(name), static_cast<char*>(data), size));
+}
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> SharedMemoryRegion::Open(
+    absl::string_view name) {
+  TF_RETURN_IF_ERROR(CheckName(name));
+  std::string name_str(name);
+  int fd = shm_open(name_str.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("Cannot open shared memory ", name, ": ",
+                     std::strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    absl::Status status = ErrnoToStatus("Stat", name);
+    close(fd);
+    return status;
+  }
+  const size_t size = st.st_size;
+  if (size == 0) {
+    close(fd);
+    return absl::FailedPreconditionError(
+        absl::StrCat("Shared memory ", name, " is empty"));
+  }
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return ErrnoToStatus("Mapping", name);
+  }
+  return std::unique_ptr<SharedMemoryRegion>(
+      new SharedMemoryRegion(std::move(name_str), static_cast<char*>(data),
+                             size));
+}
+
+absl::StatusOr<std::string> SharedMemoryRegion::Read(absl::string_view name) {
+  TF_RETURN_IF_ERROR(CheckName(name));
+  std::string name_str(name);
+  int fd = shm_open(name_str.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("Cannot open shared memory ", name, ": ",
+                     std::strerror(errno)));
+  }
+  absl::Cleanup close_fd = [fd] { close(fd); };
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return ErrnoToStatus("Stat", name);
+  }
+
+  // Read until the end of the segment, which may come early if the segment
+  // was truncated after `fstat`.
+  std::string data(st.st_size, '\0');
+  size_t offset = 0;
+  while (offset < data.size()) {
+    ssize_t n = pread(fd, data.data() + offset, data.size() - offset, offset);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) return ErrnoToStatus("Reading", name);
+    if (n == 0) break;
+    offset += n;
+  }
+  data.resize(offset);
+  return data;
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+  if (munmap(data_, size_) != 0) {
+    LOG(WARNING) << ErrnoToStatus("Unmapping", name_);
+  }
+}
+
+absl::Status SharedMemoryRegion::Remove(absl::string_view name) {
+  TF_RETURN_IF_ERROR(CheckName(name));
+  if (shm_unlink(std::string(name).c_str()) != 0 && errno != ENOENT) {
+    return ErrnoToStatus("Unlinking", name);
+  }
+  return absl::OkStatus();
+}
+
+#else  // defined(__linux__)
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> SharedMemoryRegion::Create(
+    size_t size) {
+  return absl::UnimplementedError(
+      "Shared memory host buffers are only supported on Linux");
+}
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> SharedMemoryRegion::Open(
+    absl::string_view name) {
+  TF_RETURN_IF_ERROR(CheckName(name));
+  return absl::FailedPreconditionError(
+      "Shared memory host buffers are only supported on Linux");
+}
+
+absl::StatusOr<std::string> SharedMemoryRegion::Read(absl::string_view name) {
+  TF_RETURN_IF_ERROR(CheckName(name));
+  return absl::FailedPreconditionError(
+      "Shared memory host buffers are only supported on Linux");
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() = default;
+
+absl::Status SharedMemoryRegion::Remove(absl::string_view name) {
+  return CheckName(name);
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 The OpenXLA Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
+#define XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+// A mapping of a named POSIX shared memory segment. Used to pass host buffers
+// between an IFRT proxy client and server running on the same machine without
+// streaming them through gRPC.
+//
+// The process that creates a segment passes its name to the other process,
+// which opens it by name. The segment is freed once it has been unlinked and
+// all its mappings are destroyed.
+class SharedMemoryRegion {
+ public:
+  // Prefix of the names of all segments created by `Create()`. Only such
+  // segments can be opened or removed through this class.
+  static constexpr absl::string_view kNamePrefix = "/ifrt_proxy.";
+
+  // Creates a new segment of `size` bytes with a unique, hard to guess name
+  // and maps it read-write. `size` must be positive. All pages are allocated
+  // up front; returns `ResourceExhaustedError` if there is not enough shared
+  // memory.
+  static absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> Create(
+      size_t size);
+
+  // Opens and maps read-only an existing segment created by `Create()`.
+  // Returns `InvalidArgumentError` if `name` cannot have been returned by
+  // `Create()`, and `FailedPreconditionError` if the segment cannot be opened,
+  // e.g., because it was created on a different machine.
+  static absl::StatusOr<std::unique_ptr<SharedMemoryRegion>> Open(
+      absl::string_view name);
+
+  // Reads the contents of an existing segment created by `Create()`, with the
+  // same errors as `Open()`. Unlike reading through a mapping, this is safe
+  // against the creator truncating the segment concurrently, which just ends
+  // the contents early instead of raising SIGBUS.
+  static absl::StatusOr<std::string> Read(absl::string_view name);
+
+  // Removes the name of the segment created by `Create()` with the given name,
+  // if it still exists. Existing mappings of the segment stay valid.
+  static absl::Status Remove(absl::string_view name);
+
+  ~SharedMemoryRegion();
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+  const std::string& name() const { return name_; }
+  size_t size() const { return size_; }
+
+  // Contents of the mapping. `mutable_data()` may only be used on regions
+  // returned by `Create()`.
+  char* mutable_data() { return data_; }
+  absl::string_view data() const { return absl::string_view(data_, size_); }
+
+  // Removes the name of the segment so that it can no longer be opened. The
+  // existing mappings stay valid.
+  absl::Status Unlink() { return Remove(name_); }
+
+ private:
+  SharedMemoryRegion(std::string name, char* data, size_t size)
+      : name_(std::move(name)), data_(data), size_(size) {}
+
+  std::string name_;
+  char* data_;
+  size_t size_;
+};
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
+
+#endif  // XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
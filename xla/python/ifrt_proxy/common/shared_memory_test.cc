@@ -0,0 +1,112 @@
+// Copyright 2025 The OpenXLA Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+namespace {
+
+using ::tsl::testing::IsOk;
+using ::tsl::testing::IsOkAndHolds;
+using ::tsl::testing::StatusIs;
+
+#if defined(__linux__)
+
+TEST(SharedMemoryRegionTest, CreateAndOpen) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SharedMemoryRegion> writer,
+                          SharedMemoryRegion::Create(5));
+  std::memcpy(writer->mutable_data(), "hello", 5);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SharedMemoryRegion> reader,
+                          SharedMemoryRegion::Open(writer->name()));
+  EXPECT_EQ(reader->data(), "hello");
+
+  // Existing mappings stay valid after the segment is unlinked, but it can no
+  // longer be opened.
+  ASSERT_THAT(writer->Unlink(), IsOk());
+  EXPECT_EQ(reader->data(), "hello");
+  EXPECT_THAT(SharedMemoryRegion::Open(writer->name()),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_THAT(writer->Unlink(), IsOk());
+}
+
+TEST(SharedMemoryRegionTest, ReadTruncated) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SharedMemoryRegion> writer,
+                          SharedMemoryRegion::Create(4096));
+  std::memset(writer->mutable_data(), 'x', 4096);
+  EXPECT_THAT(SharedMemoryRegion::Read(writer->name()),
+              IsOkAndHolds(std::string(4096, 'x')));
+
+  // Shrinking the segment behind the reader's back just shortens the contents.
+  int fd = shm_open(writer->name().c_str(), O_RDWR, 0);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, 5), 0);
+  close(fd);
+  EXPECT_THAT(SharedMemoryRegion::Read(writer->name()),
+              IsOkAndHolds(std::string(5, 'x')));
+  EXPECT_THAT(writer->Unlink(), IsOk());
+}
+
+TEST(SharedMemoryRegionTest, UniqueNames) {
+  TF_ASSERT_OK_AND_ASSIGN(auto a, SharedMemoryRegion::Create(1));
+  TF_ASSERT_OK_AND_ASSIGN(auto b, SharedMemoryRegion::Create(1));
+  EXPECT_NE(a->name(), b->name());
+  EXPECT_THAT(a->Unlink(), IsOk());
+  EXPECT_THAT(b->Unlink(), IsOk());
+}
+
+#endif  // defined(__linux__)
+
+TEST(SharedMemoryRegionTest, CreateEmpty) {
+  EXPECT_THAT(SharedMemoryRegion::Create(0), testing::Not(IsOk()));
+}
+
+TEST(SharedMemoryRegionTest, OpenMissing) {
+  EXPECT_THAT(SharedMemoryRegion::Open("/ifrt_proxy.does_not_exist"),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(SharedMemoryRegionTest, RejectsForeignNames) {
+  EXPECT_THAT(SharedMemoryRegion::Open("/some_other_segment"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(SharedMemoryRegion::Open("/ifrt_proxy.a/../b"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(SharedMemoryRegion::Read("/some_other_segment"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(SharedMemoryRegion::Remove("/some_other_segment"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
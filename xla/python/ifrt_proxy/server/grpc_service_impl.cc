@@ -16,14 +16,18 @@
 
 #include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -34,6 +38,7 @@
 #include "xla/python/ifrt/attribute_map.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/proto_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -42,6 +47,34 @@ namespace xla {
 namespace ifrt {
 namespace proxy {
 
+namespace {
+
+// Returns whether the gRPC `peer` is known to run on this machine. Host buffers
+// are only passed through shared memory to and from such peers, since the
+// segments are looked up by name in the server's namespace.
+bool IsLocalPeer(absl::string_view peer) {
+  return peer == "inproc" || absl::StartsWith(peer, "unix:") ||
+         absl::StartsWith(peer, "unix-abstract:") ||
+         absl::StartsWith(peer, "ipv4:127.") ||
+         absl::StartsWith(peer, "ipv6:[::1]") ||
+         absl::StartsWith(peer, "ipv6:%5B::1%5D") ||
+         absl::StartsWith(peer, "ipv6:[::ffff:127.") ||
+         absl::StartsWith(peer, "ipv6:%5B::ffff:127.");
+}
+
+}  // namespace
+
+GrpcServiceImpl::~GrpcServiceImpl() {
+  absl::MutexLock l(&lookup_segments_mu_);
+  for (const auto& [session_id, handles] : lookup_segments_) {
+    for (const auto& [handle, names] : handles) {
+      for (const std::string& name : names) {
+        SharedMemoryRegion::Remove(name).IgnoreError();
+      }
+    }
+  }
+}
+
 ::grpc::Status GrpcServiceImpl::GetVersion(::grpc::ServerContext* context,
                                            const GrpcGetVersionRequest* request,
                                            GrpcGetVersionResponse* response) {
@@ -88,8 +121,11 @@ namespace proxy {
     CHECK(host_buffer_stores_.insert({session_id, host_buffer_store}).second);
   }
   absl::Cleanup cleanup = [&] {
-    absl::MutexLock l(&host_buffer_store_mu_);
-    CHECK_GT(host_buffer_stores_.erase(session_id), 0);
+    {
+      absl::MutexLock l(&host_buffer_store_mu_);
+      CHECK_GT(host_buffer_stores_.erase(session_id), 0);
+    }
+    RemoveLookupSegments(session_id, /*handle=*/std::nullopt);
   };
 
   absl::StatusOr<AttributeMap> initialization_data =
@@ -162,11 +198,38 @@ namespace proxy {
   VLOG(3) << "HostBufferStore starting to receive data "
           << metadata.ShortDebugString();
   std::string data;
-  data.reserve(metadata.buffer_size());
+  if (!metadata.shared_memory_name().empty()) {
+    // The client claims to be on the same machine and wrote the data to shared
+    // memory, which it unlinks once the store completes. Segment names are
+    // only honored for local peers, since remote peers could otherwise read
+    // back segments of other processes on this machine.
+    if (!IsLocalPeer(context->peer())) {
+      return ::grpc::Status(
+          ::grpc::StatusCode::FAILED_PRECONDITION,
+          absl::StrCat("Shared memory host buffers are not supported for peer ",
+                       context->peer()));
+    }
+    // Read the segment instead of mapping it, since the client could truncate
+    // it while we copy from the mapping and crash the server with SIGBUS.
+    auto contents = SharedMemoryRegion::Read(metadata.shared_memory_name());
+    if (!contents.ok()) {
+      return xla::ToGrpcStatus(contents.status());
+    }
+    if (contents->size() != metadata.buffer_size()) {
+      return ::grpc::Status(
+          ::grpc::StatusCode::DATA_LOSS,
+          absl::StrCat("Shared memory host buffer has ", contents->size(),
+                       " bytes but ", metadata.buffer_size(),
+                       " bytes were expected"));
+    }
+    data = *std::move(contents);
+  } else {
+    data.reserve(metadata.buffer_size());
 
-  GrpcHostBufferStoreRequest request;
-  while (stream->Read(&request)) {
-    data.append(request.data());
+    GrpcHostBufferStoreRequest request;
+    while (stream->Read(&request)) {
+      data.append(request.data());
+    }
   }
   VLOG(3) << "HostBufferStore received all data "
           << metadata.ShortDebugString();
@@ -207,6 +270,28 @@ namespace proxy {
                                         {{"size", size}});
   });
   GrpcHostBufferLookupResponse response;
+  if (request->accept_shared_memory() && !(*data)->empty() &&
+      IsLocalPeer(context->peer())) {
+    // Hand the data to the client in shared memory. Falls back to streaming
+    // if the segment cannot be created.
+    auto region = SharedMemoryRegion::Create((*data)->size());
+    if (region.ok()) {
+      std::memcpy((*region)->mutable_data(), (*data)->data(), (*data)->size());
+      response.set_shared_memory_name((*region)->name());
+      if (stream->Write(response)) {
+        AddLookupSegment(request->session_id(), request->handle(),
+                         (*region)->name());
+      } else {
+        // The client will not unlink the segment.
+        (*region)->Unlink().IgnoreError();
+      }
+      VLOG(3) << "HostBufferLookup sent data in shared memory "
+              << request->ShortDebugString();
+      return ::grpc::Status::OK;
+    }
+    VLOG(1) << "HostBufferLookup cannot use shared memory: "
+            << region.status();
+  }
   if (!(*data)->empty()) {
     for (int64_t offset = 0; offset < (*data)->size(); offset += kChunkSize) {
 #if defined(PLATFORM_GOOGLE)
@@ -233,6 +318,7 @@ namespace proxy {
     ::grpc::ServerContext* context, const GrpcHostBufferDeleteRequest* request,
     GrpcHostBufferDeleteResponse* response) {
   tsl::profiler::TraceMe traceme("HostBufferDelete");
+  RemoveLookupSegments(request->session_id(), request->handle());
   auto store = GetHostBufferStore(request->session_id());
   if (!store.ok()) {
     return xla::ToGrpcStatus(store.status());
@@ -248,10 +334,52 @@ bool GrpcServiceImpl::Test_InsertHostBufferStore(
 }
 
 bool GrpcServiceImpl::Test_DeleteHostBufferStore(uint64_t session_id) {
+  RemoveLookupSegments(session_id, /*handle=*/std::nullopt);
   absl::MutexLock l(&host_buffer_store_mu_);
   return host_buffer_stores_.erase(session_id) > 0;
 }
 
+void GrpcServiceImpl::AddLookupSegment(uint64_t session_id, uint64_t handle,
+                                       std::string name) {
+  absl::MutexLock l(&lookup_segments_mu_);
+  lookup_segments_[session_id][handle].push_back(std::move(name));
+}
+
+void GrpcServiceImpl::RemoveLookupSegments(uint64_t session_id,
+                                           std::optional<uint64_t> handle) {
+  std::vector<std::string> names;
+  {
+    absl::MutexLock l(&lookup_segments_mu_);
+    auto session_it = lookup_segments_.find(session_id);
+    if (session_it == lookup_segments_.end()) {
+      return;
+    }
+    auto& handles = session_it->second;
+    if (handle.has_value()) {
+      auto handle_it = handles.find(*handle);
+      if (handle_it != handles.end()) {
+        names = std::move(handle_it->second);
+        handles.erase(handle_it);
+      }
+    } else {
+      for (auto& [unused_handle, handle_names] : handles) {
+        names.insert(names.end(), handle_names.begin(), handle_names.end());
+      }
+      handles.clear();
+    }
+    if (handles.empty()) {
+      lookup_segments_.erase(session_it);
+    }
+  }
+  // Segments already removed by the client are skipped silently.
+  for (const std::string& name : names) {
+    absl::Status status = SharedMemoryRegion::Remove(name);
+    if (!status.ok()) {
+      LOG(WARNING) << "Cannot remove host buffer lookup segment: " << status;
+    }
+  }
+}
+
 absl::StatusOr<std::shared_ptr<xla::ifrt::proxy::HostBufferStore>>
 GrpcServiceImpl::GetHostBufferStore(uint64_t session_id) {
   absl::MutexLock l(&host_buffer_store_mu_);
@@ -20,7 +20,10 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
@@ -54,6 +57,9 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
   explicit GrpcServiceImpl(BackendFactory backend_factory)
       : backend_factory_(ABSL_DIE_IF_NULL(std::move(backend_factory))) {}
 
+  // Removes any shared memory segments still held for host buffer lookups.
+  ~GrpcServiceImpl() override;
+
   ::grpc::Status GetVersion(::grpc::ServerContext* context,
                             const GrpcGetVersionRequest* request,
                             GrpcGetVersionResponse* response) override;
@@ -84,7 +90,8 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
       std::shared_ptr<xla::ifrt::proxy::HostBufferStore> store);
 
   // Test-only method that removes the given session id from the host buffer
-  // store map. Returns false if the session id does not exist.
+  // store map, as if the session ended. Returns false if the session id does
+  // not exist.
   bool Test_DeleteHostBufferStore(uint64_t session_id);
 
  private:
@@ -92,6 +99,18 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
   GetHostBufferStore(uint64_t session_id)
       ABSL_LOCKS_EXCLUDED(host_buffer_store_mu_);
 
+  // Shared memory segments created for host buffer lookups are normally
+  // removed by the client as soon as it has opened them. In case the client
+  // never does, the server removes them when the host buffer is deleted or the
+  // session ends.
+  void AddLookupSegment(uint64_t session_id, uint64_t handle, std::string name)
+      ABSL_LOCKS_EXCLUDED(lookup_segments_mu_);
+  // Removes the segments of the given host buffer, or of the whole session if
+  // `handle` is not set.
+  void RemoveLookupSegments(uint64_t session_id,
+                            std::optional<uint64_t> handle)
+      ABSL_LOCKS_EXCLUDED(lookup_segments_mu_);
+
   BackendFactory backend_factory_;
   std::atomic<uint64_t> next_session_id_ = 1;
 
@@ -99,6 +118,12 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
   absl::flat_hash_map<uint64_t,
                       std::shared_ptr<xla::ifrt::proxy::HostBufferStore>>
       host_buffer_stores_ ABSL_GUARDED_BY(host_buffer_store_mu_);
+
+  absl::Mutex lookup_segments_mu_;
+  // Maps session ids to host buffer handles to segment names.
+  absl::flat_hash_map<
+      uint64_t, absl::flat_hash_map<uint64_t, std::vector<std::string>>>
+      lookup_segments_ ABSL_GUARDED_BY(lookup_segments_mu_);
 };
 
 }  // namespace proxy
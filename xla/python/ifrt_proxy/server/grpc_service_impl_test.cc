@@ -14,9 +14,13 @@
 
 #include "xla/python/ifrt_proxy/server/grpc_service_impl.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <unistd.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -24,8 +28,11 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "grpc/compression.h"
+#include "grpcpp/client_context.h"
 #include "grpcpp/server.h"
 #include "grpcpp/server_builder.h"
 #include "grpcpp/support/channel_arguments.h"
@@ -33,22 +40,47 @@
 #include "xla/python/ifrt/attribute_map.h"
 #include "xla/python/ifrt_proxy/client/grpc_host_buffer.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
+#include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/ifrt_service.pb.h"
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
 #include "xla/python/ifrt_proxy/server/grpc_server.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
 #include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
+#include "tsl/platform/env.h"
 
 namespace xla {
 namespace ifrt {
 namespace proxy {
 namespace {
 
+using ::testing::IsEmpty;
+using ::testing::Pointee;
+using ::testing::SizeIs;
 using ::tsl::testing::IsOk;
 using ::tsl::testing::IsOkAndHolds;
 using ::tsl::testing::StatusIs;
 
+// Returns the names of the shared memory segments that this process created
+// and that still exist.
+std::vector<std::string> OwnSharedMemorySegments() {
+  std::vector<std::string> result;
+  std::vector<std::string> children;
+  if (!tsl::Env::Default()->GetChildren("/dev/shm", &children).ok()) {
+    return result;
+  }
+  const std::string prefix = absl::StrCat(
+      SharedMemoryRegion::kNamePrefix.substr(/*pos=*/1), getpid(), ".");
+  for (const std::string& child : children) {
+    if (absl::StartsWith(child, prefix)) {
+      result.push_back(child);
+    }
+  }
+  return result;
+}
+
 IfrtProxyVersion Version() {
   IfrtProxyVersion version;
   version.set_protocol_version(kServerMaxVersion);
@@ -141,6 +173,125 @@ TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreAndLookupCord) {
   EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
 }
 
+TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreAndLookupWithOptions) {
+  static constexpr uint64_t kSessionId = 1;
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  GrpcClientHostBufferStore::Options options;
+  options.chunk_size = 1000;
+  options.compression = GRPC_COMPRESS_GZIP;
+  GrpcClientHostBufferStore client(stub_, Version(), kSessionId, options);
+
+  constexpr uint64_t kHandle = 2;
+  const std::string data = GetTestData();
+
+  // Stores a cord made of several chunks that don't align with `chunk_size`.
+  absl::Cord source;
+  for (size_t offset = 0; offset < data.size(); offset += 4096 + 7) {
+    source.Append(absl::string_view(data).substr(offset, 4096 + 7));
+  }
+  ASSERT_THAT(client.Store(kHandle, source).Await(), IsOk());
+  EXPECT_THAT(client.Lookup(kHandle).Await(), IsOkAndHolds(data));
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
+TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreAndLookupWithSharedMemory) {
+  static constexpr uint64_t kSessionId = 1;
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  GrpcClientHostBufferStore::Options options;
+  options.use_shared_memory = true;
+  GrpcClientHostBufferStore client(stub_, Version(), kSessionId, options);
+
+  constexpr uint64_t kHandle = 2;
+  const std::string data = GetTestData();
+
+  // The server is in the same process, so both the store and the lookup can
+  // go through shared memory. Either way, the data must round-trip.
+  ASSERT_THAT(client.Store(kHandle, absl::string_view(data)).Await(), IsOk());
+  EXPECT_THAT(store->Lookup(kHandle), IsOkAndHolds(Pointee(data)));
+  EXPECT_THAT(client.Lookup(kHandle).Await(), IsOkAndHolds(data));
+
+  // Neither direction leaves segments behind.
+  EXPECT_THAT(OwnSharedMemorySegments(), IsEmpty());
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
+TEST_P(GrpcIfrtServiceImplHostBufferTest,
+       LookupSegmentNotOpenedIsRemovedOnDelete) {
+  static constexpr uint64_t kSessionId = 1;
+  if (GetParam() == 0) {
+    GTEST_SKIP() << "Empty host buffers are never sent in shared memory";
+  }
+#if !defined(__linux__)
+  GTEST_SKIP() << "Shared memory host buffers are only supported on Linux";
+#endif
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  GrpcClientHostBufferStore client(stub_, Version(), kSessionId);
+
+  constexpr uint64_t kHandle = 2;
+  ASSERT_THAT(store->Store(kHandle, GetTestData()), IsOk());
+
+  // Look up the buffer without ever opening the segment, like a client that
+  // crashed would.
+  {
+    GrpcHostBufferLookupRequest request;
+    request.set_session_id(kSessionId);
+    request.set_handle(kHandle);
+    request.set_accept_shared_memory(true);
+    ::grpc::ClientContext context;
+    auto stream = stub_->HostBufferLookup(&context, request);
+    GrpcHostBufferLookupResponse response;
+    while (stream->Read(&response)) {
+    }
+    ASSERT_TRUE(stream->Finish().ok());
+  }
+  EXPECT_THAT(OwnSharedMemorySegments(), SizeIs(1));
+
+  ASSERT_THAT(client.Delete(kHandle).Await(), IsOk());
+  EXPECT_THAT(OwnSharedMemorySegments(), IsEmpty());
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
+TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreRejectsMismatchedSegment) {
+  static constexpr uint64_t kSessionId = 1;
+  if (GetParam() == 0) {
+    GTEST_SKIP() << "Shared memory segments cannot be empty";
+  }
+#if !defined(__linux__)
+  GTEST_SKIP() << "Shared memory host buffers are only supported on Linux";
+#endif
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SharedMemoryRegion> region,
+                          SharedMemoryRegion::Create(GetParam()));
+  GrpcHostBufferStoreMetadata metadata;
+  metadata.set_session_id(kSessionId);
+  metadata.set_handle(2);
+  metadata.set_buffer_size(GetParam() + 1);
+  metadata.set_shared_memory_name(region->name());
+
+  ::grpc::ClientContext context;
+  context.AddMetadata("ifrt-proxy-grpc-host-buffer-store-metadata-bin",
+                      metadata.SerializeAsString());
+  GrpcHostBufferStoreResponse response;
+  auto writer = stub_->HostBufferStore(&context, &response);
+  ASSERT_TRUE(writer->WritesDone());
+  EXPECT_EQ(writer->Finish().error_code(), ::grpc::StatusCode::DATA_LOSS);
+
+  EXPECT_THAT(region->Unlink(), IsOk());
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
 TEST_P(GrpcIfrtServiceImplHostBufferTest, Lookup) {
   static constexpr uint64_t kSessionId = 1;
 
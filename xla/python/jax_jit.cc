@@ -143,9 +143,10 @@ std::string ArgumentSignature::DebugString() const {
   auto py_object_formatter = [](std::string* out, const nb::object& o) {
     out->append(nb::cast<absl::string_view>(nb::str(o)));
   };
-  auto treedef_formatter = [](std::string* out, const xla::PyTreeDef& d) {
-    out->append(d.ToString());
-  };
+  auto treedef_formatter =
+      [](std::string* out, const std::shared_ptr<const xla::PyTreeDef>& d) {
+        out->append(d->ToString());
+      };
   return absl::StrFormat(
       "static args (positional + keyword): [%s], "
       "static arg keyword names: [%s], "
@@ -158,7 +159,12 @@ std::string ArgumentSignature::DebugString() const {
 }
 
 bool ArgumentSignature::operator==(const ArgumentSignature& other) const {
-  if (dynamic_arg_treedefs != other.dynamic_arg_treedefs) {
+  auto treedef_equality = [](const std::shared_ptr<const xla::PyTreeDef>& a,
+                             const std::shared_ptr<const xla::PyTreeDef>& b) {
+    return a == b || *a == *b;
+  };
+  if (!absl::c_equal(dynamic_arg_treedefs, other.dynamic_arg_treedefs,
+                     treedef_equality)) {
     return false;
   }
   auto object_ptr_equality = [](nb::handle a, nb::handle b) {
@@ -232,7 +238,59 @@ std::string CallSignature::DebugString() const {
       absl::StrJoin(configs, ", ", py_object_formatter));
 }
 
+namespace {
+
+// Hashes all fields of the call signature that are included in the
+// fingerprint.
+struct CallSignatureFields {
+  const CallSignature& s;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const CallSignatureFields& f) {
+    const CallSignature& s = f.s;
+    h = H::combine(std::move(h), s.arg_signature, s.dynamic_arg_signatures);
+
+    DCHECK(s.dynamic_arg_shardings.empty() ||
+           s.dynamic_arg_shardings.size() == s.dynamic_arg_signatures.size());
+
+    DCHECK(s.dynamic_arg_layouts.empty() ||
+           s.dynamic_arg_layouts.size() == s.dynamic_arg_signatures.size());
+
+    // TODO(chky): For now, we are only hashing the pointer of shardings to
+    // avoid slow python hashing function. Consider implementing hashing
+    // function and equality checks in C++ in jax::Sharding and use those here.
+    for (const auto& sharding : s.dynamic_arg_shardings) {
+      h = H::combine(std::move(h), ShardingHash(sharding));
+    }
+
+    for (const auto& layout : s.dynamic_arg_layouts) {
+      if (layout != nullptr) {
+        h = H::combine(std::move(h), *layout);
+      }
+    }
+
+    h = H::combine(std::move(h), s.committed_args, s.device,
+                   s.jax_enable_x64);
+
+    // We do not hash the extra_jit_context fields since calling Python hash
+    // functions is expensive (~300ns) and we don't expect a large number of
+    // different contexts.
+    return h;
+  }
+};
+
+}  // namespace
+
+size_t CallSignature::ComputeFingerprint() const {
+  return absl::HashOf(CallSignatureFields{*this});
+}
+
 bool CallSignature::operator==(const CallSignature& other) const {
+  // Signatures with different fingerprints are never equal.
+  if (fingerprint.has_value() && other.fingerprint.has_value() &&
+      *fingerprint != *other.fingerprint) {
+    return false;
+  }
   if (arg_signature != other.arg_signature) {
     return false;
   }
@@ -283,22 +341,36 @@ absl::Status ParseArguments(
     absl::Span<int const> static_argnums,
     absl::Span<nb::str const> static_argnames,
     xla::PyTreeRegistry* pytree_registry, ArgumentSignature& signature,
-    absl::InlinedVector<nanobind::object, 2>& flat_dynamic_args) {
+    absl::InlinedVector<nanobind::object, 2>& flat_dynamic_args,
+    absl::Span<std::shared_ptr<const xla::PyTreeDef> const> treedef_hints) {
   tsl::profiler::TraceMe traceme("ParseArguments");
 
   DCHECK(absl::c_all_of(static_argnames, [](const nb::str& name) {
     return PyUnicode_CHECK_INTERNED(name.ptr());
   }));
 
+  // Flattens the next dynamic argument, sharing its treedef hint if the
+  // argument has the same tree structure.
+  auto flatten_dynamic_arg = [&](nb::handle arg) {
+    size_t i = signature.dynamic_arg_treedefs.size();
+    if (i < treedef_hints.size() &&
+        treedef_hints[i]->registry() == pytree_registry &&
+        treedef_hints[i]->FlattenIfSameStructure(arg, flat_dynamic_args)) {
+      signature.dynamic_arg_treedefs.push_back(treedef_hints[i]);
+      return;
+    }
+    auto pytree_def = std::make_shared<xla::PyTreeDef>(pytree_registry);
+    pytree_def->Flatten(arg, flat_dynamic_args);
+    signature.dynamic_arg_treedefs.push_back(std::move(pytree_def));
+  };
+
   flat_dynamic_args.reserve(positional_args.size() + keyword_args.size());
   if (static_argnums.empty()) {
     signature.dynamic_arg_treedefs.reserve(positional_args.size());
 
     // Positional arguments.
     for (int i = 0; i < positional_args.size(); ++i) {
-      signature.dynamic_arg_treedefs.emplace_back(pytree_registry);
-      xla::PyTreeDef& pytree_def = signature.dynamic_arg_treedefs.back();
-      pytree_def.Flatten(nb::handle(positional_args[i]), flat_dynamic_args);
+      flatten_dynamic_arg(nb::handle(positional_args[i]));
     }
   } else {
     signature.dynamic_arg_treedefs.reserve(positional_args.size());
@@ -310,9 +382,7 @@ absl::Status ParseArguments(
                        [i, num_positional_args](int t) {
                          return t >= 0 ? i == t : i == t + num_positional_args;
                        }) == static_argnums.end()) {
-        signature.dynamic_arg_treedefs.emplace_back(pytree_registry);
-        xla::PyTreeDef& pytree_def = signature.dynamic_arg_treedefs.back();
-        pytree_def.Flatten(positional_args[i], flat_dynamic_args);
+        flatten_dynamic_arg(positional_args[i]);
       } else {
         signature.static_args.emplace_back(
             nb::borrow<nb::object>(positional_args[i]));
@@ -360,10 +430,7 @@ absl::Status ParseArguments(
       } else {
         signature.dynamic_arg_names.push_back(
             nb::steal<nb::object>(kwargs[i].first));
-        signature.dynamic_arg_treedefs.emplace_back(pytree_registry);
-        xla::PyTreeDef& pytree_def = signature.dynamic_arg_treedefs.back();
-        pytree_def.Flatten(nb::handle(kwargs[i].second.ptr()),
-                           flat_dynamic_args);
+        flatten_dynamic_arg(nb::handle(kwargs[i].second.ptr()));
       }
     }
   }
@@ -424,7 +491,15 @@ void BuildJaxjitSubmodule(nb::module_& m) {
   argument_signature.def_ro("static_args", &ArgumentSignature::static_args)
       .def_ro("static_arg_names", &ArgumentSignature::static_arg_names)
       .def_ro("dynamic_arg_names", &ArgumentSignature::dynamic_arg_names)
-      .def_ro("dynamic_arg_treedefs", &ArgumentSignature::dynamic_arg_treedefs)
+      .def_prop_ro("dynamic_arg_treedefs",
+                   [](const ArgumentSignature& s) {
+                     absl::InlinedVector<xla::PyTreeDef, 2> treedefs;
+                     treedefs.reserve(s.dynamic_arg_treedefs.size());
+                     for (const auto& treedef : s.dynamic_arg_treedefs) {
+                       treedefs.push_back(*treedef);
+                     }
+                     return treedefs;
+                   })
       .def("__repr__", &ArgumentSignature::DebugString)
       .def("__str__", &ArgumentSignature::DebugString)
       .def("__hash__",
@@ -439,7 +514,8 @@ void BuildJaxjitSubmodule(nb::module_& m) {
       [](nb::sequence positional_args, nb::sequence keyword_args,
          nb::tuple kwnames, absl::Span<int const> static_argnums,
          absl::Span<nb::str const> static_argnames,
-         xla::PyTreeRegistry* pytree_registry) {
+         xla::PyTreeRegistry* pytree_registry,
+         absl::Span<xla::PyTreeDef const> treedef_hints) {
         ArgumentSignature signature;
         absl::InlinedVector<nanobind::object, 2> flat_dynamic_args;
         nb::object positional_args_seq = nb::steal(PySequence_Fast(
@@ -468,16 +544,25 @@ void BuildJaxjitSubmodule(nb::module_& m) {
           static_argnames_interned.push_back(nb::steal<nb::str>(s));
         }
 
+        absl::InlinedVector<std::shared_ptr<const xla::PyTreeDef>, 2>
+            shared_treedef_hints;
+        shared_treedef_hints.reserve(treedef_hints.size());
+        for (const xla::PyTreeDef& treedef : treedef_hints) {
+          shared_treedef_hints.push_back(
+              std::make_shared<xla::PyTreeDef>(treedef));
+        }
+
         xla::ThrowIfError(
             ParseArguments(positional_args_span, keyword_args_span, kwnames,
                            static_argnums, static_argnames_interned,
-                           pytree_registry, signature, flat_dynamic_args));
+                           pytree_registry, signature, flat_dynamic_args,
+                           shared_treedef_hints));
         return std::make_pair(std::move(signature),
                               std::move(flat_dynamic_args));
       },
       nb::arg("positional_args"), nb::arg("keyword_args"), nb::arg("kwnames"),
       nb::arg("static_argnums"), nb::arg("static_argnames"),
-      nb::arg("pytree_registry"),
+      nb::arg("pytree_registry"), nb::arg("treedef_hints") = nb::tuple(),
       R"doc(Parses the arguments to a function as jax.jit would.
 
 Returns a ArgumentSignature and the flattened dynamic arguments.
@@ -489,6 +574,8 @@ Args:
   static_argnums: The static argument numbers.
   static_argnames: The static argument names.
   pytree_registry: The pytree registry.
+  treedef_hints: Optional treedefs of the dynamic arguments, e.g. from a
+    previous call, that are reused if the arguments have the same structure.
 )doc");
 }
 
@@ -99,8 +99,10 @@ std::optional<nanobind::callable> GetPostHook();
 struct ArgumentSignature {
   // A PyTreeDef for each dynamic argument, positional arguments first
   // followed by keyword arguments. Keyword arguments are in the order given
-  // by dynamic_arg_names.
-  absl::InlinedVector<xla::PyTreeDef, 2> dynamic_arg_treedefs;
+  // by dynamic_arg_names. Treedefs are immutable once parsed, so signatures
+  // (and treedef hints, see ParseArguments) share them instead of copying.
+  absl::InlinedVector<std::shared_ptr<const xla::PyTreeDef>, 2>
+      dynamic_arg_treedefs;
 
   // Dynamic keyword argument names. Interned, and sorted by the keyword
   // name. Interned values are safe to compare by pointer.
@@ -124,7 +126,10 @@ struct ArgumentSignature {
 
 template <typename H>
 H AbslHashValue(H h, const ArgumentSignature& s) {
-  h = H::combine(std::move(h), s.dynamic_arg_treedefs,
+  for (const auto& treedef : s.dynamic_arg_treedefs) {
+    h = H::combine(std::move(h), *treedef);
+  }
+  h = H::combine(std::move(h), s.dynamic_arg_treedefs.size(),
                  s.dynamic_arg_names.size(), s.static_args.size(),
                  s.static_arg_names.size());
 
@@ -167,13 +172,18 @@ H AbslHashValue(H h, const ArgumentSignature& s) {
 //  dynamic arguments.
 // flat_dynamic_args: output; the concatenation of the dynamic positional
 //  arguments and sorted keyword arguments.
+// treedef_hints: optional treedefs of the dynamic arguments (e.g. from a
+//  previous call). A hint is shared by `signature`, without building a new
+//  treedef, if the corresponding argument has exactly the same tree structure.
 absl::Status ParseArguments(
     absl::Span<PyObject* const> positional_args,
     absl::Span<PyObject* const> keyword_args, nanobind::handle kwnames,
     absl::Span<int const> static_argnums,
     absl::Span<nanobind::str const> static_argnames,
     xla::PyTreeRegistry* pytree_registry, ArgumentSignature& signature,
-    absl::InlinedVector<nanobind::object, 2>& flat_dynamic_args);
+    absl::InlinedVector<nanobind::object, 2>& flat_dynamic_args,
+    absl::Span<std::shared_ptr<const xla::PyTreeDef> const> treedef_hints =
+        {});
 
 // The signature of Python jitted function call, partitioned into:
 // - dynamic positional arguments (i.e. positional args which are not static)
@@ -218,6 +228,15 @@ struct CallSignature {
 
   std::vector<nanobind::object> configs;
 
+  // Precomputed hash of the call signature. If set, it's used instead of
+  // hashing all fields again (which calls Python to hash static arguments),
+  // and to reject unequal signatures without comparing them field by field.
+  std::optional<size_t> fingerprint;
+
+  // Hashes all fields of the call signature, except the `function_name` and
+  // the Python contexts that are expensive to hash.
+  size_t ComputeFingerprint() const;
+
   bool operator==(const CallSignature& other) const;
   bool operator!=(const CallSignature& other) const {
     return !(*this == other);
@@ -228,33 +247,9 @@ struct CallSignature {
 
 template <typename H>
 H AbslHashValue(H h, const CallSignature& s) {
-  h = H::combine(std::move(h), s.arg_signature, s.dynamic_arg_signatures);
-
-  DCHECK(s.dynamic_arg_shardings.empty() ||
-         s.dynamic_arg_shardings.size() == s.dynamic_arg_signatures.size());
-
-  DCHECK(s.dynamic_arg_layouts.empty() ||
-         s.dynamic_arg_layouts.size() == s.dynamic_arg_signatures.size());
-
-  // TODO(chky): For now, we are only hashing the pointer of shardings to avoid
-  // slow python hashing function. Consider implementing hashing function and
-  // equality checks in C++ in jax::Sharding and use those here.
-  for (const auto& sharding : s.dynamic_arg_shardings) {
-    h = H::combine(std::move(h), ShardingHash(sharding));
-  }
-
-  for (const auto& layout : s.dynamic_arg_layouts) {
-    if (layout != nullptr) {
-      h = H::combine(std::move(h), *layout);
-    }
-  }
-
-  h = H::combine(std::move(h), s.committed_args, s.device, s.jax_enable_x64);
-
-  // We do not hash the extra_jit_context fields since calling Python hash
-  // functions is expensive (~300ns) and we don't expect a large number of
-  // different contexts.
-  return h;
+  return H::combine(std::move(h), s.fingerprint.has_value()
+                                      ? *s.fingerprint
+                                      : s.ComputeFingerprint());
 }
 
 // The function to call in `xla.cc` to add the bindings for this module.
@@ -42,6 +42,41 @@ class JaxJitTest(absltest.TestCase):
     self.assertEqual(sig.dynamic_arg_names, ["b"])
     self.assertEqual(sig.dynamic_arg_treedefs, [leaf, leaf])
 
+  def testParseArgumentsWithTreedefHints(self):
+    def parse(args, treedef_hints=()):
+      return jax_jit.parse_arguments(
+          positional_args=args,
+          keyword_args=[],
+          kwnames=(),
+          static_argnums=[],
+          static_argnames=[],
+          pytree_registry=pytree_registry,
+          treedef_hints=treedef_hints,
+      )
+
+    tree = {"b": [1, (2, None)], "a": 3}
+    sig, args = parse([tree, 4])
+    self.assertEqual(args, [3, 1, 2, 4])
+
+    # Same structure, different leaves.
+    hinted_sig, hinted_args = parse(
+        [{"a": 5, "b": [6, (7, None)]}, 8], sig.dynamic_arg_treedefs
+    )
+    self.assertEqual(hinted_args, [5, 6, 7, 8])
+    self.assertEqual(hinted_sig, sig)
+
+    # Different structures fall back to a regular flatten.
+    for other in [
+        {"a": 5, "c": [6, (7, None)]},
+        {"a": 5, "b": [6, [7, None]]},
+        {"a": 5, "b": [6, (7, 9)]},
+        {"a": 5, "b": [6, ((7,), None)]},
+    ]:
+      other_sig, other_args = parse([other, 8], sig.dynamic_arg_treedefs)
+      expected_leaves, expected_treedef = pytree_registry.flatten(other)
+      self.assertEqual(other_args, expected_leaves + [8])
+      self.assertEqual(other_sig.dynamic_arg_treedefs[0], expected_treedef)
+
 
 if __name__ == "__main__":
   absltest.main()
@@ -323,6 +323,7 @@ class PjitFunction {
   void ClearCache() {
     nb::ft_object_guard lock(cache_);
     executables_->Clear();
+    ClearInlineCache();
   }
 
   std::shared_ptr<PjitFunctionCache::Cache> executables() {
@@ -351,6 +352,15 @@ class PjitFunction {
   void PopulateCacheEntry(PjitCacheEntry& cache_entry,
                           const nb::tuple& out_and_fastpath_data);
 
+  // Adds a compiled cache entry to the inline cache, replacing the oldest
+  // one, and makes its treedefs the hints for flattening the next calls.
+  // Requires the lock on `cache_`.
+  void UpdateInlineCache(const CallSignature& call_signature,
+                         PjitFunctionCache::Cache::Handle cache_handle);
+
+  // Requires the lock on `cache_`.
+  void ClearInlineCache();
+
   std::string function_name_;
   std::optional<nb::callable> fun_;
   nb::callable cache_miss_;
@@ -365,6 +375,23 @@ class PjitFunction {
   // In no-GIL mode executables_ is protected by the object lock on cache_,
   // because it shared an LRU list with cache_.
   std::shared_ptr<PjitFunctionCache::Cache> executables_;
+
+  // A small cache of the most recently dispatched call signatures, in front
+  // of `executables_`. Most jitted functions are called with a handful of
+  // signatures, which are compared by their precomputed fingerprints first.
+  // Hits mark their `executables_` entries as most recently used in the
+  // shared LRU list without looking them up again. Protected by the object
+  // lock on cache_ in no-GIL mode.
+  static constexpr int kInlineCacheSize = 4;
+  xla::InlineLRUCache<CallSignature, std::shared_ptr<PjitCacheEntry>,
+                      kInlineCacheSize>
+      inline_cache_;
+
+  // Treedefs of the dynamic arguments of the last call that missed the inline
+  // cache. Arguments with the same tree structure share them instead of being
+  // flattened into new treedefs. Protected by the object lock on cache_ in
+  // no-GIL mode.
+  absl::InlinedVector<std::shared_ptr<const xla::PyTreeDef>, 2> treedef_hints_;
 };
 
 PjitFunction::PjitFunction(
@@ -403,6 +430,20 @@ void PjitFunction::InitExecutables() {
 PjitFunction::~PjitFunction() {
   nb::ft_object_guard lock(cache_);
   executables_ = nullptr;
+  ClearInlineCache();
+}
+
+void PjitFunction::UpdateInlineCache(
+    const CallSignature& call_signature,
+    PjitFunctionCache::Cache::Handle cache_handle) {
+  inline_cache_.Update(call_signature, std::move(cache_handle));
+  treedef_hints_ = call_signature.arg_signature.dynamic_arg_treedefs;
+}
+
+void PjitFunction::ClearInlineCache() {
+  // Drop the Python objects (e.g. static arguments) held by the signatures.
+  inline_cache_.Clear();
+  treedef_hints_.clear();
 }
 
 void CallShardArgFallback(
@@ -621,12 +662,19 @@ absl::StatusOr<nb::object> PjitFunction::Call(nb::handle callable,
   absl::Span<PyObject* const> keyword_args(args + num_positional_args,
                                            num_keyword_args);
 
+  absl::InlinedVector<std::shared_ptr<const xla::PyTreeDef>, 2> treedef_hints;
+  {
+    nb::ft_object_guard lock(cache_);
+    treedef_hints = treedef_hints_;
+  }
+
   CallSignature call_signature;
   std::vector<nb::object> keep_alive_objects;
   absl::InlinedVector<nb::object, 2> flat_dynamic_args;
   auto status = ParseArguments(
       positional_args, keyword_args, kwnames, static_argnums_, static_argnames_,
-      pytree_registry_.get(), call_signature.arg_signature, flat_dynamic_args);
+      pytree_registry_.get(), call_signature.arg_signature, flat_dynamic_args,
+      treedef_hints);
   if (!status.ok()) {
     VLOG(2) << "ParseArguments failed: " << status;
     return fallback_to_cache_miss();
@@ -663,16 +711,24 @@ absl::StatusOr<nb::object> PjitFunction::Call(nb::handle callable,
     return fallback_to_cache_miss();
   }
 
+  // Hash the signature once; the fingerprint is reused by the inline cache
+  // and by the `executables_` hash map.
+  call_signature.fingerprint = call_signature.ComputeFingerprint();
+
   VLOG(2) << "CallSignature:\n" << call_signature.DebugString();
   bool inserted = false;
+  bool inline_cache_hit = false;
+  PjitFunctionCache::Cache::Handle cache_handle;
   std::shared_ptr<PjitCacheEntry> cache_entry;
   {
     nb::ft_object_guard lock(cache_);
-    cache_entry = executables_->GetOrCreateIfAbsent(
-        call_signature, [this, &inserted](const CallSignature& unused) {
+    cache_entry = inline_cache_.GetOrCreateIfAbsent(
+        call_signature, *executables_,
+        [this, &inserted](const CallSignature& unused) {
           inserted = true;
           return std::make_shared<PjitCacheEntry>(pytree_registry_.get());
-        });
+        },
+        &cache_handle, &inline_cache_hit);
   }
 
   if (!cache_entry->compilation_complete.HasBeenNotified()) {
@@ -733,6 +789,11 @@ absl::StatusOr<nb::object> PjitFunction::Call(nb::handle callable,
     return fallback_to_cache_miss();
   }
 
+  if (!inline_cache_hit) {
+    nb::ft_object_guard lock(cache_);
+    UpdateInlineCache(call_signature, std::move(cache_handle));
+  }
+
   // A vector of [num_inputs].
   auto num_args_arrays = PrepareIfrtInputs(
       *cache_entry->executable, flat_dynamic_args,
@@ -933,6 +994,8 @@ void PjitFunction::ClearPythonReferences() {
   std::swap(cache_miss_, cache_miss);
   std::swap(fun_, fun);
   std::swap(shard_arg_fallback_, shard_arg_fallback);
+  nb::ft_object_guard lock(cache_);
+  ClearInlineCache();
 }
 
 struct PjitFunctionObject {
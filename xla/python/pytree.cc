@@ -761,6 +761,103 @@ void PyTreeDef::FlattenWithPath(nb::handle handle, nanobind::list& leaves,
   FlattenImpl(handle, leaves, leaf_predicate, keypath);
 }
 
+bool PyTreeDef::FlattenIfSameStructureImpl(nb::handle handle, int node,
+                                           nb::object* leaves_end,
+                                           PyTypeObject*& leaf_type) const {
+  const Node& n = traversal_[node];
+  // Matches the children of `handle` from the last to the first, since the
+  // subtree of the last child immediately precedes `node` in the traversal.
+  auto match_children = [&](auto get_child) {
+    int child = node - 1;
+    nb::object* child_leaves_end = leaves_end;
+    for (int i = n.arity - 1; i >= 0; --i) {
+      nb::handle child_handle = get_child(i);
+      if (!child_handle.is_valid() ||
+          !FlattenIfSameStructureImpl(child_handle, child, child_leaves_end,
+                                      leaf_type)) {
+        return false;
+      }
+      child_leaves_end -= traversal_[child].num_leaves;
+      child -= traversal_[child].num_nodes;
+    }
+    return true;
+  };
+
+  switch (n.kind) {
+    case PyTreeKind::kLeaf: {
+      PyTypeObject* type = Py_TYPE(handle.ptr());
+      if (type != leaf_type) {
+        const PyTreeRegistry::Registration* custom;
+        if (registry_->KindOfObject(handle, &custom) != PyTreeKind::kLeaf) {
+          return false;
+        }
+        // Tuple subclasses are classified per object (namedtuples are
+        // detected by their `_fields` attribute), so only cache other types.
+        if (!PyTuple_Check(handle.ptr())) {
+          leaf_type = type;
+        }
+      }
+      *(leaves_end - 1) = nb::borrow<nb::object>(handle);
+      return true;
+    }
+    case PyTreeKind::kNone:
+      return handle.is_none();
+    case PyTreeKind::kTuple:
+      // Only exact tuples are kTuple nodes; subclasses are namedtuples or
+      // leaves.
+      if (!PyTuple_CheckExact(handle.ptr()) ||
+          PyTuple_GET_SIZE(handle.ptr()) != n.arity) {
+        return false;
+      }
+      return match_children(
+          [&](int i) { return nb::handle(PyTuple_GET_ITEM(handle.ptr(), i)); });
+    case PyTreeKind::kList:
+      if (!PyList_CheckExact(handle.ptr()) ||
+          PyList_GET_SIZE(handle.ptr()) != n.arity) {
+        return false;
+      }
+      return match_children(
+          [&](int i) { return nb::handle(PyList_GET_ITEM(handle.ptr(), i)); });
+    case PyTreeKind::kDict: {
+      // A dict with the same size that contains all the keys of this node has
+      // the same sorted keys, so we don't need to sort them again.
+      if (!PyDict_CheckExact(handle.ptr()) ||
+          PyDict_GET_SIZE(handle.ptr()) != n.arity) {
+        return false;
+      }
+      return match_children([&](int i) {
+        PyObject* value = PyDict_GetItemWithError(
+            handle.ptr(), n.sorted_dict_keys[i].ptr());
+        if (value == nullptr) {
+          // The key is missing or raised an error. The regular flattening
+          // reports the error, if any.
+          PyErr_Clear();
+        }
+        return nb::handle(value);
+      });
+    }
+    default:
+      // Namedtuples and custom nodes call into Python to be flattened.
+      return false;
+  }
+}
+
+bool PyTreeDef::FlattenIfSameStructure(
+    nb::handle handle, absl::InlinedVector<nb::object, 2>& leaves) const {
+  if (traversal_.empty()) {
+    return false;
+  }
+  const size_t start_num_leaves = leaves.size();
+  leaves.resize(start_num_leaves + num_leaves());
+  PyTypeObject* leaf_type = nullptr;
+  if (!FlattenIfSameStructureImpl(handle, traversal_.size() - 1,
+                                  leaves.data() + leaves.size(), leaf_type)) {
+    leaves.resize(start_num_leaves);
+    return false;
+  }
+  return true;
+}
+
 /*static*/ bool PyTreeDef::AllLeaves(PyTreeRegistry* registry,
                                      const nb::iterable& x) {
   const PyTreeRegistry::Registration* custom;
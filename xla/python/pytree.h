@@ -242,6 +242,16 @@ class PyTreeDef {
       nanobind::handle handle, nanobind::list& leaves,
       std::optional<nanobind::callable> leaf_predicate = std::nullopt);
 
+  // Flattens a Pytree into `leaves` if it has exactly the tree structure
+  // described by this PyTreeDef, which can then be reused instead of building
+  // a new one. Only trees of None, tuples, lists and dicts are supported. The
+  // walk is guided by the existing traversal: dict keys are looked up instead
+  // of sorted, and leaves are written in place into `leaves`. Returns false,
+  // leaving `leaves` unchanged, if the structure differs.
+  bool FlattenIfSameStructure(
+      nanobind::handle handle,
+      absl::InlinedVector<nanobind::object, 2>& leaves) const;
+
   // Tests whether the given list is a flat list of leaves.
   static bool AllLeaves(PyTreeRegistry* registry, const nanobind::iterable& x);
 
@@ -371,6 +381,14 @@ class PyTreeDef {
                    const std::optional<nanobind::callable>& leaf_predicate,
                    std::optional<std::vector<nanobind::object>>& keypath);
 
+  // Recursive helper used to implement FlattenIfSameStructure(). Matches
+  // `handle` against the subtree rooted at `traversal_[node]`, writing its
+  // leaves into the `num_leaves` slots of `leaves` ending at `leaves_end`.
+  // `leaf_type` caches the last type that was checked to be a leaf.
+  bool FlattenIfSameStructureImpl(nanobind::handle handle, int node,
+                                  nanobind::object* leaves_end,
+                                  PyTypeObject*& leaf_type) const;
+
   template <typename T>
   nanobind::object UnflattenImpl(T leaves) const;
 
@@ -3088,9 +3088,6 @@ module @jit__lambda_ attributes {mhlo.num_partitions = 1 : i32,
       if self.backend.platform != "cpu":
         self.skipTest("Test requires CPU")
 
-      if transpose and use_legacy_api:
-        self.skipTest("Non-default layout is not supported in legacy API")
-
       # Create a numpy array that is not aligned to XLA requirements. XLA's
       # alignment requirements differ for different hardware, so we use the
       # smallest possible value. If we make sure the buffer is not aligned to
@@ -3127,6 +3124,45 @@ module @jit__lambda_ attributes {mhlo.num_partitions = 1 : i32,
       )
       np.testing.assert_array_equal(y, x)
 
+    @parameterized.parameters(False, True)
+    def testZeroCopyIgnoresStridesOfUnitDimensions(self, use_legacy_api):
+      # Using CPU only, since this test is about CPU memory aliasing.
+      if self.backend.platform != "cpu":
+        self.skipTest("Test requires CPU")
+
+      x = _Aligned(np.array(np.random.rand(3, 1, 4), dtype=np.float32))
+      # The stride of the unit dimension is meaningless, but would make the
+      # layout look transposed if it were taken into account.
+      x = np.lib.stride_tricks.as_strided(
+          x, shape=(3, 1, 4), strides=(16, 64, 4)
+      )
+
+      dlpack_tensor = x.__dlpack__()
+      buffer = self._DLPackManagedTensorToBuffer(dlpack_tensor, use_legacy_api)
+      y = np.array(buffer, copy=False)
+
+      x_ptr = x.__array_interface__["data"][0]
+      y_ptr = y.__array_interface__["data"][0]
+      self.assertEqual(
+          x_ptr,
+          y_ptr,
+          msg=f"Buffers are not aliased ({hex(x_ptr)} != {hex(y_ptr)}).",
+      )
+      np.testing.assert_array_equal(y, x)
+
+    @parameterized.parameters(False, True)
+    def testCopyOnNonCompactDlpackTensor(self, use_legacy_api):
+      # Using CPU only, since only CPU tensors can be copied on import.
+      if self.backend.platform != "cpu":
+        self.skipTest("Test requires CPU")
+
+      # Every other column, which no XLA layout can describe.
+      x = np.array(np.random.rand(4, 6), dtype=np.float32)[:, ::2]
+
+      dlpack_tensor = x.__dlpack__()
+      buffer = self._DLPackManagedTensorToBuffer(dlpack_tensor, use_legacy_api)
+      np.testing.assert_array_equal(np.asarray(buffer), x)
+
   tests.append(DLPackTest)
 
   class BufferProtocolTest(parameterized.TestCase):
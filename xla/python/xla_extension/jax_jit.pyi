@@ -73,4 +73,5 @@ def parse_arguments(
     static_argnums: Sequence[int],
     static_argnames: Sequence[str],
     pytree_registry: pytree.PyTreeRegistry,
+    treedef_hints: Sequence[pytree.PyTreeDef] = ...,
 ) -> tuple[ArgumentSignature, Sequence[Any]]: ...
\ No newline at end of file
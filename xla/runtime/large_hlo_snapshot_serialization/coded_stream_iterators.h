@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_CODED_STREAM_ITERATORS_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 
 #include "tsl/platform/protobuf.h"
@@ -71,7 +72,7 @@ class CodedStreamInputIterator {
   typedef char& reference;
 
   explicit CodedStreamInputIterator(
-      tsl::protobuf::io::CodedInputStream* input_stream, int limit = -1)
+      tsl::protobuf::io::CodedInputStream* input_stream, int64_t limit = -1)
       : input_stream_(input_stream), read_limit_(limit) {
     ReadNext();
   }
@@ -120,8 +121,8 @@ class CodedStreamInputIterator {
   tsl::protobuf::io::CodedInputStream* input_stream_;
   char current_byte_;
   bool end_of_stream_ = false;
-  int read_limit_;
-  int read_count_ = 0;
+  int64_t read_limit_;
+  int64_t read_count_ = 0;
 };
 
 }  // namespace xla
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -71,7 +72,8 @@ absl::Status SerializeHloUnoptimizedSnapshot(
   return absl::OkStatus();
 }
 
-absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
+absl::StatusOr<HloUnoptimizedSnapshotWithLiterals>
+DeserializeHloUnoptimizedSnapshotToLiterals(
     tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream) {
   HloUnoptimizedSnapshot metadata;
   {
@@ -85,19 +87,21 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
     }
   }
 
-  HloUnoptimizedSnapshot snapshot_with_args;
+  HloUnoptimizedSnapshotWithLiterals snapshot_with_args;
   if (metadata.version() > kMaxSupportedSnapshotVersion) {
     return absl::InternalError(
         absl::StrCat("Unsupported snapshot version: ", metadata.version()));
   }
 
-  *snapshot_with_args.mutable_hlo_module() =
-      std::move(*metadata.mutable_hlo_module());
+  snapshot_with_args.hlo_module = std::move(*metadata.mutable_hlo_module());
 
   // Deserialize literals
   CodedStreamInputIterator input_it_end;
+  snapshot_with_args.partitions.reserve(metadata.partitions_size());
   for (const auto& partition : metadata.partitions()) {
-    HloInputs* partition_metadata = snapshot_with_args.add_partitions();
+    std::vector<Literal>& partition_arguments =
+        snapshot_with_args.partitions.emplace_back();
+    partition_arguments.reserve(partition.arguments_descriptors_size());
     for (const auto& descriptor : partition.arguments_descriptors()) {
       tsl::protobuf::io::CodedInputStream input_stream(zero_copy_input_stream);
 
@@ -115,8 +119,7 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
             "Failed to deserialize argument with size ", argument_size, ": ",
             literal_or_status.status().message()));
       }
-      *partition_metadata->add_arguments() =
-          literal_or_status.value().ToProto();
+      partition_arguments.push_back(*std::move(literal_or_status));
     }
   }
   tsl::protobuf::io::CodedInputStream input_stream(zero_copy_input_stream);
@@ -127,4 +130,24 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
   return snapshot_with_args;
 }
 
+absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
+    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream) {
+  TF_ASSIGN_OR_RETURN(
+      HloUnoptimizedSnapshotWithLiterals snapshot_with_literals,
+      DeserializeHloUnoptimizedSnapshotToLiterals(zero_copy_input_stream));
+
+  HloUnoptimizedSnapshot snapshot_with_args;
+  *snapshot_with_args.mutable_hlo_module() =
+      std::move(snapshot_with_literals.hlo_module);
+  for (std::vector<Literal>& arguments : snapshot_with_literals.partitions) {
+    HloInputs* partition_metadata = snapshot_with_args.add_partitions();
+    for (Literal& argument : arguments) {
+      *partition_metadata->add_arguments() = argument.ToProto();
+      // Release each argument as soon as it has been converted.
+      argument = Literal();
+    }
+  }
+  return snapshot_with_args;
+}
+
 }  // namespace xla
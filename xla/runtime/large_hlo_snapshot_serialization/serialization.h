@@ -16,8 +16,11 @@ limitations under the License.
 #ifndef XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
 #define XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
 
+#include <vector>
+
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "xla/literal.h"
 #include "xla/service/hlo.pb.h"
 #include "tsl/platform/protobuf.h"
 
@@ -40,6 +43,22 @@ absl::Status SerializeHloUnoptimizedSnapshot(
 // be in the format produced by `SerializeHloUnoptimizedSnapshot`.
 absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
     tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream);
+
+// An HLO unoptimized snapshot whose arguments are kept as literals instead of
+// `LiteralProto`s.
+struct HloUnoptimizedSnapshotWithLiterals {
+  HloModuleProto hlo_module;
+  // Arguments of each partition, in the order they were serialized.
+  std::vector<std::vector<Literal>> partitions;
+};
+
+// Same as `DeserializeHloUnoptimizedSnapshot`, but streams every argument
+// straight into a `Literal` without materializing it as a `LiteralProto`. Peak
+// memory is the size of the arguments plus the size of the largest argument
+// being read, instead of roughly three times the size of the arguments.
+absl::StatusOr<HloUnoptimizedSnapshotWithLiterals>
+DeserializeHloUnoptimizedSnapshotToLiterals(
+    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream);
 }  // namespace xla
 
 #endif  // XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
@@ -71,6 +71,35 @@ TEST(LargeHloSnapshotSerializationTest, SerializeAndDeserialize) {
   EXPECT_EQ(deserialized_snapshot.DebugString(), snapshot.DebugString());
 }
 
+TEST(LargeHloSnapshotSerializationTest, SerializeAndDeserializeToLiterals) {
+  HloUnoptimizedSnapshot snapshot = CreateSnapshot();
+
+  std::string serialized_snapshot;
+  tsl::protobuf::io::StringOutputStream output_stream(&serialized_snapshot);
+  TF_ASSERT_OK(SerializeHloUnoptimizedSnapshot(snapshot, &output_stream));
+
+  tsl::protobuf::io::ArrayInputStream input_stream(serialized_snapshot.data(),
+                                                   serialized_snapshot.size());
+  TF_ASSERT_OK_AND_ASSIGN(
+      HloUnoptimizedSnapshotWithLiterals deserialized_snapshot,
+      DeserializeHloUnoptimizedSnapshotToLiterals(&input_stream));
+
+  EXPECT_EQ(deserialized_snapshot.hlo_module.DebugString(),
+            snapshot.hlo_module().DebugString());
+  ASSERT_EQ(deserialized_snapshot.partitions.size(),
+            snapshot.partitions_size());
+  for (int i = 0; i < snapshot.partitions_size(); ++i) {
+    const HloInputs& partition = snapshot.partitions(i);
+    ASSERT_EQ(deserialized_snapshot.partitions[i].size(),
+              partition.arguments_size());
+    for (int j = 0; j < partition.arguments_size(); ++j) {
+      TF_ASSERT_OK_AND_ASSIGN(Literal expected,
+                              Literal::CreateFromProto(partition.arguments(j)));
+      EXPECT_EQ(deserialized_snapshot.partitions[i][j], expected);
+    }
+  }
+}
+
 TEST(LargeHloSnapshotSerializationTest, SerializeAndDeserializeEmptyModule) {
   HloUnoptimizedSnapshot snapshot = CreateSnapshot();
   *snapshot.mutable_hlo_module() = HloModuleProto();
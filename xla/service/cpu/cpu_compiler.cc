@@ -160,11 +160,14 @@ limitations under the License.
 #include "xla/service/cpu/buffer_info_util.h"
 #include "xla/service/cpu/conv_canonicalization.h"
 #include "xla/service/cpu/cpu_executable.h"
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
 #include "xla/service/cpu/cpu_instruction_fusion.h"
 #include "xla/service/cpu/cpu_layout_assignment.h"
+#include "xla/service/cpu/cpu_multi_output_fusion.h"
 #include "xla/service/cpu/cpu_options.h"
 #include "xla/service/cpu/dot_op_emitter.h"
 #include "xla/service/cpu/executable.pb.h"
+#include "xla/service/cpu/ir_emission_utils.h"
 #include "xla/service/cpu/ir_emitter.h"
 #include "xla/service/cpu/ir_emitter2.h"
 #include "xla/service/cpu/metrics.h"
@@ -220,6 +223,7 @@ limitations under the License.
 #include "tsl/platform/casts.h"
 #include "tsl/platform/cpu_info.h"
 #include "tsl/platform/logging.h"  // IWYU pragma: keep
+#include "tsl/platform/protobuf.h"
 #include "tsl/profiler/lib/traceme.h"
 #include "tsl/profiler/lib/traceme_encode.h"
 
@@ -473,6 +477,33 @@ void AddHloVerifier(HloPassPipeline* pipeline, HloVerifierOpts&& opts = {},
   }
 }
 
+// Float support that keeps low precision operands of mixed precision dots
+// computed by the thunk runtime (see `IsMixedPrecisionEigenDot`).
+class MixedPrecisionDotFloatSupport : public FloatSupport {
+ public:
+  MixedPrecisionDotFloatSupport(PrimitiveType low_precision_type,
+                                bool keep_mixed_precision_dots)
+      : FloatSupport(low_precision_type),
+        keep_mixed_precision_dots_(keep_mixed_precision_dots) {}
+
+  bool SupportsLowPrecisionOperand(const HloInstruction& hlo,
+                                   int64_t operand_index) const override {
+    return FloatSupport::SupportsLowPrecisionOperand(hlo, operand_index) ||
+           IsKeptDot(hlo);
+  }
+
+  bool SupportsMixedPrecisions(const HloInstruction& hlo) const override {
+    return FloatSupport::SupportsMixedPrecisions(hlo) || IsKeptDot(hlo);
+  }
+
+ private:
+  bool IsKeptDot(const HloInstruction& hlo) const {
+    return keep_mixed_precision_dots_ && IsMixedPrecisionEigenDot(hlo);
+  }
+
+  bool keep_mixed_precision_dots_;
+};
+
 }  // namespace
 
 absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
@@ -521,11 +552,21 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
         SubByteNormalization::SET_ELEMENT_SIZE);
     TF_RETURN_IF_ERROR(subbyte_packer_pipeline.Run(module).status());
   }
+  // The thunk runtime computes s8/u8 -> s32 and bf16 -> f32 matmuls without
+  // upcasting their operands (see `IsMixedPrecisionEigenDot`).
+  const bool keep_mixed_precision_dots =
+      module->config().debug_options().xla_cpu_use_thunk_runtime();
+
   HloPassPipeline pipeline("HLO passes through layout assignment");
   AddHloVerifier(&pipeline);
   pipeline.AddPass<BatchedGatherScatterNormalizer>();
   pipeline.AddPass<ResultCaster>();
-  pipeline.AddPass<OperandUpcaster>();
+  pipeline.AddPass<OperandUpcaster>(
+      keep_mixed_precision_dots
+          ? HloPredicate([](const HloInstruction* instr) {
+              return !IsMixedPrecisionEigenDot(*instr);
+            })
+          : HloPredicate());
 
   // Expand random number generation.
   pipeline.AddPass<RngExpander>();
@@ -581,7 +622,7 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
   // Convert BF16 and F8 operations to F32 and F16 respectively so that the CPU
   // backend can support BF16/F8 operations without directly implementing a
   // BF16/F8 lowering for most ops.
-  FloatSupport bf16_support(BF16);
+  MixedPrecisionDotFloatSupport bf16_support(BF16, keep_mixed_precision_dots);
 #if defined(INTEL_MKL) && defined(ENABLE_ONEDNN_V3)
   CpuFloatSupport onednn_bf16_support(BF16);
   if (!is_aot_compile && !is_thunk_runtime) {
@@ -664,7 +705,17 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
       DynamicDimensionInference::ShapeCheckMode::kIgnore;
   pipeline.AddPass<DynamicPadder>(dynamic_padder_options);
   pipeline.AddPass<SelectAndScatterExpander>();
-  pipeline.AddPass<ScatterExpander>(ScatterExpander::kEliminateAllScatters);
+  // XLA:CPU thunk runtime implements scatters that update full rows of the
+  // operand with ScatterThunk, all other scatters are expanded into loops.
+  if (module->config().debug_options().xla_cpu_use_thunk_runtime()) {
+    pipeline.AddPass<ScatterExpander>(
+        ScatterExpander::kEliminateAllScatters,
+        [](const HloInstruction* instr) {
+          return !PotentiallyImplementedAsRowScatter(*instr);
+        });
+  } else {
+    pipeline.AddPass<ScatterExpander>(ScatterExpander::kEliminateAllScatters);
+  }
   pipeline.AddPass<ConvCanonicalization>(target_machine_features);
 
   // Run fp16 dots/convs in fp32 and then downcast the result to fp16.
@@ -819,7 +870,21 @@ absl::Status CpuCompiler::RunHloPassesAfterLayoutAssn(
   }
 
   // Add a fusion pass now that layout assignment is done.
-  pipeline.AddPass<CpuInstructionFusion>();
+  if (module->config().debug_options().xla_cpu_experimental_fusion_mode() ==
+      DebugOptions::CPU_FUSION_MODE_COST_MODEL) {
+    CpuFusionCostModel::Options cost_model_options;
+    cost_model_options.l1_cache_size_in_bytes =
+        target_machine_features->l1_cache_size_in_bytes();
+    cost_model_options.l2_cache_size_in_bytes =
+        target_machine_features->l2_cache_size_in_bytes();
+    cost_model_options.shape_size = ShapeSizeBytesFunction();
+
+    CpuFusionCostModel cost_model(std::move(cost_model_options));
+    pipeline.AddPass<CpuInstructionFusion>(cost_model);
+    pipeline.AddPass<CpuMultiOutputFusion>(cost_model);
+  } else {
+    pipeline.AddPass<CpuInstructionFusion>();
+  }
 
   // The LayoutAssignment pass may leave behind kCopy instructions which are
   // duplicate or NOPs, so remove them with algebraic simplification and CSE.
@@ -1352,6 +1417,14 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
   // CpuExecutable to an AOT compilation result.
   std::vector<std::string> obj_files;
 
+  // We also collect object files compiled for additional CPU instruction sets,
+  // so that the exported AOT compilation result can be loaded on hosts that
+  // do not support all instructions of the current host.
+  std::vector<tsl::port::CPUFeature> multi_versioned_features =
+      CpuFeaturesFromString(debug_options.xla_cpu_multi_versioned_isas());
+  std::vector<ObjFilesVariantProto> obj_files_variants(
+      multi_versioned_features.size());
+
   // We split LLVM module and distribute it across separate DyLibs to enable
   // parallel compilation at run time.
   size_t parallel_codegen_split_count =
@@ -1393,12 +1466,41 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
       /*max_cpu_isa=*/CpuFeatureFromString(debug_options.xla_cpu_max_isa()),
   };
 
+  // Compile all kernels for every multi-versioned instruction set. Each
+  // variant is updated only from its own (synchronized) compilation hook.
+  for (size_t i = 0; i < multi_versioned_features.size(); ++i) {
+    ObjFilesVariantProto* variant = &obj_files_variants[i];
+    variant->set_max_isa(
+        std::string(CpuFeatureToString(multi_versioned_features[i])));
+
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<llvm::TargetMachine> variant_target_machine,
+        JitCompiler::InferMultiVersionedTargetMachine(
+            CompilerTargetOptions(config),
+            IrCompiler::GetCodeGenOptLevel(config),
+            multi_versioned_features[i]));
+    variant->set_target_features(
+        variant_target_machine->getTargetFeatureString().str());
+
+    IrCompiler::CompilationHooks hooks;
+    hooks.post_codegen = [variant](const llvm::Module&,
+                                   const llvm::object::ObjectFile& obj_file) {
+      variant->add_obj_files(obj_file.getData().str());
+    };
+    jit_compiler_options.multi_versioned_targets.push_back(
+        {multi_versioned_features[i], std::move(hooks)});
+  }
+
   TF_ASSIGN_OR_RETURN(
       JitCompiler jit_compiler,
       JitCompiler::Create(CompilerTargetOptions(module->config()),
                           std::move(jit_compiler_options),
                           GetCompilationTaskRunner()));
 
+  // LLVM target features of the object files compiled for the current host.
+  std::string target_features =
+      jit_compiler.target_machine()->getTargetFeatureString().str();
+
   HloComputation* entry_computation = module->entry_computation();
   absl::flat_hash_map<const HloInstruction*, int64_t>
       instruction_to_profile_idx;
@@ -1629,6 +1731,8 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
     // Save object files to be able to export them to AOT compilation
     // result.
     cpu_executable->set_obj_files(std::move(obj_files));
+    cpu_executable->set_obj_files_variants(std::move(obj_files_variants));
+    cpu_executable->set_target_features(std::move(target_features));
 
     // Save compiled symbols to be able to export them to AOT compilation
     // result.
@@ -1705,6 +1809,8 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
                             std::move(hlo_profile_index_map)));
 
   cpu_executable->set_obj_files(std::move(obj_files));
+  cpu_executable->set_obj_files_variants(std::move(obj_files_variants));
+  cpu_executable->set_target_features(std::move(target_features));
 
   if (embed_ir_in_executable) {
     cpu_executable->set_ir_module_string(ir_module_string);
@@ -2035,7 +2141,9 @@ class CpuExecutableAotCompilationResult : public AotCompilationResult {
   Create(const HloModule* hlo_module, const BufferAssignment* buffer_assignment,
          absl::string_view function_name, std::vector<std::string> obj_files,
          std::vector<SymbolProto> symbols, const ThunkSequence* thunks,
-         CompilationResultProto::ObjFileKind obj_file_kind) {
+         CompilationResultProto::ObjFileKind obj_file_kind,
+         absl::Span<const ObjFilesVariantProto> obj_files_variants = {},
+         absl::string_view target_features = "") {
     std::optional<ThunkSequenceProto> thunk_proto;
 
     if (thunks != nullptr) {
@@ -2044,9 +2152,16 @@ class CpuExecutableAotCompilationResult : public AotCompilationResult {
       TF_ASSIGN_OR_RETURN(thunk_proto, thunk_sequence_serdes.ToProto(*thunks));
     }
 
-    return absl::WrapUnique(new CpuExecutableAotCompilationResult(
+    auto result = absl::WrapUnique(new CpuExecutableAotCompilationResult(
         hlo_module, buffer_assignment, function_name, std::move(obj_files),
         std::move(symbols), thunk_proto, obj_file_kind));
+
+    result->proto_.set_target_features(std::string(target_features));
+    for (const ObjFilesVariantProto& variant : obj_files_variants) {
+      *result->proto_.add_obj_files_variants() = variant;
+    }
+
+    return result;
   }
 
   absl::StatusOr<std::string> SerializeAsString() const override {
@@ -2118,6 +2233,46 @@ class CpuExecutableAotCompilationResult : public AotCompilationResult {
 
 }  // namespace
 
+// Returns object files compiled for the newest instruction set supported by
+// the host CPU (see `xla_cpu_multi_versioned_isas`). A variant is selected only
+// if the host CPU supports all of its target features, not just its ISA.
+static absl::StatusOr<const tsl::protobuf::RepeatedPtrField<std::string>*>
+SelectObjFiles(const CompilationResultProto& proto) {
+  // Object files compiled for the exporting host are the best choice, if they
+  // can run on the current host.
+  if (proto.obj_files_variants().empty() ||
+      HostSupportsTargetFeatures(proto.target_features())) {
+    return &proto.obj_files();
+  }
+
+  std::vector<tsl::port::CPUFeature> features;
+  for (const ObjFilesVariantProto& variant : proto.obj_files_variants()) {
+    auto feature = CpuFeatureFromString(variant.max_isa());
+    if (feature.has_value() && !variant.target_features().empty() &&
+        HostSupportsTargetFeatures(variant.target_features())) {
+      features.push_back(*feature);
+    }
+  }
+
+  std::optional<tsl::port::CPUFeature> selected =
+      SelectNewestSupportedCpuFeature(features);
+  if (!selected.has_value()) {
+    return FailedPrecondition(
+        "Host CPU doesn't support target features %s of the XLA:CPU "
+        "executable, or any of its multi-versioned instruction sets",
+        proto.target_features());
+  }
+
+  for (const ObjFilesVariantProto& variant : proto.obj_files_variants()) {
+    if (CpuFeatureFromString(variant.max_isa()) == selected) {
+      VLOG(2) << "Load XLA:CPU object files compiled for " << variant.max_isa();
+      return &variant.obj_files();
+    }
+  }
+
+  return Internal("Failed to find object files for the selected ISA");
+}
+
 absl::StatusOr<std::unique_ptr<Executable>>
 CpuExecutableAotCompilationResult::LoadExecutable(
     Compiler* compiler, const se::StreamExecutor* stream_exec) const {
@@ -2163,14 +2318,16 @@ CpuExecutableAotCompilationResult::LoadExecutable(
             target_machine->createDataLayout()));
   }
 
+  TF_ASSIGN_OR_RETURN(const auto* obj_files, SelectObjFiles(proto_));
+
   // We might have an XLA:CPU executable that has only runtime thunks and
   // doesn't have any corresponding object files, and it's absolutely fine.
-  VLOG(2) << "Load XLA:CPU executable from " << proto_.obj_files_size()
+  VLOG(2) << "Load XLA:CPU executable from " << obj_files->size()
           << " object files; entry_function_name="
           << proto_.entry_function_name();
 
   size_t obj_file_index = 0;
-  for (auto& obj_file : proto_.obj_files()) {
+  for (auto& obj_file : *obj_files) {
     llvm::StringRef data(obj_file.data(), obj_file.size());
     TF_RETURN_IF_ERROR(
         object_loader.AddObjFile(llvm::MemoryBuffer::getMemBuffer(
@@ -2279,7 +2436,9 @@ absl::StatusOr<std::unique_ptr<AotCompilationResult>> CpuCompiler::Export(
   return CpuExecutableAotCompilationResult::Create(
       &cpu_executable->module(), &cpu_executable->buffer_assignment(),
       cpu_executable->module_name(), std::move(obj_files),
-      std::move(compiled_symbols), thunk_sequence, kind);
+      std::move(compiled_symbols), thunk_sequence, kind,
+      cpu_executable->obj_files_variants(),
+      cpu_executable->target_features());
 }
 
 absl::StatusOr<std::unique_ptr<AotCompilationResult>>
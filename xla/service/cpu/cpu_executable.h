@@ -104,6 +104,12 @@ class CpuExecutable : public Executable {
 
   absl::Span<const std::string> obj_files() const { return obj_files_; }
 
+  absl::Span<const ObjFilesVariantProto> obj_files_variants() const {
+    return obj_files_variants_;
+  }
+
+  const std::string& target_features() const { return target_features_; }
+
   std::vector<SymbolProto> get_compiled_symbols_proto() const {
     std::vector<SymbolProto> symbols;
     for (const auto& symbol : compiled_symbols_) {
@@ -119,6 +125,15 @@ class CpuExecutable : public Executable {
     obj_files_ = std::move(obj_files);
   }
 
+  void set_obj_files_variants(
+      std::vector<ObjFilesVariantProto> obj_files_variants) {
+    obj_files_variants_ = std::move(obj_files_variants);
+  }
+
+  void set_target_features(std::string target_features) {
+    target_features_ = std::move(target_features);
+  }
+
   void set_compiled_symbols(
       std::vector<FunctionLibrary::Symbol> compiled_symbols) {
     compiled_symbols_ = std::move(compiled_symbols);
@@ -217,6 +232,11 @@ class CpuExecutable : public Executable {
   // export them to AOT compilation result.
   std::vector<std::string> obj_files_;
 
+  // Object files compiled for additional CPU instruction sets, and LLVM target
+  // features of the `obj_files_` (see `xla_cpu_multi_versioned_isas`).
+  std::vector<ObjFilesVariantProto> obj_files_variants_;
+  std::string target_features_;
+
   // Generate compiled symbols. We capture all compiled symbols so we can export
   // them to AOT compilation result.
   std::vector<FunctionLibrary::Symbol> compiled_symbols_;
@@ -0,0 +1,222 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/service/instruction_fusion.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+
+namespace xla::cpu {
+
+CpuFusionCostModel::CpuFusionCostModel(Options options)
+    : options_(std::move(options)) {}
+
+int64_t CpuFusionCostModel::ShapeSizeBytes(const Shape& shape) {
+  // On the cpu, opaques are pointers.
+  if (shape.IsOpaque()) {
+    return static_cast<int64_t>(sizeof(void*));
+  }
+  return ShapeUtil::ByteSizeOf(shape, sizeof(void*));
+}
+
+std::unique_ptr<HloCostAnalysis> CpuFusionCostModel::Analyze(
+    const HloInstruction& instr) const {
+  HloCostAnalysis::Options options;
+  options.shape_size = options_.shape_size;
+  // Count repeated reads of operand elements (e.g. by broadcasts), as fusion
+  // recomputes producer elements for every read.
+  options.count_multiple_input_accesses = true;
+
+  auto analysis = std::make_unique<HloCostAnalysis>(options);
+  absl::Status status =
+      analysis->RevisitInstruction(const_cast<HloInstruction*>(&instr));
+  if (!status.ok()) {
+    VLOG(3) << "Failed to analyze " << instr.name() << ": " << status;
+    return nullptr;
+  }
+  return analysis;
+}
+
+double CpuFusionCostModel::MemorySeconds(double bytes,
+                                         int64_t buffer_size) const {
+  if (buffer_size <= options_.l1_cache_size_in_bytes) {
+    return bytes / options_.l1_bytes_per_second;
+  }
+  if (buffer_size <= options_.l2_cache_size_in_bytes) {
+    return bytes / options_.l2_bytes_per_second;
+  }
+  return bytes / options_.memory_bytes_per_second;
+}
+
+double CpuFusionCostModel::MemorySeconds(
+    const HloInstruction& instr, const HloCostAnalysis& analysis) const {
+  double seconds = MemorySeconds(analysis.output_bytes_accessed(instr),
+                                 BufferSizes(instr.shape()));
+  for (int64_t i = 0; i < instr.operand_count(); ++i) {
+    seconds += MemorySeconds(analysis.operand_bytes_accessed(instr, i),
+                             BufferSizes(instr.operand(i)->shape()));
+  }
+  return seconds;
+}
+
+absl::Duration CpuFusionCostModel::RunTime(double flops,
+                                           double transcendentals,
+                                           double memory_seconds) const {
+  double compute_seconds =
+      flops / options_.flops_per_second +
+      transcendentals / options_.transcendentals_per_second;
+  return absl::Seconds(std::max(compute_seconds, memory_seconds)) +
+         options_.thunk_dispatch_cost;
+}
+
+int64_t CpuFusionCostModel::BufferSizes(const Shape& shape) const {
+  int64_t size = 0;
+  ShapeUtil::ForEachSubshape(
+      shape, [&](const Shape& subshape, const ShapeIndex& index) {
+        if (subshape.IsArray()) size += options_.shape_size(subshape);
+      });
+  return size;
+}
+
+absl::Duration CpuFusionCostModel::EstimateRunTime(
+    const HloInstruction& instr) const {
+  std::unique_ptr<HloCostAnalysis> analysis = Analyze(instr);
+  if (analysis == nullptr) return options_.thunk_dispatch_cost;
+
+  return RunTime(analysis->flop_count(instr),
+                 analysis->transcendental_count(instr),
+                 MemorySeconds(instr, *analysis));
+}
+
+FusionDecision CpuFusionCostModel::ShouldFuse(
+    const HloInstruction& producer, const HloInstruction& consumer) const {
+  std::unique_ptr<HloCostAnalysis> producer_analysis = Analyze(producer);
+  std::unique_ptr<HloCostAnalysis> consumer_analysis = Analyze(consumer);
+
+  // Defer to fusion heuristics if we can't estimate the cost.
+  if (producer_analysis == nullptr || consumer_analysis == nullptr) {
+    return FusionDecision::Allow();
+  }
+
+  absl::Duration producer_time =
+      RunTime(producer_analysis->flop_count(producer),
+              producer_analysis->transcendental_count(producer),
+              MemorySeconds(producer, *producer_analysis));
+
+  absl::Duration unfused_time =
+      producer_time +
+      RunTime(consumer_analysis->flop_count(consumer),
+              consumer_analysis->transcendental_count(consumer),
+              MemorySeconds(consumer, *consumer_analysis));
+
+  // In the fused loop consumer computes producer elements on the fly, as many
+  // times as it reads them, and reads producer operands instead of its result.
+  double reuse = 0.0;
+  double memory_seconds =
+      MemorySeconds(consumer_analysis->output_bytes_accessed(consumer),
+                    BufferSizes(consumer.shape()));
+
+  for (int64_t i = 0; i < consumer.operand_count(); ++i) {
+    const HloInstruction* operand = consumer.operand(i);
+    if (operand == &producer) {
+      reuse += consumer_analysis->operand_utilization(consumer, i);
+      continue;
+    }
+    memory_seconds +=
+        MemorySeconds(consumer_analysis->operand_bytes_accessed(consumer, i),
+                      BufferSizes(operand->shape()));
+  }
+
+  for (int64_t i = 0; i < producer.operand_count(); ++i) {
+    memory_seconds += MemorySeconds(
+        reuse * producer_analysis->operand_bytes_accessed(producer, i),
+        BufferSizes(producer.operand(i)->shape()));
+  }
+
+  absl::Duration fused_time = RunTime(
+      consumer_analysis->flop_count(consumer) +
+          reuse * producer_analysis->flop_count(producer),
+      consumer_analysis->transcendental_count(consumer) +
+          reuse * producer_analysis->transcendental_count(producer),
+      memory_seconds);
+
+  // Producer with other users still has to be materialized.
+  if (producer.user_count() > 1) {
+    fused_time += producer_time;
+  }
+
+  VLOG(3) << absl::StreamFormat(
+      "Fusion of %s into %s: unfused time %s, fused time %s", producer.name(),
+      consumer.name(), absl::FormatDuration(unfused_time),
+      absl::FormatDuration(fused_time));
+
+  if (fused_time > unfused_time) {
+    return FusionDecision::Forbid(absl::StrFormat(
+        "Fusion is not profitable: fused time %s, unfused time %s",
+        absl::FormatDuration(fused_time), absl::FormatDuration(unfused_time)));
+  }
+  return FusionDecision::Allow();
+}
+
+absl::Duration CpuFusionCostModel::EstimateMultiOutputFusionSavings(
+    const HloInstruction& instr1, const HloInstruction& instr2) const {
+  // Multi-output fusion loops are not partitioned between threads, and we
+  // don't want to trade intra-op parallelism for saved memory traffic. Only
+  // merge instructions if all their results fit into the L2 cache.
+  if (BufferSizes(instr1.shape()) + BufferSizes(instr2.shape()) >
+      options_.l2_cache_size_in_bytes) {
+    return absl::ZeroDuration();
+  }
+
+  std::unique_ptr<HloCostAnalysis> analysis1 = Analyze(instr1);
+  std::unique_ptr<HloCostAnalysis> analysis2 = Analyze(instr2);
+  if (analysis1 == nullptr || analysis2 == nullptr) {
+    return absl::ZeroDuration();
+  }
+
+  // Merged fusion saves a thunk dispatch and reads shared operands once.
+  double saved_seconds = 0.0;
+  absl::flat_hash_set<const HloInstruction*> shared_operands;
+  for (int64_t i = 0; i < instr1.operand_count(); ++i) {
+    const HloInstruction* operand = instr1.operand(i);
+    for (int64_t j = 0; j < instr2.operand_count(); ++j) {
+      if (instr2.operand(j) != operand ||
+          !shared_operands.insert(operand).second) {
+        continue;
+      }
+      saved_seconds += MemorySeconds(
+          std::min(analysis1->operand_bytes_accessed(instr1, i),
+                   analysis2->operand_bytes_accessed(instr2, j)),
+          BufferSizes(operand->shape()));
+    }
+  }
+
+  return options_.thunk_dispatch_cost + absl::Seconds(saved_seconds);
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,106 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_CPU_CPU_FUSION_COST_MODEL_H_
+#define XLA_SERVICE_CPU_CPU_FUSION_COST_MODEL_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/service/instruction_fusion.h"
+#include "xla/shape.h"
+
+namespace xla::cpu {
+
+// A cost model for XLA:CPU fusion decisions.
+//
+// Run time of an instruction is estimated with a roofline model: the time to
+// compute all flops and transcendentals vs. the time to access all bytes, plus
+// a fixed cost of dispatching a thunk in the XLA:CPU runtime. Accessed bytes
+// are priced by the level of the memory hierarchy they are likely served from:
+// buffers that fit into the L1 or L2 cache are assumed to be cache resident,
+// and larger buffers are streamed from memory.
+//
+// With this model fusing a producer with a small result mostly saves a thunk
+// dispatch, and fusing a producer with a large result saves a round trip to
+// memory. Fusion is rejected when recomputing the producer for every use in
+// the consumer, and re-reading its operands, costs more than materializing it.
+class CpuFusionCostModel {
+ public:
+  struct Options {
+    int64_t l1_cache_size_in_bytes = 32 * 1024;
+    int64_t l2_cache_size_in_bytes = 1024 * 1024;
+
+    // Single core throughput of the compute units and the memory hierarchy.
+    double flops_per_second = 32e9;
+    double transcendentals_per_second = 4e9;
+    double l1_bytes_per_second = 200e9;
+    double l2_bytes_per_second = 80e9;
+    double memory_bytes_per_second = 15e9;
+
+    // Cost of launching a kernel thunk in the XLA:CPU runtime.
+    absl::Duration thunk_dispatch_cost = absl::Nanoseconds(200);
+
+    HloCostAnalysis::ShapeSizeFunction shape_size = ShapeSizeBytes;
+  };
+
+  explicit CpuFusionCostModel(Options options);
+
+  // Returns the estimated run time of the instruction as a standalone thunk.
+  absl::Duration EstimateRunTime(const HloInstruction& instr) const;
+
+  // Returns if fusing `producer` into `consumer` is estimated to be faster
+  // than running them as separate thunks.
+  FusionDecision ShouldFuse(const HloInstruction& producer,
+                            const HloInstruction& consumer) const;
+
+  // Returns the estimated run time saved by merging two sibling instructions
+  // into a multi-output fusion. Returns zero duration if merging is not
+  // profitable.
+  absl::Duration EstimateMultiOutputFusionSavings(
+      const HloInstruction& instr1, const HloInstruction& instr2) const;
+
+  const Options& options() const { return options_; }
+
+ private:
+  static int64_t ShapeSizeBytes(const Shape& shape);
+
+  // Runs cost analysis for a single instruction (and its nested computations).
+  // Returns nullptr if the instruction can't be analyzed.
+  std::unique_ptr<HloCostAnalysis> Analyze(const HloInstruction& instr) const;
+
+  // Returns the time in seconds to access `bytes` of a buffer of the given
+  // size.
+  double MemorySeconds(double bytes, int64_t buffer_size) const;
+
+  // Returns the time in seconds to access all operands and results.
+  double MemorySeconds(const HloInstruction& instr,
+                       const HloCostAnalysis& analysis) const;
+
+  absl::Duration RunTime(double flops, double transcendentals,
+                         double memory_seconds) const;
+
+  // Returns the total size of all array buffers defined by the shape.
+  int64_t BufferSizes(const Shape& shape) const;
+
+  Options options_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_SERVICE_CPU_CPU_FUSION_COST_MODEL_H_
@@ -0,0 +1,104 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/tests/hlo_test_base.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla::cpu {
+namespace {
+
+using CpuFusionCostModelTest = HloTestBase;
+
+TEST_F(CpuFusionCostModelTest, FuseElementwiseChain) {
+  constexpr absl::string_view kHlo = R"(
+    HloModule m
+
+    ENTRY e {
+      p0 = f32[1024,1024] parameter(0)
+      p1 = f32[1024,1024] parameter(1)
+      exp = f32[1024,1024] exponential(p0)
+      ROOT add = f32[1024,1024] add(exp, p1)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  CpuFusionCostModel cost_model({});
+
+  HloInstruction* exp = FindInstruction(module.get(), "exp");
+  HloInstruction* add = FindInstruction(module.get(), "add");
+
+  EXPECT_GT(cost_model.EstimateRunTime(*exp), absl::ZeroDuration());
+  EXPECT_TRUE(cost_model.ShouldFuse(*exp, *add).CanFuse());
+}
+
+TEST_F(CpuFusionCostModelTest, DoNotRecomputeExpensiveBroadcastedProducer) {
+  constexpr absl::string_view kHlo = R"(
+    HloModule m
+
+    ENTRY e {
+      p0 = f32[1024] parameter(0)
+      exp = f32[1024] exponential(p0)
+      ROOT broadcast = f32[64,1024] broadcast(exp), dimensions={1}
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  CpuFusionCostModel cost_model({});
+
+  HloInstruction* exp = FindInstruction(module.get(), "exp");
+  HloInstruction* broadcast = FindInstruction(module.get(), "broadcast");
+
+  EXPECT_FALSE(cost_model.ShouldFuse(*exp, *broadcast).CanFuse());
+}
+
+TEST_F(CpuFusionCostModelTest, MultiOutputFusionSavings) {
+  constexpr absl::string_view kHlo = R"(
+    HloModule m
+
+    ENTRY e {
+      p0 = f32[1024] parameter(0)
+      p1 = f32[1024,1024] parameter(1)
+      neg = f32[1024] negate(p0)
+      exp = f32[1024] exponential(p0)
+      large_neg = f32[1024,1024] negate(p1)
+      large_exp = f32[1024,1024] exponential(p1)
+      ROOT tuple = (f32[1024], f32[1024], f32[1024,1024], f32[1024,1024])
+        tuple(neg, exp, large_neg, large_exp)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  CpuFusionCostModel cost_model({});
+
+  HloInstruction* neg = FindInstruction(module.get(), "neg");
+  HloInstruction* exp = FindInstruction(module.get(), "exp");
+  HloInstruction* large_neg = FindInstruction(module.get(), "large_neg");
+  HloInstruction* large_exp = FindInstruction(module.get(), "large_exp");
+
+  // Small siblings save at least a thunk dispatch.
+  EXPECT_GE(cost_model.EstimateMultiOutputFusionSavings(*neg, *exp),
+            cost_model.options().thunk_dispatch_cost);
+
+  // Results do not fit into L2 cache, and we don't merge them.
+  EXPECT_EQ(
+      cost_model.EstimateMultiOutputFusionSavings(*large_neg, *large_exp),
+      absl::ZeroDuration());
+}
+
+}  // namespace
+}  // namespace xla::cpu
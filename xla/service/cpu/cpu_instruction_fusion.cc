@@ -105,6 +105,14 @@ bool CpuInstructionFusion::ShouldSkip(const HloInstruction* inst) const {
   return instructions_to_skip_.contains(inst);
 }
 
+FusionDecision CpuInstructionFusion::ShouldLoopFuse(
+    const HloInstruction* producer, const HloInstruction* consumer) const {
+  if (!cost_model_.has_value()) {
+    return FusionDecision::Allow();
+  }
+  return cost_model_->ShouldFuse(*producer, *consumer);
+}
+
 FusionDecision CpuInstructionFusion::ShouldFuse(HloInstruction* consumer,
                                                 int64_t operand_index) {
   if (ShouldSkip(consumer)) {
@@ -258,12 +266,12 @@ FusionDecision CpuInstructionFusion::ShouldFuse(HloInstruction* consumer,
 
   if (consumer->IsLoopFusion()) {
     VLOG(2) << "Fusing: consumer is a fusion node.";
-    return FusionDecision::Allow();
+    return ShouldLoopFuse(producer, consumer);
   }
 
   if (CanBeLoopFused(*consumer)) {
     VLOG(2) << "Fusing: consumer is elementwise or fusible.";
-    return FusionDecision::Allow();
+    return ShouldLoopFuse(producer, consumer);
   }
 
   return FusionDecision::Forbid("Not fusing: not found a fusible case");
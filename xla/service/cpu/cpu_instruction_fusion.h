@@ -17,12 +17,15 @@ limitations under the License.
 #define XLA_SERVICE_CPU_CPU_INSTRUCTION_FUSION_H_
 
 #include <cstdint>
+#include <optional>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
 #include "xla/service/fusion_node_indexing_evaluation.h"
 #include "xla/service/instruction_fusion.h"
 
@@ -33,6 +36,12 @@ class CpuInstructionFusion : public InstructionFusion {
  public:
   CpuInstructionFusion()
       : InstructionFusion(CpuInstructionFusion::IsExpensive) {}
+
+  // Loop fusion decisions that pass fusion heuristics are additionally checked
+  // with the cost model.
+  explicit CpuInstructionFusion(CpuFusionCostModel cost_model)
+      : InstructionFusion(CpuInstructionFusion::IsExpensive),
+        cost_model_(std::move(cost_model)) {}
   ~CpuInstructionFusion() override = default;
 
   using HloPassInterface::Run;
@@ -64,6 +73,12 @@ class CpuInstructionFusion : public InstructionFusion {
   bool IsLargeConstant(const HloInstruction* constant) const;
 
   bool ShouldSkip(const HloInstruction* inst) const;
+
+  // Returns the cost model decision for the loop fusion, or allows fusion if
+  // the cost model is not enabled.
+  FusionDecision ShouldLoopFuse(const HloInstruction* producer,
+                                const HloInstruction* consumer) const;
+
   void ComputeInstructionsToSkip(
       HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads);
@@ -74,6 +89,8 @@ class CpuInstructionFusion : public InstructionFusion {
       fusion_node_evaluations_;
 
   absl::flat_hash_set<const HloInstruction*> instructions_to_skip_;
+
+  std::optional<CpuFusionCostModel> cost_model_;
 };
 
 }  // namespace cpu
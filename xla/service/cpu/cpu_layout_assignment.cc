@@ -119,6 +119,8 @@ static bool OperandsAndResultMustHaveRowMajorLayout(
                                                       target_machine_features);
   } else if (instr.opcode() == HloOpcode::kCustomCall) {
     return instr.custom_call_target() == "TopK";
+  } else if (instr.opcode() == HloOpcode::kScatter) {
+    return PotentiallyImplementedAsRowScatter(instr);
   }
   return false;
 }
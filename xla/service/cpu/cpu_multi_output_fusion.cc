@@ -0,0 +1,65 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_multi_output_fusion.h"
+
+#include <cstdint>
+
+#include "absl/algorithm/container.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+
+namespace xla::cpu {
+
+// Returns the shape of the loop nest emitted for the loop fusion.
+static const Shape& GetLoopShape(const HloInstruction* fusion) {
+  const HloInstruction* root = fusion->fused_expression_root();
+  if (root->opcode() == HloOpcode::kTuple) {
+    return root->operand(0)->shape();
+  }
+  return root->shape();
+}
+
+bool CpuMultiOutputFusion::ShapesCompatibleForFusion(HloInstruction* instr1,
+                                                     HloInstruction* instr2) {
+  return ShapeUtil::EqualIgnoringElementType(GetLoopShape(instr1),
+                                             GetLoopShape(instr2));
+}
+
+bool CpuMultiOutputFusion::IsFusible(HloInstruction* instr) {
+  if (!instr->IsLoopFusion()) return false;
+
+  // Dynamic update slices are updated in place, and can't share a loop nest
+  // with other results.
+  const HloInstruction* root = instr->fused_expression_root();
+  auto is_dynamic_update_slice = [](const HloInstruction* hlo) {
+    return hlo->opcode() == HloOpcode::kDynamicUpdateSlice;
+  };
+  if (root->opcode() == HloOpcode::kTuple) {
+    return absl::c_none_of(root->operands(), is_dynamic_update_slice);
+  }
+  return !is_dynamic_update_slice(root) && root->shape().IsArray();
+}
+
+int64_t CpuMultiOutputFusion::GetProfit(HloInstruction* instr1,
+                                        HloInstruction* instr2) {
+  return absl::ToInt64Nanoseconds(
+      cost_model_.EstimateMultiOutputFusionSavings(*instr1, *instr2));
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,57 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_CPU_CPU_MULTI_OUTPUT_FUSION_H_
+#define XLA_SERVICE_CPU_CPU_MULTI_OUTPUT_FUSION_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
+#include "xla/service/multi_output_fusion.h"
+
+namespace xla::cpu {
+
+// Merges sibling loop fusions that read the same operands into multi-output
+// loop fusions, if the cost model estimates that saved thunk dispatch and
+// memory traffic make it profitable. Fusions are merged only if they iterate
+// over the same loop nest, as XLA:CPU emits a single elemental loop for all
+// multi-output fusion results.
+class CpuMultiOutputFusion : public MultiOutputFusion {
+ public:
+  explicit CpuMultiOutputFusion(CpuFusionCostModel cost_model)
+      : cost_model_(std::move(cost_model)) {}
+
+  absl::string_view name() const override {
+    return "cpu-multi-output-fusion";
+  }
+
+ protected:
+  bool ShapesCompatibleForFusion(HloInstruction* instr1,
+                                 HloInstruction* instr2) override;
+
+  bool IsFusible(HloInstruction* instr) override;
+
+  int64_t GetProfit(HloInstruction* instr1, HloInstruction* instr2) override;
+
+ private:
+  CpuFusionCostModel cost_model_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_SERVICE_CPU_CPU_MULTI_OUTPUT_FUSION_H_
@@ -0,0 +1,108 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_multi_output_fusion.h"
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/cpu/cpu_fusion_cost_model.h"
+#include "xla/tests/hlo_test_base.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla::cpu {
+namespace {
+
+using CpuMultiOutputFusionTest = HloTestBase;
+
+constexpr absl::string_view kSiblingFusions = R"(
+  HloModule m
+
+  fused_neg {
+    p = f32[$0] parameter(0)
+    ROOT neg = f32[$0] negate(p)
+  }
+
+  fused_exp {
+    p = f32[$0] parameter(0)
+    ROOT exp = f32[$0] exponential(p)
+  }
+
+  ENTRY e {
+    p0 = f32[$0] parameter(0)
+    neg = f32[$0] fusion(p0), kind=kLoop, calls=fused_neg
+    exp = f32[$0] fusion(p0), kind=kLoop, calls=fused_exp
+    ROOT tuple = (f32[$0], f32[$0]) tuple(neg, exp)
+  })";
+
+TEST_F(CpuMultiOutputFusionTest, FuseSmallSiblings) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module,
+      ParseAndReturnVerifiedModule(absl::Substitute(kSiblingFusions, 1024)));
+
+  CpuMultiOutputFusion fusion(CpuFusionCostModel({}));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, fusion.Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_EQ(root->opcode(), HloOpcode::kTuple);
+  const HloInstruction* fused = root->operand(0)->operand(0);
+  EXPECT_EQ(fused->opcode(), HloOpcode::kFusion);
+  EXPECT_TRUE(fused->shape().IsTuple());
+  EXPECT_EQ(root->operand(1)->operand(0), fused);
+}
+
+TEST_F(CpuMultiOutputFusionTest, DoNotFuseLargeSiblings) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, ParseAndReturnVerifiedModule(
+                       absl::Substitute(kSiblingFusions, 1024 * 1024)));
+
+  CpuMultiOutputFusion fusion(CpuFusionCostModel({}));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, fusion.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(CpuMultiOutputFusionTest, DoNotFuseDifferentLoopShapes) {
+  constexpr absl::string_view kHlo = R"(
+    HloModule m
+
+    fused_neg {
+      p = f32[1024] parameter(0)
+      ROOT neg = f32[1024] negate(p)
+    }
+
+    fused_broadcast {
+      p = f32[1024] parameter(0)
+      ROOT broadcast = f32[4,1024] broadcast(p), dimensions={1}
+    }
+
+    ENTRY e {
+      p0 = f32[1024] parameter(0)
+      neg = f32[1024] fusion(p0), kind=kLoop, calls=fused_neg
+      broadcast = f32[4,1024] fusion(p0), kind=kLoop, calls=fused_broadcast
+      ROOT tuple = (f32[1024], f32[4,1024]) tuple(neg, broadcast)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+
+  CpuMultiOutputFusion fusion(CpuFusionCostModel({}));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, fusion.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla::cpu
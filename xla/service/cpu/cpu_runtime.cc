@@ -20,6 +20,7 @@ limitations under the License.
 #include <cstdio>
 #include <cstring>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -27,6 +28,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
+#include "absl/base/const_init.h"
 #include "absl/base/dynamic_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
@@ -222,6 +224,47 @@ std::string ShapeString(const void* shape_ptr, int32_t shape_length) {
   return "<invalid shape>";
 }
 
+// Infeed buffer that produces its contents on demand (see
+// XfeedBuffer::WriteTo), staged in a runtime-owned buffer because compiled
+// code reads infeed data in place.
+struct StagedInfeedBuffer {
+  std::unique_ptr<char[]> data;
+  absl::Status status;
+};
+
+// Staged infeed buffers keyed by the pointer returned to compiled code.
+static absl::Mutex staged_infeed_mu(absl::kConstInit);
+static absl::flat_hash_map<void*, StagedInfeedBuffer>& StagedInfeedBuffers()
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(staged_infeed_mu) {
+  static auto* buffers = new absl::flat_hash_map<void*, StagedInfeedBuffer>();
+  return *buffers;
+}
+
+static void* StageInfeedBuffer(XfeedBuffer* buffer) {
+  StagedInfeedBuffer staged{std::make_unique<char[]>(buffer->length()),
+                            absl::OkStatus()};
+  staged.status = buffer->WriteTo(staged.data.get());
+  if (!staged.status.ok()) {
+    LOG(ERROR) << "Failed to fill infeed buffer: " << staged.status;
+  }
+
+  void* data = staged.data.get();
+  absl::MutexLock lock(&staged_infeed_mu);
+  StagedInfeedBuffers().emplace(data, std::move(staged));
+  return data;
+}
+
+// Returns the status of the staged infeed buffer `data` and releases it, or
+// std::nullopt if `data` is not a staged infeed buffer.
+static std::optional<absl::Status> ReleaseStagedInfeedBuffer(void* data) {
+  absl::MutexLock lock(&staged_infeed_mu);
+  auto it = StagedInfeedBuffers().find(data);
+  if (it == StagedInfeedBuffers().end()) return std::nullopt;
+  absl::Status status = std::move(it->second.status);
+  StagedInfeedBuffers().erase(it);
+  return status;
+}
+
 ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY
 void* AcquireInfeedBufferForDequeueImpl(const ExecutableRunOptions* run_options,
                                         int32_t buffer_length,
@@ -241,6 +284,9 @@ void* AcquireInfeedBufferForDequeueImpl(const ExecutableRunOptions* run_options,
       << " did not match the runtime's infed buffer length " << buffer->length()
       << "; program reports desired shape: "
       << ShapeString(shape, shape_length);
+  if (buffer->data() == nullptr && buffer_length != 0) {
+    return StageInfeedBuffer(buffer);
+  }
   return buffer->data();
 }
 
@@ -257,6 +303,14 @@ void ReleaseInfeedBufferAfterDequeueImpl(
   XfeedManager* xfeed = GetXfeedManager(device_ordinal);
   absl::StatusOr<Shape> shape =
       DecodeSelfDescribingShapeConstant(shape_ptr, shape_length);
+
+  // Report errors of filling the staged infeed buffer to the client.
+  if (std::optional<absl::Status> staged =
+          ReleaseStagedInfeedBuffer(buffer_ptr)) {
+    buffer_ptr = nullptr;
+    if (!staged->ok()) shape = std::move(*staged);
+  }
+
   xfeed->infeed()->ReleaseCurrentBuffer(buffer_length, buffer_ptr,
                                         std::move(shape));
 }
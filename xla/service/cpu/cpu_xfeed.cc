@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/cpu/cpu_xfeed.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -24,6 +25,7 @@ limitations under the License.
 
 #include "absl/base/casts.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -59,6 +61,48 @@ class CpuInfeedBuffer : public cpu::runtime::XfeedBuffer {
   char* buffer_;
 };
 
+// Infeed buffer that borrows user-owned host memory.
+class CpuBorrowedInfeedBuffer : public cpu::runtime::XfeedBuffer {
+ public:
+  CpuBorrowedInfeedBuffer(const void* data, int32_t length,
+                          InfeedReleaseCallback release)
+      : data_(data), length_(length), release_(std::move(release)) {}
+
+  int32_t length() override { return length_; }
+  void* data() override { return const_cast<void*>(data_); }
+  void Done(absl::StatusOr<Shape> shape) override {
+    std::move(release_)(shape.status());
+    delete this;
+  }
+
+ private:
+  const void* data_;
+  int32_t length_;
+  InfeedReleaseCallback release_;
+};
+
+// Infeed buffer that writes data with a user-supplied callback directly into
+// the destination buffer.
+class CpuFillInfeedBuffer : public cpu::runtime::XfeedBuffer {
+ public:
+  CpuFillInfeedBuffer(int32_t length, InfeedFillCallback fill,
+                      InfeedReleaseCallback release)
+      : length_(length), fill_(std::move(fill)), release_(std::move(release)) {}
+
+  int32_t length() override { return length_; }
+  void* data() override { return nullptr; }
+  absl::Status WriteTo(void* dst) override { return fill_(dst, length_); }
+  void Done(absl::StatusOr<Shape> shape) override {
+    std::move(release_)(shape.status());
+    delete this;
+  }
+
+ private:
+  int32_t length_;
+  InfeedFillCallback fill_;
+  InfeedReleaseCallback release_;
+};
+
 class CpuOutfeedBuffer : public cpu::runtime::XfeedBuffer {
  public:
   CpuOutfeedBuffer(void* destination, int32_t length)
@@ -83,10 +127,7 @@ class CpuOutfeedBuffer : public cpu::runtime::XfeedBuffer {
   tsl::Notification done_;
 };
 
-// Transfers infeed data to device. InfeedBuffer->Done() must be called to
-// clean up the memory allocated for InfeedBuffer.
-absl::StatusOr<cpu::runtime::XfeedBuffer*> TransferBufferToInfeedInternal(
-    int64_t size, const void* source) {
+absl::Status CheckInfeedSize(int64_t size) {
   if (size > std::numeric_limits<int32_t>::max()) {
     return InvalidArgument("CPU infeed of %d bytes exceeds maximum of %d bytes",
                            size, std::numeric_limits<int32_t>::max());
@@ -97,6 +138,15 @@ absl::StatusOr<cpu::runtime::XfeedBuffer*> TransferBufferToInfeedInternal(
                            size);
   }
 
+  return absl::OkStatus();
+}
+
+// Transfers infeed data to device. InfeedBuffer->Done() must be called to
+// clean up the memory allocated for InfeedBuffer.
+absl::StatusOr<cpu::runtime::XfeedBuffer*> TransferBufferToInfeedInternal(
+    int64_t size, const void* source) {
+  TF_RETURN_IF_ERROR(CheckInfeedSize(size));
+
   auto size_32 = static_cast<int32_t>(size);
   auto queued_buffer = new CpuInfeedBuffer(size_32);
   std::memcpy(queued_buffer->data(), source, size);
@@ -223,6 +273,37 @@ absl::Status TransferLiteralToInfeedOnCpu(int device_ordinal,
   return absl::OkStatus();
 }
 
+absl::Status TransferToInfeedWithCallbackOnCpu(int device_ordinal,
+                                               int64_t size,
+                                               InfeedFillCallback fill,
+                                               InfeedReleaseCallback release) {
+  TF_RETURN_IF_ERROR(CheckInfeedSize(size));
+
+  auto* buffer = new CpuFillInfeedBuffer(static_cast<int32_t>(size),
+                                         std::move(fill), std::move(release));
+
+  cpu::runtime::XfeedManager* xfeed_manager =
+      cpu::runtime::GetXfeedManager(device_ordinal);
+  xfeed_manager->infeed()->EnqueueBuffersAtomically({buffer});
+
+  return absl::OkStatus();
+}
+
+absl::Status TransferBufferToInfeedZeroCopyOnCpu(
+    int device_ordinal, const void* data, int64_t size,
+    InfeedReleaseCallback release) {
+  TF_RETURN_IF_ERROR(CheckInfeedSize(size));
+
+  auto* buffer = new CpuBorrowedInfeedBuffer(
+      data, static_cast<int32_t>(size), std::move(release));
+
+  cpu::runtime::XfeedManager* xfeed_manager =
+      cpu::runtime::GetXfeedManager(device_ordinal);
+  xfeed_manager->infeed()->EnqueueBuffersAtomically({buffer});
+
+  return absl::OkStatus();
+}
+
 absl::Status TransferLiteralFromOutfeedOnCpu(int device_ordinal,
                                              MutableBorrowingLiteral literal) {
   if (!literal.shape().IsTuple()) {
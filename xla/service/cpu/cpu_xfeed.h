@@ -16,8 +16,10 @@ limitations under the License.
 #ifndef XLA_SERVICE_CPU_CPU_XFEED_H_
 #define XLA_SERVICE_CPU_CPU_XFEED_H_
 
+#include <cstdint>
 #include <vector>
 
+#include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "xla/literal.h"
 #include "xla/service/hlo_cost_analysis.h"
@@ -33,6 +35,34 @@ namespace xla {
 absl::Status TransferLiteralToInfeedOnCpu(int device_ordinal,
                                           const LiteralSlice& literal);
 
+// Callback that writes `size` bytes of infeed data into `dst`. When infeed is
+// executed by the XLA:CPU thunk runtime, `dst` is the destination buffer of
+// the infeed operation.
+using InfeedFillCallback = absl::AnyInvocable<absl::Status(void* dst,
+                                                           int64_t size)>;
+
+// Callback that is called once the runtime no longer accesses the infeed data.
+// The status is an error if the infeed data was not consumed successfully.
+using InfeedReleaseCallback = absl::AnyInvocable<void(absl::Status status) &&>;
+
+// Transfers to infeed on CPU without an intermediate copy: the runtime calls
+// `fill` to write the infeed data directly into the destination buffer of the
+// executable, and then calls `release`. The legacy (non-thunk) runtime reads
+// infeed data in place, and calls `fill` with a runtime-owned staging buffer.
+// Errors returned by `fill` are passed to `release`.
+absl::Status TransferToInfeedWithCallbackOnCpu(int device_ordinal,
+                                               int64_t size,
+                                               InfeedFillCallback fill,
+                                               InfeedReleaseCallback release);
+
+// Transfers user-owned host memory to infeed on CPU. The runtime reads the
+// infeed data from `data` directly, and the memory must stay alive until
+// `release` is called. Infeed data is copied out with an unaligned memcpy, so
+// `data` does not need any particular alignment.
+absl::Status TransferBufferToInfeedZeroCopyOnCpu(int device_ordinal,
+                                                 const void* data, int64_t size,
+                                                 InfeedReleaseCallback release);
+
 // Helper function to transfers from outfeed on CPU.
 absl::Status TransferLiteralFromOutfeedOnCpu(int device_ordinal,
                                              MutableBorrowingLiteral literal);
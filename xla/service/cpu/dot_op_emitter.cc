@@ -174,6 +174,14 @@ DotImplementationStrategy GetNonBatchDotImplementationStrategy(
          dot_info.dim_nums.rhs_batch_dimensions_size() == 0)
       << "Dot operations must be non-batch";
 
+  // Mixed precision dots are implemented only by the Eigen runtime (see
+  // `IsMixedPrecisionEigenDot`), LLVM IR emitters require the same element
+  // type for operands and result.
+  if (dot_info.lhs_shape.element_type() != element_type ||
+      dot_info.rhs_shape.element_type() != element_type) {
+    return DotImplementationStrategy::kEigen;
+  }
+
   // Any Matrix-Vector product of floating point or integral type, or
   // a transpose-dot fusion of the same can be lowered to a tiled LLVM
   // IR implementation.
@@ -1334,6 +1342,41 @@ DotInfo InnerDotInfo(const DotInfo& batch_dot) {
   return inner_dot;
 }
 
+bool IsMixedPrecisionEigenDot(const HloInstruction& instr) {
+  auto* dot = DynCast<HloDotInstruction>(&instr);
+  if (dot == nullptr || dot->sparse_operands() > 0) {
+    return false;
+  }
+
+  // Packed nibble dots must be unpacked by the OperandUpcaster.
+  if (absl::c_count(dot->precision_config().operand_precision(),
+                    PrecisionConfig::PACKED_NIBBLE) > 0) {
+    return false;
+  }
+
+  const Shape& lhs_shape = dot->operand(0)->shape();
+  const Shape& rhs_shape = dot->operand(1)->shape();
+  PrimitiveType operand_type = lhs_shape.element_type();
+  PrimitiveType result_type = dot->shape().element_type();
+
+  bool supported_types =
+      rhs_shape.element_type() == operand_type &&
+      (((operand_type == S8 || operand_type == U8) && result_type == S32) ||
+       (operand_type == BF16 && result_type == F32));
+  if (!supported_types || ShapeUtil::IsZeroElementArray(lhs_shape) ||
+      ShapeUtil::IsZeroElementArray(rhs_shape)) {
+    return false;
+  }
+
+  // Matrix-vector dots can be fused and emitted as LLVM IR, so both operands
+  // must have non-contracting dimensions.
+  const DotDimensionNumbers& dnums = dot->dot_dimension_numbers();
+  return lhs_shape.rank() > dnums.lhs_batch_dimensions_size() +
+                                dnums.lhs_contracting_dimensions_size() &&
+         rhs_shape.rank() > dnums.rhs_batch_dimensions_size() +
+                                dnums.rhs_contracting_dimensions_size();
+}
+
 DotImplementationStrategy GetDotImplementationStrategy(
     const HloModuleConfig& config, const HloInstruction& instr,
     const TargetMachineFeatures& target_machine_features) {
@@ -89,6 +89,11 @@ bool IsBatchDot(const DotInfo& dot_info);
 // Returns `DotInfo` for the inner dot operation of the `batch_dot`.
 DotInfo InnerDotInfo(const DotInfo& batch_dot);
 
+// Returns true if `instr` is a matrix-matrix dot of s8/u8 operands into s32, or
+// of bf16 operands into f32, that the Eigen runtime can compute without
+// upcasting its operands first. Such dots always use the kEigen strategy.
+bool IsMixedPrecisionEigenDot(const HloInstruction& instr);
+
 // Returns the implementation strategy for a dot with the configuration
 // `dot_info`.
 DotImplementationStrategy GetDotImplementationStrategy(
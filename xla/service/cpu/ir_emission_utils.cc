@@ -16,10 +16,20 @@ limitations under the License.
 #include "xla/service/cpu/ir_emission_utils.h"
 
 #include <cstdint>
+#include <numeric>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/layout_util.h"
+#include "xla/primitive_util.h"
 #include "xla/service/cpu/cpu_runtime.h"
 #include "xla/shape_util.h"
 #include "xla/window_util.h"
@@ -28,6 +38,122 @@ limitations under the License.
 namespace xla {
 namespace cpu {
 
+// Returns the number of batch dimensions of `indices` if it holds scalar
+// indices: either `index_vector_dim` is implicit, or it is the trailing
+// dimension of size 1. Returns -1 otherwise.
+static int64_t GetScalarIndicesBatchRank(const Shape& indices,
+                                         int64_t index_vector_dim) {
+  int64_t rank = indices.dimensions_size();
+  if (index_vector_dim == rank) return rank;
+  if (index_vector_dim == rank - 1 && indices.dimensions(rank - 1) == 1) {
+    return rank - 1;
+  }
+  return -1;
+}
+
+// Returns true if `dims` is a [begin, end) sequence of dimensions.
+static bool IsDimsRange(absl::Span<const int64_t> dims, int64_t begin,
+                        int64_t end) {
+  std::vector<int64_t> range(end - begin);
+  std::iota(range.begin(), range.end(), begin);
+  return absl::c_equal(dims, range);
+}
+
+static bool IsSupportedRowIndicesType(PrimitiveType type) {
+  return type == S32 || type == S64;
+}
+
+bool PotentiallyImplementedAsRowGather(const HloInstruction& instr) {
+  auto* gather = DynCast<HloGatherInstruction>(&instr);
+  if (gather == nullptr) return false;
+
+  const Shape& operand = gather->operand(0)->shape();
+  const Shape& indices = gather->operand(1)->shape();
+  const Shape& shape = gather->shape();
+  const GatherDimensionNumbers& dnums = gather->gather_dimension_numbers();
+
+  if (operand.dimensions_size() == 0 ||
+      primitive_util::IsSubByteNonPredType(operand.element_type()) ||
+      !IsSupportedRowIndicesType(indices.element_type())) {
+    return false;
+  }
+
+  int64_t batch_rank =
+      GetScalarIndicesBatchRank(indices, dnums.index_vector_dim());
+  if (batch_rank < 0) return false;
+
+  // Gather must read full rows of the operand and append row dimensions to
+  // the batch dimensions of indices.
+  absl::Span<const int64_t> slice_sizes = gather->gather_slice_sizes();
+  for (int64_t i = 1; i < operand.dimensions_size(); ++i) {
+    if (slice_sizes[i] != operand.dimensions(i)) return false;
+  }
+
+  return slice_sizes[0] == 1 && dnums.operand_batching_dims().empty() &&
+         absl::c_equal(dnums.start_index_map(), std::vector<int64_t>{0}) &&
+         absl::c_equal(dnums.collapsed_slice_dims(),
+                       std::vector<int64_t>{0}) &&
+         IsDimsRange(dnums.offset_dims(), batch_rank, shape.dimensions_size());
+}
+
+bool PotentiallyImplementedAsRowScatter(const HloInstruction& instr) {
+  auto* scatter = DynCast<HloScatterInstruction>(&instr);
+  if (scatter == nullptr || scatter->scatter_operand_count() != 1) {
+    return false;
+  }
+
+  const Shape& operand = scatter->scatter_operands()[0]->shape();
+  const Shape& indices = scatter->scatter_indices()->shape();
+  const Shape& updates = scatter->scatter_updates()[0]->shape();
+  const ScatterDimensionNumbers& dnums =
+      scatter->scatter_dimension_numbers();
+
+  if (operand.dimensions_size() == 0 ||
+      primitive_util::IsSubByteNonPredType(operand.element_type()) ||
+      !IsSupportedRowIndicesType(indices.element_type())) {
+    return false;
+  }
+
+  int64_t batch_rank =
+      GetScalarIndicesBatchRank(indices, dnums.index_vector_dim());
+  if (batch_rank < 0) return false;
+
+  // Updates must have full rows of the operand appended to the batch
+  // dimensions of indices.
+  if (updates.dimensions_size() != batch_rank + operand.dimensions_size() - 1) {
+    return false;
+  }
+  for (int64_t i = 1; i < operand.dimensions_size(); ++i) {
+    if (updates.dimensions(batch_rank + i - 1) != operand.dimensions(i)) {
+      return false;
+    }
+  }
+
+  if (!dnums.input_batching_dims().empty() ||
+      !absl::c_equal(dnums.inserted_window_dims(), std::vector<int64_t>{0}) ||
+      !absl::c_equal(dnums.scatter_dims_to_operand_dims(),
+                     std::vector<int64_t>{0}) ||
+      !IsDimsRange(dnums.update_window_dims(), batch_rank,
+                   updates.dimensions_size())) {
+    return false;
+  }
+
+  // Combiner must assign the update value, or add it to the operand value.
+  const HloComputation* combiner = scatter->to_apply();
+  const HloInstruction* root = combiner->root_instruction();
+  if (root == combiner->parameter_instruction(1)) return true;
+
+  PrimitiveType type = operand.element_type();
+  bool is_supported_add_type = primitive_util::IsIntegralType(type) ||
+                               type == F16 || type == BF16 || type == F32 ||
+                               type == F64;
+
+  return is_supported_add_type && root->opcode() == HloOpcode::kAdd &&
+         root->operand(0)->opcode() == HloOpcode::kParameter &&
+         root->operand(1)->opcode() == HloOpcode::kParameter &&
+         root->operand(0) != root->operand(1);
+}
+
 int64_t GetMinimumAlignmentForArray(
     const Shape& shape, const TargetMachineFeatures& target_machine_features) {
   CHECK(LayoutUtil::IsDenseArray(shape));
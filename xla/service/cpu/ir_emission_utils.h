@@ -31,6 +31,18 @@ bool PotentiallyImplementedAsEigenConvolution(
     const HloInstruction& convolution,
     const TargetMachineFeatures& target_machine_features);
 
+// Returns true if the gather instruction gathers full rows (slices along the
+// most major dimension) of the operand using scalar indices, and can be
+// implemented as a sequence of row copies (see GatherThunk). Callers must
+// check that operand, indices and result have row-major layouts.
+bool PotentiallyImplementedAsRowGather(const HloInstruction& gather);
+
+// Returns true if the scatter instruction updates full rows (slices along the
+// most major dimension) of a single operand using scalar indices, with an
+// assignment or addition combiner (see ScatterThunk). Callers must check that
+// operand, indices and updates have row-major layouts.
+bool PotentiallyImplementedAsRowScatter(const HloInstruction& scatter);
+
 // Computes the minimum alignment guaranteed for a tensor of shape `shape` on
 // the target machine.
 int64_t GetMinimumAlignmentForArray(
@@ -53,5 +53,107 @@ ENTRY Conv {
       *conv_instr, target_machine_features));
 }
 
+TEST_F(IrEmitterTest, RowGather) {
+  const char* const hlo_string = R"(
+HloModule ModuleWithGather
+
+ENTRY Gather {
+  operand = f32[100,8,4] parameter(0)
+  indices = s32[3,5] parameter(1)
+  ROOT gather = f32[3,5,8,4] gather(operand, indices),
+    offset_dims={2,3},
+    collapsed_slice_dims={0},
+    start_index_map={0},
+    index_vector_dim=2,
+    slice_sizes={1,8,4}
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  HloInstruction* gather = module->entry_computation()->root_instruction();
+  EXPECT_TRUE(cpu::PotentiallyImplementedAsRowGather(*gather));
+}
+
+TEST_F(IrEmitterTest, PartialRowGather) {
+  const char* const hlo_string = R"(
+HloModule ModuleWithGather
+
+ENTRY Gather {
+  operand = f32[100,8] parameter(0)
+  indices = s32[5] parameter(1)
+  ROOT gather = f32[5,4] gather(operand, indices),
+    offset_dims={1},
+    collapsed_slice_dims={0},
+    start_index_map={0},
+    index_vector_dim=1,
+    slice_sizes={1,4}
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  HloInstruction* gather = module->entry_computation()->root_instruction();
+  EXPECT_FALSE(cpu::PotentiallyImplementedAsRowGather(*gather));
+}
+
+TEST_F(IrEmitterTest, RowScatter) {
+  const char* const hlo_string = R"(
+HloModule ModuleWithScatter
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY Scatter {
+  operand = f32[100,8] parameter(0)
+  indices = s64[5,1] parameter(1)
+  updates = f32[5,8] parameter(2)
+  ROOT scatter = f32[100,8] scatter(operand, indices, updates),
+    to_apply=add,
+    update_window_dims={1},
+    inserted_window_dims={0},
+    scatter_dims_to_operand_dims={0},
+    index_vector_dim=1
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  HloInstruction* scatter = module->entry_computation()->root_instruction();
+  EXPECT_TRUE(cpu::PotentiallyImplementedAsRowScatter(*scatter));
+}
+
+TEST_F(IrEmitterTest, RowScatterWithUnsupportedCombiner) {
+  const char* const hlo_string = R"(
+HloModule ModuleWithScatter
+
+mul {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT mul = f32[] multiply(lhs, rhs)
+}
+
+ENTRY Scatter {
+  operand = f32[100,8] parameter(0)
+  indices = s32[5] parameter(1)
+  updates = f32[5,8] parameter(2)
+  ROOT scatter = f32[100,8] scatter(operand, indices, updates),
+    to_apply=mul,
+    update_window_dims={1},
+    inserted_window_dims={0},
+    scatter_dims_to_operand_dims={0},
+    index_vector_dim=1
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  HloInstruction* scatter = module->entry_computation()->root_instruction();
+  EXPECT_FALSE(cpu::PotentiallyImplementedAsRowScatter(*scatter));
+}
+
 }  // namespace
 }  // namespace xla
@@ -61,6 +61,14 @@ class TargetMachineFeaturesStub : public TargetMachineFeatures {
     LOG(FATAL) << "Unexpected call to " << __func__;
   }
 
+  int64_t l1_cache_size_in_bytes() const final {
+    LOG(FATAL) << "Unexpected call to " << __func__;
+  }
+
+  int64_t l2_cache_size_in_bytes() const final {
+    LOG(FATAL) << "Unexpected call to " << __func__;
+  }
+
  private:
   std::function<int64_t(int64_t)> min_alignment_;
 };
@@ -14,11 +14,16 @@ limitations under the License.
 ==============================================================================*/
 
 #include <cstdint>
+#include <cstring>
+#include <utility>
 
+#include "absl/status/status.h"
+#include "xla/backends/cpu/alignment.h"
 #include "xla/error_spec.h"
 #include "xla/layout.h"
 #include "xla/layout_util.h"
 #include "xla/literal_util.h"
+#include "xla/service/cpu/cpu_xfeed.h"
 #include "xla/service/service.h"
 #include "xla/shape.h"
 #ifndef _WIN32
@@ -37,6 +42,7 @@ limitations under the License.
 #include "xla/tests/client_library_test_base.h"
 #include "xla/tests/literal_test_util.h"
 #include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/xla_data.pb.h"
 
@@ -295,5 +301,126 @@ TEST_F(InfeedTest, DISABLED_TwoInfeedsInTotalOrder) {
   LiteralTestUtil::ExpectR0Near<float>(66.0f, result_literal, ErrorSpec{1e-7});
 }
 
+// Infeed release callback that counts how many times it was called and records
+// the released status.
+struct ReleaseCounter {
+  InfeedReleaseCallback Callback() {
+    return [this](absl::Status status) {
+      ++num_released;
+      released_status = std::move(status);
+    };
+  }
+
+  int num_released = 0;
+  absl::Status released_status = absl::UnknownError("not released");
+};
+
+class ZeroCopyInfeedTest : public InfeedTest,
+                           public ::testing::WithParamInterface<bool> {
+ protected:
+  ZeroCopyInfeedTest() {
+    mutable_debug_options()->set_xla_cpu_use_thunk_runtime(GetParam());
+  }
+
+  // Runs a computation that infeeds a value of `literal`'s shape and returns
+  // it, and checks the result against `literal`.
+  void RunInfeed(const Literal& literal) {
+    XlaBuilder builder(TestName());
+    Infeed(&builder, literal.shape());
+    TF_ASSERT_OK_AND_ASSIGN(Literal result, ExecuteAndTransfer(&builder, {}));
+    EXPECT_TRUE(LiteralTestUtil::Equal(literal, result));
+  }
+};
+
+TEST_P(ZeroCopyInfeedTest, FillCallback) {
+  Literal literal = LiteralUtil::CreateR2F32Linspace(0.0, 1.0, 128, 64);
+  int64_t size = literal.size_bytes();
+
+  int num_filled = 0;
+  ReleaseCounter release;
+  ASSERT_IS_OK(TransferToInfeedWithCallbackOnCpu(
+      /*device_ordinal=*/0, size,
+      [&](void* dst, int64_t dst_size) {
+        ++num_filled;
+        EXPECT_EQ(dst_size, size);
+        std::memcpy(dst, literal.untyped_data(), dst_size);
+        return absl::OkStatus();
+      },
+      release.Callback()));
+  EXPECT_EQ(release.num_released, 0);
+
+  RunInfeed(literal);
+  EXPECT_EQ(num_filled, 1);
+  EXPECT_EQ(release.num_released, 1);
+  EXPECT_IS_OK(release.released_status);
+}
+
+TEST_P(ZeroCopyInfeedTest, FillCallbackErrorIsReleased) {
+  Literal literal = LiteralUtil::CreateR1<float>({1, 2, 3, 4});
+
+  ReleaseCounter release;
+  ASSERT_IS_OK(TransferToInfeedWithCallbackOnCpu(
+      /*device_ordinal=*/0, literal.size_bytes(),
+      [](void* dst, int64_t size) {
+        std::memset(dst, 0, size);
+        return absl::InternalError("fill failed");
+      },
+      release.Callback()));
+
+  XlaBuilder builder(TestName());
+  Infeed(&builder, literal.shape());
+  ExecuteAndTransfer(&builder, {}).IgnoreError();
+
+  EXPECT_EQ(release.num_released, 1);
+  EXPECT_EQ(release.released_status, absl::InternalError("fill failed"));
+}
+
+TEST_P(ZeroCopyInfeedTest, AlignedBuffer) {
+  Literal literal = LiteralUtil::CreateR1<float>({1, 2, 3, 4, 5, 6, 7, 8});
+  int64_t size = literal.size_bytes();
+
+  alignas(cpu::MinAlign()) char data[8 * sizeof(float)];
+  std::memcpy(data, literal.untyped_data(), size);
+
+  ReleaseCounter release;
+  ASSERT_IS_OK(TransferBufferToInfeedZeroCopyOnCpu(
+      /*device_ordinal=*/0, data, size, release.Callback()));
+
+  // Buffer is borrowed by the runtime until the infeed is executed.
+  EXPECT_EQ(release.num_released, 0);
+
+  RunInfeed(literal);
+  EXPECT_EQ(release.num_released, 1);
+  EXPECT_IS_OK(release.released_status);
+}
+
+TEST_P(ZeroCopyInfeedTest, MisalignedBuffer) {
+  Literal literal = LiteralUtil::CreateR1<float>({1, 2, 3, 4, 5, 6, 7, 8});
+  int64_t size = literal.size_bytes();
+
+  alignas(cpu::MinAlign()) char storage[8 * sizeof(float) + 1];
+  char* data = storage + 1;
+  std::memcpy(data, literal.untyped_data(), size);
+
+  ReleaseCounter release;
+  ASSERT_IS_OK(TransferBufferToInfeedZeroCopyOnCpu(
+      /*device_ordinal=*/0, data, size, release.Callback()));
+
+  // Infeed data is copied out with an unaligned memcpy, so misaligned buffers
+  // are borrowed as well.
+  EXPECT_EQ(release.num_released, 0);
+
+  RunInfeed(literal);
+  EXPECT_EQ(release.num_released, 1);
+  EXPECT_IS_OK(release.released_status);
+}
+
+INSTANTIATE_TEST_SUITE_P(ZeroCopyInfeedTestInstantiation, ZeroCopyInfeedTest,
+                         ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "ThunkRuntime"
+                                             : "LegacyRuntime";
+                         });
+
 }  // namespace
 }  // namespace xla
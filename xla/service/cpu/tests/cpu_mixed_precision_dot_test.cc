@@ -0,0 +1,144 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Tests that mixed precision dots reach DotThunk without upcasted operands.
+
+#include <memory>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/error_spec.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/service/cpu/cpu_executable.h"
+#include "xla/service/executable.h"
+#include "xla/service/hlo_runner_interface.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/xla.pb.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/casts.h"
+
+namespace xla::cpu {
+namespace {
+
+using ::testing::Contains;
+using ::testing::Pointee;
+using ::testing::Property;
+
+class CpuMixedPrecisionDotTest : public HloTestBase {
+ protected:
+  // Compiles `hlo` and checks that its dot is executed by a DotThunk with
+  // operands of `operand_type`.
+  void ExpectDotThunkWithOperands(absl::string_view hlo,
+                                  PrimitiveType operand_type) {
+    TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                            ParseAndReturnVerifiedModule(hlo));
+    TF_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<OpaqueExecutable> wrapped,
+        CreateExecutable(std::move(module), /*run_hlo_passes=*/true));
+    TF_ASSERT_OK_AND_ASSIGN(
+        Executable * executable,
+        test_runner_as_hlo_runner().ExecutableFromWrapped(wrapped.get()));
+    auto* cpu_executable = tsl::down_cast<CpuExecutable*>(executable);
+
+    const HloInstruction* dot = hlo_query::FindInstruction(
+        cpu_executable->module().entry_computation(), HloOpcode::kDot);
+    ASSERT_NE(dot, nullptr);
+    EXPECT_EQ(dot->operand(0)->shape().element_type(), operand_type);
+    EXPECT_EQ(dot->operand(1)->shape().element_type(), operand_type);
+
+    ASSERT_TRUE(cpu_executable->has_thunks());
+    EXPECT_THAT(cpu_executable->thunks().thunk_sequence(),
+                Contains(Pointee(Property(&Thunk::kind, Thunk::Kind::kDot))));
+  }
+
+ private:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options = HloTestBase::GetDebugOptionsForTest();
+    debug_options.set_xla_cpu_use_thunk_runtime(true);
+    debug_options.set_xla_cpu_use_xnnpack(false);
+    return debug_options;
+  }
+};
+
+TEST_F(CpuMixedPrecisionDotTest, S8DotAccumulatesInS32) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule s8_dot
+
+    ENTRY e {
+      p0 = s8[64,32] parameter(0)
+      p1 = s8[32,48] parameter(1)
+      ROOT dot = s32[64,48] dot(p0, p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    })";
+
+  ExpectDotThunkWithOperands(kModuleStr, S8);
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0.0}));
+}
+
+TEST_F(CpuMixedPrecisionDotTest, U8BatchDotAccumulatesInS32) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule u8_batch_dot
+
+    ENTRY e {
+      p0 = u8[4,64,32] parameter(0)
+      p1 = u8[4,48,32] parameter(1)
+      ROOT dot = s32[4,64,48] dot(p0, p1),
+        lhs_batch_dims={0}, rhs_batch_dims={0},
+        lhs_contracting_dims={2}, rhs_contracting_dims={2}
+    })";
+
+  ExpectDotThunkWithOperands(kModuleStr, U8);
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0.0}));
+}
+
+TEST_F(CpuMixedPrecisionDotTest, Bf16DotAccumulatesInF32) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_dot
+
+    ENTRY e {
+      p0 = bf16[64,32] parameter(0)
+      p1 = bf16[32,48] parameter(1)
+      ROOT dot = f32[64,48] dot(p0, p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    })";
+
+  ExpectDotThunkWithOperands(kModuleStr, BF16);
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-4, 1e-4}));
+}
+
+TEST_F(CpuMixedPrecisionDotTest, MatrixVectorDotIsUpcasted) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule s8_matrix_vector_dot
+
+    ENTRY e {
+      p0 = s8[64,32] parameter(0)
+      p1 = s8[32] parameter(1)
+      ROOT dot = s32[64] dot(p0, p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0.0}));
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,151 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Compares the vectorized reduction kernels against the reference backend.
+// Shapes are chosen to cover full and partial accumulator tiles, vector and
+// scalar tails, and reductions split across threads.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+struct ReductionTestCase {
+  std::string input_shape;
+  std::string output_shape;
+  std::string dimensions;
+  // Optional backend config that splits the reduction across threads.
+  std::string backend_config;
+};
+
+class CpuReductionTest : public HloTestBase {
+ public:
+  // Runs `reduce(input, init)` with the given reducer computation and compares
+  // the result with the reference backend.
+  void RunReductions(absl::string_view type, absl::string_view reducer,
+                     absl::string_view init,
+                     const std::vector<ReductionTestCase>& test_cases,
+                     const ErrorSpec& error_spec) {
+    constexpr absl::string_view kHlo = R"(
+      HloModule reduction
+
+      reducer {
+        p0 = $type[] parameter(0)
+        p1 = $type[] parameter(1)
+        ROOT result = $type[] $reducer(p0, p1)
+      }
+
+      ENTRY main {
+        input = $type$input_shape parameter(0)
+        init = $type[] constant($init)
+        ROOT reduce = $type$output_shape reduce(input, init),
+          dimensions={$dimensions}, to_apply=reducer$backend_config
+      })";
+
+    for (const ReductionTestCase& test_case : test_cases) {
+      std::string backend_config;
+      if (!test_case.backend_config.empty()) {
+        backend_config = ", backend_config=" + test_case.backend_config;
+      }
+      std::string hlo = absl::StrReplaceAll(
+          kHlo, {{"$type", type},
+                 {"$reducer", reducer},
+                 {"$init", init},
+                 {"$input_shape", test_case.input_shape},
+                 {"$output_shape", test_case.output_shape},
+                 {"$dimensions", test_case.dimensions},
+                 {"$backend_config", backend_config}});
+      SCOPED_TRACE(hlo);
+      EXPECT_TRUE(RunAndCompare(hlo, error_spec));
+    }
+  }
+};
+
+TEST_F(CpuReductionTest, RowReduction) {
+  RunReductions("f32", "add", "0",
+                {
+                    // Fewer elements than a single vector.
+                    {"[7,5]", "[7]", "1"},
+                    // Full accumulator tiles only.
+                    {"[4,256]", "[4]", "1"},
+                    // Vector and scalar tails after the accumulator tiles.
+                    {"[4,100]", "[4]", "1"},
+                    {"[3,1031]", "[3]", "1"},
+                    // Reduction of the two minor dimensions of a 3D array.
+                    {"[2,33,67]", "[2]", "1,2"},
+                    // Full reduction.
+                    {"[1037]", "[]", "0"},
+                },
+                ErrorSpec{1e-4, 1e-4});
+}
+
+TEST_F(CpuReductionTest, ColumnReduction) {
+  RunReductions("f32", "maximum", "-inf",
+                {
+                    // Fewer columns than a single vector.
+                    {"[17,3]", "[3]", "0"},
+                    // A full tile of columns and a partial vector tile.
+                    {"[100,40]", "[40]", "0"},
+                    // Partial tile with a vector and a scalar tail.
+                    {"[33,43]", "[43]", "0"},
+                    // Outer, reduced and inner dimensions.
+                    {"[5,37,19]", "[5,19]", "1"},
+                },
+                ErrorSpec{0.0});
+}
+
+TEST_F(CpuReductionTest, IntegerReduction) {
+  RunReductions("s32", "add", "0",
+                {
+                    {"[9,301]", "[9]", "1"},
+                    {"[301,9]", "[9]", "0"},
+                },
+                ErrorSpec{0.0});
+}
+
+TEST_F(CpuReductionTest, ParallelReduction) {
+  RunReductions(
+      "s32", "add", "0",
+      {
+          // Rows split unevenly across threads.
+          {"[66,256]", "[66]", "1",
+           R"({"outer_dimension_partitions":["4"]})"},
+          // Column tiles split across threads, with a partial last tile.
+          {"[64,300]", "[300]", "0",
+           R"({"outer_dimension_partitions":["4"]})"},
+          {"[3,64,45]", "[3,45]", "1",
+           R"({"outer_dimension_partitions":["3"]})"},
+      },
+      ErrorSpec{0.0});
+
+  // Large enough for the parallel task assigner to split the reductions.
+  RunReductions("f32", "add", "0",
+                {
+                    {"[1024,1031]", "[1024]", "1"},
+                    {"[1031,1024]", "[1024]", "0"},
+                },
+                ErrorSpec{1e-3, 1e-3});
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,143 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Tests accuracy of the vectorized sine and cosine approximations against the
+// libm reference computed in double precision.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/base/casts.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+// Max error of the approximation for inputs in the fast path range is below
+// 2.5 ULP (measured exhaustively), we leave some headroom for FMA contraction.
+constexpr double kMaxUlpError = 3.0;
+
+// Inputs with larger magnitude are computed by scalar libm calls.
+constexpr float kFastPathLimit = 8192.0f;
+
+// Returns the distance between `value` and the next float away from zero.
+double Ulp(float value) {
+  float abs = std::abs(value);
+  return std::nextafter(abs, std::numeric_limits<float>::infinity()) - abs;
+}
+
+// Returns a sweep of F32 values in (-limit, limit), spaced evenly in the
+// binary representation, so that every binade is covered, followed by values
+// that take the slow path.
+std::vector<float> SinCosInputs(float limit) {
+  std::vector<float> inputs;
+  uint32_t limit_bits = absl::bit_cast<uint32_t>(limit);
+  for (uint32_t bits = 0; bits < limit_bits; bits += 1021) {
+    float value = absl::bit_cast<float>(bits);
+    inputs.push_back(value);
+    inputs.push_back(-value);
+  }
+
+  constexpr float kInf = std::numeric_limits<float>::infinity();
+  for (float value : {limit, 1.0e5f, 1.0e30f, kInf, -kInf}) {
+    inputs.push_back(value);
+  }
+  return inputs;
+}
+
+class CpuSinCosAccuracyTest : public HloTestBase,
+                              public ::testing::WithParamInterface<HloOpcode> {
+};
+
+TEST_P(CpuSinCosAccuracyTest, MatchesReference) {
+  HloOpcode opcode = GetParam();
+  std::vector<float> inputs = SinCosInputs(kFastPathLimit);
+  inputs.push_back(std::numeric_limits<float>::quiet_NaN());
+
+  constexpr absl::string_view kHlo = R"(
+    HloModule sin_cos
+
+    ENTRY e {
+      input = f32[$n] parameter(0)
+      ROOT output = f32[$n] $op(input)
+    }
+  )";
+
+  std::string hlo = absl::StrReplaceAll(
+      kHlo, {{"$n", absl::StrCat(inputs.size())},
+             {"$op", HloOpcodeString(opcode)}});
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo));
+  Literal input = LiteralUtil::CreateR1<float>(inputs);
+  Literal output = ExecuteAndTransfer(std::move(module), {&input});
+
+  auto reference = [&](float x) -> double {
+    return opcode == HloOpcode::kSin ? std::sin(static_cast<double>(x))
+                                     : std::cos(static_cast<double>(x));
+  };
+
+  absl::Span<const float> actual = output.data<float>();
+  ASSERT_EQ(actual.size(), inputs.size());
+
+  double max_ulp_error = 0.0;
+  float max_ulp_error_input = 0.0f;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    float x = inputs[i];
+    if (std::isnan(x) || std::isinf(x)) {
+      EXPECT_TRUE(std::isnan(actual[i])) << "x=" << x;
+      continue;
+    }
+
+    double expected = reference(x);
+    double ulp_error =
+        std::abs(actual[i] - expected) / Ulp(static_cast<float>(expected));
+    if (ulp_error > max_ulp_error) {
+      max_ulp_error = ulp_error;
+      max_ulp_error_input = x;
+    }
+  }
+
+  EXPECT_LE(max_ulp_error, kMaxUlpError) << "x=" << max_ulp_error_input;
+}
+
+INSTANTIATE_TEST_SUITE_P(CpuSinCosAccuracyTestInstantiation,
+                         CpuSinCosAccuracyTest,
+                         ::testing::Values(HloOpcode::kSin, HloOpcode::kCos),
+                         [](const ::testing::TestParamInfo<HloOpcode>& info) {
+                           return info.param == HloOpcode::kSin ? "Sin"
+                                                                : "Cos";
+                         });
+
+}  // namespace
+}  // namespace xla::cpu
@@ -99,6 +99,80 @@ TEST_F(XnnFusionTest, DotRhsTransposedAndMultiply) {
   EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-7}));
 }
 
+TEST_F(XnnFusionTest, DotBiasConstantMaximum) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule dot_bias_constant_maximum
+
+    xnn_fusion {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      %bias = f32[6] parameter(2)
+      %dot = f32[4,6] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %bias_broadcast = f32[4,6] broadcast(%bias), dimensions={1}
+      %add = f32[4,6] add(%dot, %bias_broadcast)
+      %scale = f32[6] constant({0.5, -1, 2, 1, -0.5, 3})
+      %scale_broadcast = f32[4,6] broadcast(%scale), dimensions={1}
+      %mul = f32[4,6] multiply(%add, %scale_broadcast)
+      %zero = f32[] constant(0)
+      %zeros = f32[4,6] broadcast(%zero), dimensions={}
+      ROOT %max = f32[4,6] maximum(%mul, %zeros)
+    }
+
+    ENTRY entry {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      %bias = f32[6] parameter(2)
+      ROOT %fusion = f32[4,6] fusion(%lhs, %rhs, %bias),
+        kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-6}));
+}
+
+TEST_F(XnnFusionTest, DotConstantOperand) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule dot_constant_operand
+
+    xnn_fusion {
+      %lhs = f32[4,2] parameter(0)
+      %rhs = f32[2,3] constant({{1, 2, 3}, {4, 5, 6}})
+      ROOT %dot = f32[4,3] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    }
+
+    ENTRY entry {
+      %lhs = f32[4,2] parameter(0)
+      ROOT %fusion = f32[4,3] fusion(%lhs), kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-6}));
+}
+
+TEST_F(XnnFusionTest, UnsupportedConstantLayout) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule unsupported_constant_layout
+
+    xnn_fusion {
+      %x = f32[2,3] parameter(0)
+      %c = f32[2,3]{0,1} constant({{1, 2, 3}, {4, 5, 6}})
+      ROOT %add = f32[2,3] add(%x, %c)
+    }
+
+    ENTRY entry {
+      %x = f32[2,3] parameter(0)
+      ROOT %fusion = f32[2,3] fusion(%x), kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  auto status = RunAndCompare(kModuleStr, ErrorSpec{0.0});
+  EXPECT_FALSE(status);
+  EXPECT_THAT(status.message(),
+              HasSubstr("Unsupported XNNPACK constant layout"));
+}
+
 TEST_F(XnnFusionTest, UnsupportedDot) {
   constexpr absl::string_view kModuleStr = R"(
     HloModule unsupported_dot
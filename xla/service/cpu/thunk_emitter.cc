@@ -34,6 +34,7 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/dot/dot_kernel_emitter.h"
 #include "xla/backends/cpu/codegen/elemental/concatenate_kernel_emitter.h"
 #include "xla/backends/cpu/codegen/elemental/elemental_kernel_emitter.h"
+#include "xla/backends/cpu/codegen/elemental/reduction_kernel_emitter.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/runtime/all_gather_thunk.h"
 #include "xla/backends/cpu/runtime/all_reduce_thunk.h"
@@ -47,6 +48,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -54,6 +56,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
+#include "xla/backends/cpu/runtime/scatter_thunk.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/topk_thunk.h"
@@ -75,6 +78,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/layout_util.h"
+#include "xla/primitive_util.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/collective_ops_utils.h"
 #include "xla/service/cpu/backend_config.pb.h"
@@ -234,7 +238,6 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kExp:
     case HloOpcode::kExpm1:
     case HloOpcode::kFloor:
-    case HloOpcode::kGather:
     case HloOpcode::kImag:
     case HloOpcode::kIota:
     case HloOpcode::kIsFinite:
@@ -265,7 +268,6 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kSin:
     case HloOpcode::kSqrt:
     case HloOpcode::kSubtract:
-    case HloOpcode::kTranspose:
     case HloOpcode::kTan:
     case HloOpcode::kTanh:
     case HloOpcode::kXor:
@@ -355,6 +357,15 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kCopy:
       return EmitCopyThunk(instruction);
 
+    case HloOpcode::kTranspose:
+      return EmitTransposeThunk(instruction);
+
+    case HloOpcode::kGather:
+      return EmitGatherThunk(instruction);
+
+    case HloOpcode::kScatter:
+      return EmitScatterThunk(instruction);
+
     case HloOpcode::kDot:
       return EmitDotThunk(instruction);
 
@@ -655,6 +666,112 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitCopyThunk(
                                       instruction->shape());
 }
 
+absl::StatusOr<ThunkSequence> ThunkEmitter::EmitTransposeThunk(
+    const HloInstruction* instruction) {
+  const HloInstruction* source = instruction->operand(0);
+  const Shape& src_shape = source->shape();
+  const Shape& dst_shape = instruction->shape();
+
+  // Copy thunk transposes data with a TransposePlan, that supports only dense
+  // arrays of byte-sized elements.
+  auto is_supported_shape = [](const Shape& shape) {
+    return LayoutUtil::IsDenseArray(shape) && shape.layout().tiles().empty() &&
+           primitive_util::BitWidth(shape.element_type()) % 8 == 0;
+  };
+
+  if (!is_supported_shape(src_shape) || !is_supported_shape(dst_shape)) {
+    return EmitElementalKernelThunk(instruction);
+  }
+
+  // Output dimension `i` is the source dimension `dimensions()[i]`, and we
+  // can express the transpose as a copy into a buffer that has source
+  // dimensions and a permuted layout.
+  absl::Span<const int64_t> permutation = instruction->dimensions();
+  std::vector<int64_t> minor_to_major;
+  minor_to_major.reserve(permutation.size());
+  for (int64_t dim : dst_shape.layout().minor_to_major()) {
+    minor_to_major.push_back(permutation[dim]);
+  }
+
+  Shape copy_dst_shape = ShapeUtil::MakeShapeWithDenseLayout(
+      src_shape.element_type(), src_shape.dimensions(), minor_to_major);
+
+  TF_ASSIGN_OR_RETURN(auto source_buffer, GetAllocationSlice(source));
+  TF_ASSIGN_OR_RETURN(auto destination_buffer, GetAllocationSlice(instruction));
+  return ThunkSequence::Of<CopyThunk>(ThunkInfo(instruction), source_buffer,
+                                      src_shape, destination_buffer,
+                                      copy_dst_shape);
+}
+
+// Returns true if all shapes have row-major layouts.
+static bool HasRowMajorLayouts(absl::Span<const Shape* const> shapes) {
+  return absl::c_all_of(shapes, [](const Shape* shape) {
+    return LayoutUtil::IsDenseArray(*shape) &&
+           LayoutUtil::IsMonotonicWithDim0Major(shape->layout());
+  });
+}
+
+absl::StatusOr<ThunkSequence> ThunkEmitter::EmitGatherThunk(
+    const HloInstruction* instruction) {
+  const HloInstruction* operand = instruction->operand(0);
+  const HloInstruction* indices = instruction->operand(1);
+
+  // Gather of full rows is a sequence of memcpy operations, all other gathers
+  // go through the elemental kernel.
+  if (!PotentiallyImplementedAsRowGather(*instruction) ||
+      !HasRowMajorLayouts(
+          {&operand->shape(), &indices->shape(), &instruction->shape()})) {
+    return EmitElementalKernelThunk(instruction);
+  }
+
+  TF_ASSIGN_OR_RETURN(auto operand_buffer, GetAllocationSlice(operand));
+  TF_ASSIGN_OR_RETURN(auto indices_buffer, GetAllocationSlice(indices));
+  TF_ASSIGN_OR_RETURN(auto output_buffer, GetAllocationSlice(instruction));
+
+  return ThunkSequence::Of<GatherThunk>(
+      ThunkInfo(instruction), operand_buffer, operand->shape(), indices_buffer,
+      indices->shape(), output_buffer, instruction->shape());
+}
+
+absl::StatusOr<ThunkSequence> ThunkEmitter::EmitScatterThunk(
+    const HloInstruction* instruction) {
+  auto* scatter = Cast<HloScatterInstruction>(instruction);
+
+  // All other scatters must be expanded into loops by the ScatterExpander,
+  // and scatter operands must have row-major layouts assigned by the
+  // CpuLayoutAssignment.
+  if (!PotentiallyImplementedAsRowScatter(*scatter)) {
+    return Unimplemented("Scatter is not supported by XLA:CPU ThunkEmitter: %s",
+                         scatter->ToString());
+  }
+
+  const HloInstruction* operand = scatter->scatter_operands()[0];
+  const HloInstruction* indices = scatter->scatter_indices();
+  const HloInstruction* updates = scatter->scatter_updates()[0];
+
+  if (!HasRowMajorLayouts({&operand->shape(), &indices->shape(),
+                           &updates->shape(), &scatter->shape()})) {
+    return Internal("Scatter operands must have row-major layouts: %s",
+                    scatter->ToString());
+  }
+
+  const HloInstruction* root = scatter->to_apply()->root_instruction();
+  ScatterThunk::Combiner combiner = root->opcode() == HloOpcode::kAdd
+                                        ? ScatterThunk::Combiner::kAdd
+                                        : ScatterThunk::Combiner::kAssign;
+
+  TF_ASSIGN_OR_RETURN(auto operand_buffer, GetAllocationSlice(operand));
+  TF_ASSIGN_OR_RETURN(auto indices_buffer, GetAllocationSlice(indices));
+  TF_ASSIGN_OR_RETURN(auto updates_buffer, GetAllocationSlice(updates));
+  TF_ASSIGN_OR_RETURN(auto output_buffer, GetAllocationSlice(scatter));
+
+  return ThunkSequence::Of<ScatterThunk>(
+      ThunkInfo(instruction), operand_buffer, operand->shape(), indices_buffer,
+      indices->shape(), updates_buffer, updates->shape(), output_buffer,
+      scatter->shape(), combiner, scatter->indices_are_sorted(),
+      scatter->unique_indices());
+}
+
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitElementalKernelThunk(
     const HloInstruction* instruction) {
   ElementalKernelEmitter emitter(instruction, &buffer_assignment_,
@@ -698,8 +815,21 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitFusionKernelThunk(
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitReductionKernelThunk(
     const HloInstruction* instruction) {
-  // TODO(ezhulenev): Port vectorized reduction emitter from IrEmitter.
-  return EmitElementalKernelThunk(instruction);
+  ReductionKernelEmitter emitter(instruction, &buffer_assignment_,
+                                 &target_machine_features_);
+  TF_ASSIGN_OR_RETURN(KernelDefinition kernel_definition,
+                      emitter.EmitKernelDefinition());
+
+  auto [kernel_spec, kernel_source] = std::move(kernel_definition).release();
+  auto& llvm_ir_kernel_source =
+      tsl::down_cast<LlvmIrKernelSource&>(*kernel_source);
+
+  kernels_.push_back({kernel_spec.name(),
+                      std::move(llvm_ir_kernel_source).thread_safe_module()});
+
+  return MakeKernelThunkSequence(
+      instruction, std::move(kernel_spec),
+      /*min_alignment=*/cpu_function_runtime::MinAlign());
 }
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitRngThunk(
@@ -830,10 +960,15 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitDotThunk(
   const HloInstruction* lhs = instruction->operand(0);
   const HloInstruction* rhs = instruction->operand(1);
 
-  TF_RETURN_IF_ERROR(ElementTypesSameAndSupported(
-      *instruction, /*operands=*/{lhs, rhs},
-      /*supported_types=*/
-      {PRED, S8, U8, S16, U16, S32, U32, S64, U64, F16, F32, F64, C64, C128}));
+  // Mixed precision dots are kept by the compiler only if they are supported
+  // by DotThunk (see `IsMixedPrecisionEigenDot`).
+  if (!IsMixedPrecisionEigenDot(*instruction)) {
+    TF_RETURN_IF_ERROR(ElementTypesSameAndSupported(
+        *instruction, /*operands=*/{lhs, rhs},
+        /*supported_types=*/
+        {PRED, S8, U8, S16, U16, S32, U32, S64, U64, F16, F32, F64, C64,
+         C128}));
+  }
 
   const DotDimensionNumbers& dnums = instruction->dot_dimension_numbers();
   if (dnums.lhs_contracting_dimensions_size() != 1) {
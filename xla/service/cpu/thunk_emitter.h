@@ -117,6 +117,15 @@ class ThunkEmitter {
   absl::StatusOr<ThunkSequence> EmitCopyThunk(
       const HloInstruction* instruction);
 
+  absl::StatusOr<ThunkSequence> EmitTransposeThunk(
+      const HloInstruction* instruction);
+
+  absl::StatusOr<ThunkSequence> EmitGatherThunk(
+      const HloInstruction* instruction);
+
+  absl::StatusOr<ThunkSequence> EmitScatterThunk(
+      const HloInstruction* instruction);
+
   absl::StatusOr<ThunkSequence> EmitElementalKernelThunk(
       const HloInstruction* instruction);
 
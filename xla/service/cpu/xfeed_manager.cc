@@ -15,10 +15,15 @@ limitations under the License.
 
 #include "xla/service/cpu/xfeed_manager.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <string>
 #include <utility>
 
-#include "absl/base/thread_annotations.h"
+#include "absl/numeric/bits.h"
+#include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/shape.h"
@@ -29,27 +34,184 @@ namespace xla {
 namespace cpu {
 namespace runtime {
 
+absl::Status XfeedBuffer::WriteTo(void* dst) {
+  if (length() > 0) std::memcpy(dst, data(), length());
+  return absl::OkStatus();
+}
+
+XfeedQueueManager::XfeedQueueManager(std::string queue_name)
+    : XfeedQueueManager(std::move(queue_name), XfeedQueueOptions()) {}
+
+XfeedQueueManager::XfeedQueueManager(std::string queue_name,
+                                     XfeedQueueOptions options)
+    : queue_name_(std::move(queue_name)),
+      options_(options),
+      mask_(options.capacity - 1),
+      cells_(new Cell[options.capacity]),
+      enqueue_pos_(0),
+      dequeue_pos_(0),
+      num_overflow_buffers_(0),
+      num_waiting_consumers_(0),
+      current_buffer_(nullptr) {
+  CHECK(absl::has_single_bit(options_.capacity))
+      << "Xfeed queue capacity must be a power of two: " << options_.capacity;
+  for (size_t i = 0; i < options_.capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+    cells_[i].buffer = nullptr;
+  }
+}
+
+bool XfeedQueueManager::TryEnqueueToRing(
+    absl::Span<XfeedBuffer* const> buffers) {
+  size_t num_buffers = buffers.size();
+  if (num_buffers > options_.capacity) return false;
+
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    // Check that all cells in the [pos, pos + num_buffers) range are free.
+    bool stale_pos = false;
+    for (size_t i = 0; i < num_buffers; ++i) {
+      Cell& cell = cells_[(pos + i) & mask_];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - (pos + i));
+      if (diff < 0) return false;  // the ring buffer is full
+      if (diff > 0) {
+        stale_pos = true;  // another producer claimed the cell
+        break;
+      }
+    }
+
+    if (stale_pos) {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+      continue;
+    }
+
+    // Claim all cells with a single CAS, so that buffers from concurrent
+    // producers are never interleaved.
+    if (enqueue_pos_.compare_exchange_weak(pos, pos + num_buffers,
+                                           std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < num_buffers; ++i) {
+    Cell& cell = cells_[(pos + i) & mask_];
+    cell.buffer = buffers[i];
+    cell.sequence.store(pos + i + 1, std::memory_order_release);
+  }
+  return true;
+}
+
+XfeedBuffer* XfeedQueueManager::TryDequeueFromRing() {
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = cells_[pos & mask_];
+    size_t seq = cell.sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+    if (diff < 0) return nullptr;  // the ring buffer is empty
+
+    if (diff > 0) {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+      continue;
+    }
+
+    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+      XfeedBuffer* buffer = cell.buffer;
+      cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+      return buffer;
+    }
+  }
+}
+
+XfeedBuffer* XfeedQueueManager::TryDequeue() {
+  // Buffers in the ring buffer are always older than buffers in the overflow
+  // queue, as producers switch to the overflow queue only when the ring buffer
+  // is full, and don't switch back until the overflow queue is drained.
+  if (XfeedBuffer* buffer = TryDequeueFromRing()) {
+    return buffer;
+  }
+
+  if (num_overflow_buffers_.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  absl::MutexLock lock(&mu_);
+  return PopOverflowBuffer();
+}
+
+XfeedBuffer* XfeedQueueManager::PopOverflowBuffer() {
+  if (overflow_buffers_.empty()) return nullptr;
+  XfeedBuffer* buffer = overflow_buffers_.front();
+  overflow_buffers_.pop_front();
+  num_overflow_buffers_.fetch_sub(1, std::memory_order_release);
+  return buffer;
+}
+
+void XfeedQueueManager::NotifyWaitingConsumers() {
+  // Pairs with the fence in BlockingDequeueBuffer: either consumer sees the
+  // enqueued buffer, or we see the parked consumer and wake it up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_waiting_consumers_.load(std::memory_order_relaxed) > 0) {
+    absl::MutexLock lock(&mu_);
+    buffer_available_.SignalAll();
+  }
+}
+
 void XfeedQueueManager::EnqueueBuffersAtomically(
     absl::Span<XfeedBuffer* const> buffers) {
-  absl::MutexLock l(&mu_);
+  if (buffers.empty()) return;
+
   for (XfeedBuffer* b : buffers) {
     VLOG(3) << "Enqueueing " << queue_name_ << " buffer (of " << buffers.size()
             << " buffers) with length: " << b->length();
-    enqueued_buffers_.push_back(b);
   }
+
+  if (num_overflow_buffers_.load(std::memory_order_acquire) == 0 &&
+      TryEnqueueToRing(buffers)) {
+    NotifyWaitingConsumers();
+    return;
+  }
+
+  absl::MutexLock lock(&mu_);
+  overflow_buffers_.insert(overflow_buffers_.end(), buffers.begin(),
+                           buffers.end());
+  num_overflow_buffers_.fetch_add(buffers.size(), std::memory_order_release);
+  buffer_available_.SignalAll();
 }
 
 XfeedBuffer* XfeedQueueManager::BlockingDequeueBuffer() {
   VLOG(3) << "Waiting for an available buffer.";
-  auto available_buffer = [this]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
-    return !enqueued_buffers_.empty();
-  };
-  absl::MutexLock l(&mu_, absl::Condition(&available_buffer));
+
+  XfeedBuffer* buffer = TryDequeue();
+
+  // Spin for a while before parking the thread, as in streaming pipelines
+  // the next buffer is usually enqueued shortly.
+  for (int64_t i = 0; buffer == nullptr && i < options_.spin_iterations; ++i) {
+    buffer = TryDequeue();
+  }
+
+  if (buffer == nullptr) {
+    absl::MutexLock lock(&mu_);
+    num_waiting_consumers_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // We hold the lock while checking the queue, so producers that observed
+    // a parked consumer can't signal it before it starts waiting.
+    while (true) {
+      buffer = TryDequeueFromRing();
+      if (buffer == nullptr) buffer = PopOverflowBuffer();
+      if (buffer != nullptr) break;
+      buffer_available_.Wait(&mu_);
+    }
+
+    num_waiting_consumers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
   VLOG(3) << "A buffer is available!";
-  CHECK(current_buffer_ == nullptr);
-  current_buffer_ = enqueued_buffers_.front();
-  enqueued_buffers_.pop_front();
-  return current_buffer_;
+  CHECK(current_buffer_.exchange(buffer, std::memory_order_acq_rel) ==
+        nullptr);
+  return buffer;
 }
 
 void XfeedQueueManager::ReleaseCurrentBuffer(int32_t length, void* data,
@@ -57,12 +219,12 @@ void XfeedQueueManager::ReleaseCurrentBuffer(int32_t length, void* data,
   VLOG(3) << "Releasing buffer with shape: "
           << (shape.ok() ? ShapeUtil::HumanString(shape.value())
                          : "<error status>");
-  absl::MutexLock l(&mu_);
-  CHECK(current_buffer_ != nullptr);
-  CHECK_EQ(length, current_buffer_->length());
-  CHECK_EQ(data, current_buffer_->data());
-  current_buffer_->Done(std::move(shape));
-  current_buffer_ = nullptr;
+  XfeedBuffer* current_buffer =
+      current_buffer_.exchange(nullptr, std::memory_order_acq_rel);
+  CHECK(current_buffer != nullptr);
+  CHECK_EQ(length, current_buffer->length());
+  CHECK_EQ(data, current_buffer->data());
+  current_buffer->Done(std::move(shape));
 }
 
 int64_t GetByteSizeRequirement(const Shape& shape, int64_t pointer_size) {
@@ -20,10 +20,15 @@ limitations under the License.
 #ifndef XLA_SERVICE_CPU_XFEED_MANAGER_H_
 #define XLA_SERVICE_CPU_XFEED_MANAGER_H_
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
@@ -44,16 +49,41 @@ class XfeedBuffer {
   virtual int32_t length() = 0;
   virtual void* data() = 0;
 
+  // Writes `length()` bytes of the buffer contents to `dst`. By default copies
+  // the bytes from `data()`. Buffers that produce their contents on demand
+  // (e.g. with a user-supplied fill callback) write directly into `dst`, and
+  // might return nullptr from `data()`.
+  virtual absl::Status WriteTo(void* dst);
+
   // The 'shape' parameter reflects what shape the embedded program was
   // expecting / producing with respect to this XfeedBuffer. E.g. this will
   // contain information about the layout of an outfed buffer.
   virtual void Done(absl::StatusOr<Shape> shape) = 0;
 };
 
+// Options for the xfeed queue.
+struct XfeedQueueOptions {
+  // Capacity of the lock-free ring buffer. Must be a power of two. Buffers
+  // that do not fit into the ring buffer are kept in an unbounded overflow
+  // queue, so enqueue never blocks.
+  size_t capacity = 1024;
+
+  // Number of attempts to dequeue a buffer before parking the thread.
+  int64_t spin_iterations = 1024;
+};
+
 // Reusable component for managing the infeed and outfeed queue state.
+//
+// Buffers are passed from clients to the runtime through a bounded lock-free
+// multi-producer multi-consumer ring buffer (Dmitry Vyukov's bounded MPMC
+// queue), so that enqueue and dequeue in the common case do not take any locks.
+// A mutex is only taken when the ring buffer is full (buffers spill into the
+// overflow queue), or when the consumer has to park the thread waiting for a
+// buffer after spinning for `spin_iterations`.
 class XfeedQueueManager {
  public:
-  XfeedQueueManager(std::string queue_name) : queue_name_(queue_name) {}
+  XfeedQueueManager(std::string queue_name);
+  XfeedQueueManager(std::string queue_name, XfeedQueueOptions options);
 
   // Adds a sequence of buffers to the queue atomically. buffer->Done will be
   // called when the buffer will no longer be accessed by the XfeedManager,
@@ -82,17 +112,52 @@ class XfeedQueueManager {
                             absl::StatusOr<Shape> shape);
 
  private:
-  const std::string queue_name_;
+  // A ring buffer cell. For a queue position `pos` mapped to the cell, the cell
+  // is ready to be written when sequence == pos, and to be read when
+  // sequence == pos + 1.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    XfeedBuffer* buffer;
+  };
+
+  // Tries to add all buffers to the ring buffer as a contiguous sequence.
+  // Returns false if the ring buffer doesn't have enough free cells.
+  bool TryEnqueueToRing(absl::Span<XfeedBuffer* const> buffers);
+
+  // Tries to take a buffer from the head of the queue. Returns nullptr if the
+  // queue is empty.
+  XfeedBuffer* TryDequeue();
+  XfeedBuffer* TryDequeueFromRing();
+  XfeedBuffer* PopOverflowBuffer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Wakes up consumers parked in BlockingDequeueBuffer.
+  void NotifyWaitingConsumers();
 
-  absl::Mutex mu_;
+  const std::string queue_name_;
+  const XfeedQueueOptions options_;
 
   // XfeedBuffer* queue contents are not owned, but buffer->Done must
   // be called when the buffer is no longer needed by the runtime.
-  std::deque<XfeedBuffer*> enqueued_buffers_;
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+
+  // The number of buffers in the overflow queue. While the overflow queue is
+  // non-empty all new buffers are added to it to preserve the FIFO order.
+  alignas(64) std::atomic<size_t> num_overflow_buffers_;
+
+  // The number of consumers parked in BlockingDequeueBuffer.
+  std::atomic<int64_t> num_waiting_consumers_;
+
+  absl::Mutex mu_;
+  absl::CondVar buffer_available_;
+  std::deque<XfeedBuffer*> overflow_buffers_ ABSL_GUARDED_BY(mu_);
 
   // If non-NULL, the buffer that is currently being processed by the
   // runtime. Not owned.
-  XfeedBuffer* current_buffer_ = nullptr;
+  std::atomic<XfeedBuffer*> current_buffer_;
 };
 
 // Client-side class used to enqueue infeed buffers.
@@ -15,12 +15,16 @@ limitations under the License.
 
 #include "xla/service/cpu/xfeed_manager.h"
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "xla/service/cpu/cpu_runtime.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -29,6 +33,7 @@ limitations under the License.
 #include "tsl/platform/env.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/test.h"
+#include "tsl/platform/test_benchmark.h"
 #include "tsl/platform/threadpool.h"
 
 namespace xla {
@@ -159,5 +164,153 @@ TEST_F(InfeedManagerTest, OutfeedWrongShape) {
   ProcessNextOutfeedBuffer(32, ShapeUtil::MakeShape(U8, {33}));
 }
 
+// Xfeed buffer that doesn't own any data and does nothing when released.
+class IdXfeedBuffer : public cpu::runtime::XfeedBuffer {
+ public:
+  explicit IdXfeedBuffer(int32_t id) : id_(id) {}
+
+  int32_t length() override { return id_; }
+  void* data() override { return nullptr; }
+  void Done(absl::StatusOr<Shape> shape) override {}
+
+  int32_t id() const { return id_; }
+
+ private:
+  int32_t id_;
+};
+
+static std::vector<std::unique_ptr<IdXfeedBuffer>> CreateBuffers(int32_t n) {
+  std::vector<std::unique_ptr<IdXfeedBuffer>> buffers;
+  for (int32_t i = 0; i < n; ++i) {
+    buffers.push_back(std::make_unique<IdXfeedBuffer>(i));
+  }
+  return buffers;
+}
+
+// Dequeues the next buffer and returns its id.
+static int32_t DequeueId(cpu::runtime::XfeedQueueManager& queue) {
+  cpu::runtime::XfeedBuffer* buffer = queue.BlockingDequeueBuffer();
+  int32_t id = static_cast<IdXfeedBuffer*>(buffer)->id();
+  queue.ReleaseCurrentBuffer(buffer->length(), buffer->data(), Shape());
+  return id;
+}
+
+TEST_F(InfeedManagerTest, OverflowPreservesOrder) {
+  cpu::runtime::XfeedQueueManager queue("test", {/*capacity=*/4});
+  auto buffers = CreateBuffers(16);
+
+  // Fill the ring buffer and spill into the overflow queue.
+  for (int32_t i = 0; i < 10; ++i) {
+    queue.EnqueueBuffersAtomically({buffers[i].get()});
+  }
+
+  for (int32_t i = 0; i < 3; ++i) EXPECT_EQ(DequeueId(queue), i);
+
+  // New buffers must be added after the buffers in the overflow queue.
+  for (int32_t i = 10; i < 16; ++i) {
+    queue.EnqueueBuffersAtomically({buffers[i].get()});
+  }
+
+  for (int32_t i = 3; i < 16; ++i) EXPECT_EQ(DequeueId(queue), i);
+}
+
+TEST_F(InfeedManagerTest, BatchLargerThanCapacity) {
+  cpu::runtime::XfeedQueueManager queue("test", {/*capacity=*/4});
+  auto buffers = CreateBuffers(8);
+
+  std::vector<cpu::runtime::XfeedBuffer*> batch;
+  for (auto& buffer : buffers) batch.push_back(buffer.get());
+
+  queue.EnqueueBuffersAtomically(batch);
+  for (int32_t i = 0; i < 8; ++i) EXPECT_EQ(DequeueId(queue), i);
+}
+
+TEST_F(InfeedManagerTest, ConcurrentProducers) {
+  static constexpr int32_t kNumProducers = 4;
+  static constexpr int32_t kNumBuffers = 1000;
+
+  cpu::runtime::XfeedQueueManager queue("test", {/*capacity=*/16});
+  auto buffers = CreateBuffers(kNumProducers * kNumBuffers);
+
+  tsl::thread::ThreadPool pool(tsl::Env::Default(), "test", kNumProducers);
+  for (int32_t p = 0; p < kNumProducers; ++p) {
+    pool.Schedule([&, p] {
+      for (int32_t i = 0; i < kNumBuffers; i += 2) {
+        queue.EnqueueBuffersAtomically(
+            {buffers[p * kNumBuffers + i].get(),
+             buffers[p * kNumBuffers + i + 1].get()});
+      }
+    });
+  }
+
+  // Buffers from each producer must be dequeued in order, and batches must not
+  // be interleaved with buffers from other producers.
+  std::vector<int32_t> next(kNumProducers, 0);
+  for (int32_t i = 0; i < kNumProducers * kNumBuffers; i += 2) {
+    int32_t id0 = DequeueId(queue);
+    int32_t id1 = DequeueId(queue);
+    int32_t p = id0 / kNumBuffers;
+    EXPECT_EQ(id0, p * kNumBuffers + next[p]);
+    EXPECT_EQ(id1, id0 + 1);
+    next[p] += 2;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks below
+//===----------------------------------------------------------------------===//
+
+static void BM_XfeedEnqueueDequeue(benchmark::State& state) {
+  int32_t batch_size = state.range(0);
+
+  cpu::runtime::XfeedQueueManager queue("benchmark");
+  auto buffers = CreateBuffers(batch_size);
+
+  std::vector<cpu::runtime::XfeedBuffer*> batch;
+  for (auto& buffer : buffers) batch.push_back(buffer.get());
+
+  for (auto _ : state) {
+    queue.EnqueueBuffersAtomically(batch);
+    for (int32_t i = 0; i < batch_size; ++i) {
+      benchmark::DoNotOptimize(DequeueId(queue));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_XfeedProducerConsumer(benchmark::State& state) {
+  int32_t num_producers = state.range(0);
+  static constexpr int32_t kNumBuffers = 10000;
+
+  cpu::runtime::XfeedQueueManager queue("benchmark");
+  auto buffers = CreateBuffers(kNumBuffers);
+
+  tsl::thread::ThreadPool pool(tsl::Env::Default(), "benchmark",
+                               num_producers);
+
+  for (auto _ : state) {
+    absl::BlockingCounter done(num_producers);
+    for (int32_t p = 0; p < num_producers; ++p) {
+      pool.Schedule([&, p] {
+        for (int32_t i = p; i < kNumBuffers; i += num_producers) {
+          queue.EnqueueBuffersAtomically({buffers[i].get()});
+        }
+        done.DecrementCount();
+      });
+    }
+
+    for (int32_t i = 0; i < kNumBuffers; ++i) {
+      benchmark::DoNotOptimize(DequeueId(queue));
+    }
+    done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumBuffers);
+}
+
+BENCHMARK(BM_XfeedEnqueueDequeue)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(BM_XfeedProducerConsumer)->MeasureProcessCPUTime()->Arg(1)->Arg(4);
+
 }  // namespace
 }  // namespace xla
@@ -200,22 +200,12 @@ ReadModuleFromUnoptimizedSnapshotBinaryProtoFile(absl::string_view hlo_file) {
   tsl::RandomAccessFileCopyingInputStream input_stream(file.get());
   tsl::protobuf::io::CopyingInputStreamAdaptor adaptor(&input_stream);
 
-  TF_ASSIGN_OR_RETURN(HloUnoptimizedSnapshot proto,
-                      DeserializeHloUnoptimizedSnapshot(&adaptor));
+  TF_ASSIGN_OR_RETURN(HloUnoptimizedSnapshotWithLiterals snapshot,
+                      DeserializeHloUnoptimizedSnapshotToLiterals(&adaptor));
 
   TF_ASSIGN_OR_RETURN(hlo_module_and_arguments.hlo_module,
-                      CreateModuleFromProto(proto.hlo_module()));
-
-  for (const auto& arguments : proto.partitions()) {
-    hlo_module_and_arguments.arguments.emplace_back();
-    hlo_module_and_arguments.arguments.back().reserve(
-        arguments.arguments_size());
-    for (const auto& argument : arguments.arguments()) {
-      TF_ASSIGN_OR_RETURN(
-          hlo_module_and_arguments.arguments.back().emplace_back(),
-          Literal::CreateFromProto(argument));
-    }
-  }
+                      CreateModuleFromProto(snapshot.hlo_module));
+  hlo_module_and_arguments.arguments = std::move(snapshot.partitions);
   return hlo_module_and_arguments;
 }
 